@@ -25,8 +25,8 @@ class Local;
 //! @brief Redefinition of shared pointers of FlightMaps for ease of use.
 typedef std::shared_ptr<FlightMap> FlightMapPtr;
 
-//! @brief Redefinition of shared pointers of Airports for ease of use.
-typedef std::shared_ptr<Airport> AirportPTR;
+//! @brief Redefinition of non-owning pointers of Airports for ease of use, the airports being owned by the database.
+typedef Airport *AirportPTR;
 
 //! @brief Redefinition of shared pointers of database for ease of use.
 typedef std::shared_ptr<Database> DatabasePTR;
@@ -0,0 +1,638 @@
+/** @file Benchmark.cpp
+ *  @brief Contains the benchmark of the FlightMap and Database queries.
+ *  @author -
+ *  @bug No known bugs.
+ *
+ *  Runs every query many times against the bundled input files and against synthetic graphs of several sizes,
+ *  and reports the throughput, the latency percentiles, the allocations and, where the system counts them,
+ *  the cache misses per query of each one.
+ *  When there are schedules, the earliest arrivals to cities are also checked against those to each of their airports,
+ *  and the benchmark fails if any is wrong.
+ *  The report is JSON, so it can be stored and given back with --baseline to compare a later run against it.
+ *  Like the application, it reads ../resources unless given --data, so it must run from a directory next to it.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <random>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "../classes/database/Database.h"
+#include "../classes/graph/locals/AirportLocal.h"
+#include "../classes/graph/locals/CityLocal.h"
+#include "../classes/json/Json.h"
+#include "../classes/scheduler/Scheduler.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+//! @brief Holds the number of allocations made by the whole program.
+static atomic<long long> allocations(0);
+
+// The replacements pair malloc with free, but GCC sees free reached from a delete expression and warns.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+
+void *operator new(size_t size) {
+    allocations.fetch_add(1, memory_order_relaxed);
+    if (void *pointer = malloc(size ? size : 1)) return pointer;
+    throw bad_alloc();
+}
+
+void *operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void *pointer) noexcept {
+    free(pointer);
+}
+
+void operator delete[](void *pointer) noexcept {
+    free(pointer);
+}
+
+void operator delete(void *pointer, size_t) noexcept {
+    free(pointer);
+}
+
+void operator delete[](void *pointer, size_t) noexcept {
+    free(pointer);
+}
+
+#pragma GCC diagnostic pop
+
+//! @brief Represents the measurements of one benchmark.
+struct Result {
+    string name;
+    int queries;
+    double throughput;
+    double p50;
+    double p90;
+    double p99;
+    double allocationsPerQuery;
+    double cacheMissesPerQuery;
+};
+
+//! @brief Represents a random graph of a given size, built straight into a FlightMap.
+struct SyntheticGraph {
+    vector<unique_ptr<Airport>> owned;
+    vector<AirportPTR> airports;
+    vector<Flight> flights;
+    FlightMap flightMap;
+};
+
+/** @brief Writes the code of an airport from its id, "AAA" being 0.
+ *
+ * @param id Of int type, less than NUM_CODES.
+ * @return string.
+ */
+static string codeOf(int id) {
+    const char *symbols = "ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+    string code(CODE_LENGTH, 'A');
+    for (int i = CODE_LENGTH - 1; i >= 0; i--, id /= CODE_SYMBOLS)
+        code[i] = symbols[id % CODE_SYMBOLS];
+    return code;
+}
+
+/** @brief Builds a random graph.
+ *
+ * Half of the flights go to the first 5% of the airports, the hubs, and every flight has a return flight,
+ * which roughly follows the shape of the real network.
+ *
+ * @param graph Of SyntheticGraph type, by reference, empty.
+ * @param numAirports Of int type, at most NUM_CODES.
+ * @param degree Of int type, the average number of flights per airport.
+ * @param seed Of unsigned type.
+ * @return Void.
+ */
+static void buildGraph(SyntheticGraph &graph, int numAirports, int degree, unsigned seed) {
+    mt19937 random(seed);
+    int numHubs = max(1, numAirports / 20);
+    uniform_int_distribution<int> anyAirport(0, numAirports - 1), anyHub(0, numHubs - 1), anyAirline(0, 99);
+
+    vector<vector<Flight>> flights(numAirports);
+    for (int source = 0; source < numAirports; source++)
+        for (int i = 0; i < degree / 2; i++) {
+            int destination = i % 2 ? anyAirport(random) : anyHub(random);
+            if (destination == source) continue;
+            int airline = anyAirline(random);
+            flights[source].push_back({destination, airline});
+            flights[destination].push_back({source, airline});
+        }
+
+    size_t numFlights = 0;
+    for (const auto &airportFlights: flights)
+        numFlights += airportFlights.size();
+    graph.flights.reserve(numFlights);
+
+    for (int id = 0; id < numAirports; id++) {
+        graph.owned.emplace_back(new Airport(codeOf(id), "Airport " + to_string(id), "City " + to_string(id / 3),
+                                             "Country " + to_string(id / 50), 0, 0));
+        AirportPTR airport = graph.owned.back().get();
+        airport->id = id;
+
+        const Flight *first = graph.flights.data() + graph.flights.size();
+        graph.flights.insert(graph.flights.end(), flights[id].begin(), flights[id].end());
+        airport->setFlights(first, graph.flights.data() + graph.flights.size());
+        graph.airports.push_back(airport);
+    }
+    graph.flightMap.setAirports(graph.airports);
+}
+
+/** @brief Opens a counter of the cache misses of this thread.
+ *
+ * @return int descriptor of the counter, or -1 if the system does not count them, as most virtual machines do not.
+ */
+static int openCacheMissCounter() {
+#ifdef __linux__
+    perf_event_attr attributes{};
+    attributes.type = PERF_TYPE_HARDWARE;
+    attributes.size = sizeof(attributes);
+    attributes.config = PERF_COUNT_HW_CACHE_MISSES;
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+    return syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0);
+#else
+    return -1;
+#endif
+}
+
+/** @brief Returns the number of cache misses of this thread so far.
+ *
+ * @return long long, or -1 if they are not counted.
+ */
+static long long cacheMisses() {
+    static int counter = openCacheMissCounter();
+    long long value = -1;
+#ifdef __linux__
+    if (counter == -1 || read(counter, &value, sizeof(value)) != sizeof(value)) return -1;
+#endif
+    return value;
+}
+
+/** @brief Runs a query a number of times, measuring each run.
+ *
+ * The first query also runs once before the measurements, unless there are only a few.
+ *
+ * @param name Of const string type, by reference.
+ * @param queries Of int type.
+ * @param query Of const function<void(int)> type, by reference, called with the number of the run.
+ * @return Result.
+ */
+static Result measure(const string &name, int queries, const function<void(int)> &query) {
+    if (queries >= 10) query(0);
+
+    vector<double> latencies(queries);
+    long long allocated = 0, missesBefore = cacheMisses();
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < queries; i++) {
+        long long before = allocations;
+        auto begin = chrono::steady_clock::now();
+        query(i);
+        latencies[i] = chrono::duration<double, micro>(chrono::steady_clock::now() - begin).count();
+        allocated += allocations - before;
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    long long missesAfter = cacheMisses();
+
+    sort(latencies.begin(), latencies.end());
+    auto percentile = [&latencies](double fraction) {
+        return latencies[min(latencies.size() - 1, (size_t) (fraction * latencies.size()))];
+    };
+
+    Result result{name, queries, queries / seconds, percentile(0.50), percentile(0.90), percentile(0.99),
+                  (double) allocated / queries,
+                  missesBefore == -1 || missesAfter == -1 ? -1 : (double) (missesAfter - missesBefore) / queries};
+    cerr << left << setw(40) << name << right << fixed << setprecision(1)
+         << setw(12) << result.throughput << " q/s" << setw(12) << result.p50 << " us p50"
+         << setw(12) << result.p99 << " us p99" << setw(10) << result.allocationsPerQuery << " allocs";
+    if (result.cacheMissesPerQuery >= 0) cerr << setw(12) << result.cacheMissesPerQuery << " misses";
+    cerr << endl;
+    return result;
+}
+
+/** @brief Picks random pairs of airport ids.
+ *
+ * @param numAirports Of int type.
+ * @param count Of int type.
+ * @param seed Of unsigned type.
+ * @return vector<pair<int, int>>.
+ */
+static vector<pair<int, int>> randomPairs(int numAirports, int count, unsigned seed) {
+    mt19937 random(seed);
+    uniform_int_distribution<int> anyAirport(0, numAirports - 1);
+    vector<pair<int, int>> pairs;
+    for (int i = 0; i < count; i++)
+        pairs.emplace_back(anyAirport(random), anyAirport(random));
+    return pairs;
+}
+
+/** @brief Measures the FlightMap queries on a graph.
+ *
+ * @param prefix Of const string type, by reference, put before the name of each benchmark.
+ * @param flightMap Of const FlightMap type, by reference.
+ * @param queries Of int type, the number of runs of the quick queries.
+ * @param withDiameter Of bool type, false to skip the diameter, quadratic in the number of airports.
+ * @param seed Of unsigned type.
+ * @param results Of vector<Result> type, by reference, where the results are added.
+ * @return Void.
+ */
+static void measureFlightMap(const string &prefix, const FlightMap &flightMap, int queries, bool withDiameter,
+                             unsigned seed, vector<Result> &results) {
+    const vector<AirportPTR> &airports = flightMap.getAirports();
+    vector<pair<int, int>> pairs = randomPairs(airports.size(), queries, seed);
+    AirlineFilter allAirlines(NUM_CODES, true);
+    Traversal traversal(airports.size());
+
+    vector<int> minimums(queries);
+    results.push_back(measure(prefix + "minimumDistance", queries, [&](int i) {
+        minimums[i] = flightMap.minimumDistance(airports[pairs[i].first], airports[pairs[i].second],
+                                                allAirlines, traversal);
+    }));
+    results.push_back(measure(prefix + "getTrajectories", queries, [&](int i) {
+        int minimum = minimums[i] == -1 ? INT_MAX : minimums[i];
+        flightMap.getTrajectories(airports[pairs[i].first], airports[pairs[i].second], allAirlines, minimum,
+                                  traversal);
+    }));
+    results.push_back(measure(prefix + "reachableAirports", queries, [&](int i) {
+        flightMap.reachableAirports(airports[pairs[i].first], 2, traversal);
+    }));
+    results.push_back(measure(prefix + "articulationPoints", 5, [&](int) {
+        flightMap.articulationPoints();
+    }));
+    results.push_back(measure(prefix + "connectedComponents", 5, [&](int) {
+        flightMap.connectedComponents();
+    }));
+    if (withDiameter)
+        results.push_back(measure(prefix + "diameter", 1, [&](int) {
+            flightMap.diameter();
+        }));
+}
+
+/** @brief Measures the flat hash containers against the node-based ones they replaced, on the city index of a database.
+ *
+ * Each run looks up every city once, in a random order, goes through every airport of every city,
+ * or puts every airport in a new set, as the reachability queries do with their results.
+ *
+ * @param prefix Of const string type, by reference, put before the name of each benchmark.
+ * @param database Of const Database type, by reference.
+ * @param queries Of int type, the number of runs.
+ * @param seed Of unsigned type.
+ * @param results Of vector<Result> type, by reference, where the results are added.
+ * @return Void.
+ */
+static void measureContainers(const string &prefix, const Database &database, int queries, unsigned seed,
+                              vector<Result> &results) {
+    typedef unordered_set<AirportPTR, Airport::hashFunction> NodeAirports;
+    const AirportsPerCity_Set &flatCities = database.getAirportsPerCity();
+    unordered_map<City, NodeAirports, City::hashFunction> nodeCities;
+    vector<City> cities;
+    for (const auto &city: flatCities) {
+        nodeCities.emplace(city.first, NodeAirports(city.second.begin(), city.second.end()));
+        cities.push_back(city.first);
+    }
+    shuffle(cities.begin(), cities.end(), mt19937(seed));
+    const vector<AirportPTR> &airports = database.getAirports();
+
+    volatile size_t sink = 0;
+    results.push_back(measure(prefix + "containers/cityLookup/unordered", queries, [&](int) {
+        size_t found = 0;
+        for (const City &city: cities) found += nodeCities.find(city)->second.size();
+        sink = found;
+    }));
+    results.push_back(measure(prefix + "containers/cityLookup/flat", queries, [&](int) {
+        size_t found = 0;
+        for (const City &city: cities) found += flatCities.find(city)->second.size();
+        sink = found;
+    }));
+    results.push_back(measure(prefix + "containers/cityIteration/unordered", queries, [&](int) {
+        size_t ids = 0;
+        for (const auto &city: nodeCities)
+            for (const AirportPTR &airport: city.second) ids += airport->id;
+        sink = ids;
+    }));
+    results.push_back(measure(prefix + "containers/cityIteration/flat", queries, [&](int) {
+        size_t ids = 0;
+        for (const auto &city: flatCities)
+            for (const AirportPTR &airport: city.second) ids += airport->id;
+        sink = ids;
+    }));
+    results.push_back(measure(prefix + "containers/airportSet/unordered", queries, [&](int) {
+        NodeAirports set;
+        for (const AirportPTR &airport: airports) set.insert(airport);
+        sink = set.size();
+    }));
+    results.push_back(measure(prefix + "containers/airportSet/flat", queries, [&](int) {
+        Airports_Set set;
+        for (const AirportPTR &airport: airports) set.insert(airport);
+        sink = set.size();
+    }));
+}
+
+/** @brief Checks the earliest arrival to a city against the earliest arrival to each of its airports.
+ *
+ * A journey to any airport of a city can not arrive before the best of the journeys to each airport alone.
+ *
+ * @param database Of const Database type, by reference, with schedules.
+ * @param pairs Of const vector<pair<int, int>> type, by reference, the origin and an airport of the destination city.
+ * @return int number of queries whose answer was wrong.
+ */
+static int checkEarliestArrival(const Database &database, const vector<pair<int, int>> &pairs) {
+    const vector<AirportPTR> &airports = database.getAirports();
+    auto arrivalOf = [](const Journey &journey) {
+        return journey.empty() ? INT_MAX : journey.back().arrival;
+    };
+
+    int mismatches = 0;
+    for (size_t i = 0; i < pairs.size(); i++) {
+        AirportPTR origin = airports[pairs[i].first], destination = airports[pairs[i].second];
+        if (origin->city == destination->city && origin->country == destination->country) continue;
+
+        int departure = i * 7 % Timetable::DAY, best = INT_MAX;
+        LocalPTR from(new AirportLocal(origin->code));
+        for (const AirportPTR &airport: airports)
+            if (airport->city == destination->city && airport->country == destination->country)
+                best = min(best, arrivalOf(database.getEarliestArrival(from, LocalPTR(new AirportLocal(airport->code)),
+                                                                       departure)));
+        LocalPTR to(new CityLocal(City(destination->city, destination->country)));
+        if (arrivalOf(database.getEarliestArrival(from, to, departure)) != best) {
+            cerr << "earliestArrival from " << origin->code << " to " << destination->getCity()
+                 << " does not arrive first" << endl;
+            mismatches++;
+        }
+    }
+    return mismatches;
+}
+
+/** @brief Measures the loading and the Database queries on the input files.
+ *
+ * @param directory Of const string type, by reference, the directory of the input files, or empty for the bundled ones.
+ * @param queries Of int type, the number of runs of the quick queries.
+ * @param seed Of unsigned type.
+ * @param results Of vector<Result> type, by reference, where the results are added.
+ * @return int number of queries whose answer was wrong.
+ */
+static int measureDatabase(const string &directory, int queries, unsigned seed, vector<Result> &results) {
+    results.push_back(measure("load/csv", 3, [&directory](int) {
+        Database database;
+        if (!directory.empty()) database.setDirectory(directory);
+        database.read(false);
+    }));
+
+    Database database;
+    if (!directory.empty()) database.setDirectory(directory);
+    database.read();
+    results.push_back(measure("load/snapshot", 3, [&directory](int) {
+        Database database;
+        if (!directory.empty()) database.setDirectory(directory);
+        database.read();
+    }));
+
+    string prefix = directory.empty() ? "real/" : "data/";
+    measureFlightMap(prefix, *database.getFlightMapPtr(), queries, database.getAirports().size() <= 5000, seed,
+                     results);
+    measureContainers(prefix, database, queries, seed, results);
+
+    const vector<AirportPTR> &airports = database.getAirports();
+    vector<pair<int, int>> pairs = randomPairs(airports.size(), queries, seed + 1);
+    database.setCacheBudget(0);
+    results.push_back(measure(prefix + "database/getTrajectories", queries, [&](int i) {
+        database.getTrajectories(LocalPTR(new AirportLocal(airports[pairs[i].first]->code)),
+                                 LocalPTR(new AirportLocal(airports[pairs[i].second]->code)));
+    }));
+    results.push_back(measure(prefix + "database/citiesWithMaxYFlights", queries, [&](int i) {
+        database.citiesWithMaxYFlights(LocalPTR(new AirportLocal(airports[pairs[i].first]->code)), 2);
+    }));
+
+    // One airline, from an airport it flies from: the database searches its subgraph, the flight map every flight.
+    vector<unordered_set<string>> singleAirlines(queries);
+    vector<AirlineFilter> singleFilters(queries, AirlineFilter(database.getAirlines().size(), false));
+    vector<int> flyingFrom(queries);
+    for (int i = 0; i < queries; i++) {
+        int origin = pairs[i].first;
+        while (airports[origin]->flights.empty()) origin = (origin + 1) % airports.size();
+        int airline = airports[origin]->flights.begin()->airline;
+        flyingFrom[i] = origin;
+        singleAirlines[i].insert(database.getAirline(airline).code);
+        singleFilters[i][airline] = true;
+    }
+    results.push_back(measure(prefix + "database/oneAirline/subgraph", queries, [&](int i) {
+        database.getTrajectories(LocalPTR(new AirportLocal(airports[flyingFrom[i]]->code)),
+                                 LocalPTR(new AirportLocal(airports[pairs[i].second]->code)), singleAirlines[i]);
+    }));
+    results.push_back(measure(prefix + "database/oneAirline/allFlights", queries, [&](int i) {
+        database.getFlightMapPtr()->getFlights(LocalPTR(new AirportLocal(airports[flyingFrom[i]]->code)),
+                                               LocalPTR(new AirportLocal(airports[pairs[i].second]->code)),
+                                               singleFilters[i]);
+    }));
+
+    // The same few queries over and over, as popular ones are, answered from the cache after the first time.
+    database.setCacheBudget(Database::CACHE_BUDGET);
+    results.push_back(measure(prefix + "database/getTrajectoriesCached", queries, [&](int i) {
+        database.getTrajectories(LocalPTR(new AirportLocal(airports[pairs[i % 10].first]->code)),
+                                 LocalPTR(new AirportLocal(airports[pairs[i % 10].second]->code)));
+    }));
+
+    if (!database.hasSchedules()) return 0;
+    results.push_back(measure(prefix + "database/earliestArrival", queries, [&](int i) {
+        database.getEarliestArrival(LocalPTR(new AirportLocal(airports[pairs[i].first]->code)),
+                                    LocalPTR(new AirportLocal(airports[pairs[i].second]->code)),
+                                    i * 7 % Timetable::DAY);
+    }));
+    results.push_back(measure(prefix + "database/profile", queries, [&](int i) {
+        database.getProfile(LocalPTR(new AirportLocal(airports[pairs[i].first]->code)),
+                            LocalPTR(new AirportLocal(airports[pairs[i].second]->code)));
+    }));
+    results.push_back(measure(prefix + "database/pareto", queries, [&](int i) {
+        database.getParetoJourneys(LocalPTR(new AirportLocal(airports[pairs[i].first]->code)),
+                                   LocalPTR(new AirportLocal(airports[pairs[i].second]->code)),
+                                   i * 7 % Timetable::DAY, database.getAirlineFilter());
+    }));
+    return checkEarliestArrival(database, pairs);
+}
+
+/** @brief Measures the searches on the airports of a database given ids in each order.
+ *
+ * The same pairs of airports, by code, are searched in every order. The mean distance between the ids
+ * of the two ends of a flight is printed too, as a measure of how close in memory the neighbours of an airport are.
+ *
+ * @param directory Of const string type, by reference, the directory of the input files, "../resources" if empty.
+ * @param queries Of int type, the number of runs.
+ * @param seed Of unsigned type.
+ * @param results Of vector<Result> type, by reference, where the results are added.
+ * @return Void.
+ */
+static void measureRenumbering(const string &directory, int queries, unsigned seed, vector<Result> &results) {
+    vector<pair<string, string>> codes;
+    for (const string name: {"input", "bfs", "rcm", "hilbert"}) {
+        Renumbering::Order order;
+        Renumbering::parseOrder(name, order);
+        Database database;
+        if (!directory.empty()) database.setDirectory(directory);
+        database.setOrder(order);
+        database.read(false);
+
+        const FlightMap &flightMap = *database.getFlightMapPtr();
+        const vector<AirportPTR> &airports = flightMap.getAirports();
+        if (codes.empty())
+            for (const pair<int, int> &ids: randomPairs(airports.size(), queries, seed))
+                codes.emplace_back(airports[ids.first]->code, airports[ids.second]->code);
+        vector<pair<AirportPTR, AirportPTR>> pairs;
+        for (const pair<string, string> &code: codes)
+            pairs.emplace_back(flightMap.getAirport(code.first), flightMap.getAirport(code.second));
+
+        double gaps = 0;
+        size_t numFlights = 0;
+        for (const AirportPTR &airport: airports)
+            for (const Flight &flight: airport->flights) {
+                gaps += abs(flight.destination - airport->id);
+                numFlights++;
+            }
+        cerr << "renumbering/" << name << ": " << fixed << setprecision(1) << gaps / max<size_t>(numFlights, 1)
+             << " mean id gap along a flight" << endl;
+
+        AirlineFilter allAirlines(NUM_CODES, true);
+        Traversal traversal(airports.size());
+        string prefix = "renumbering/" + name + "/";
+        results.push_back(measure(prefix + "minimumDistance", queries, [&](int i) {
+            flightMap.minimumDistance(pairs[i].first, pairs[i].second, allAirlines, traversal);
+        }));
+        results.push_back(measure(prefix + "reachableAirports", queries, [&](int i) {
+            flightMap.reachableAirports(pairs[i].first, 3, traversal);
+        }));
+    }
+}
+
+/** @brief Writes the results as JSON.
+ *
+ * @param results Of const vector<Result> type, by reference.
+ * @return string.
+ */
+static string toJson(const vector<Result> &results) {
+    ostringstream output;
+    output << "{\"threads\":" << Scheduler::global().getThreads() << ",\"benchmarks\":[";
+    for (size_t i = 0; i < results.size(); i++) {
+        const Result &result = results[i];
+        output << (i ? ",\n" : "\n") << "{\"name\":" << Json::quote(result.name) << ",\"queries\":" << result.queries
+               << ",\"throughput_qps\":" << result.throughput << ",\"p50_us\":" << result.p50
+               << ",\"p90_us\":" << result.p90 << ",\"p99_us\":" << result.p99
+               << ",\"allocations_per_query\":" << result.allocationsPerQuery << ",\"cache_misses_per_query\":";
+        if (result.cacheMissesPerQuery >= 0) output << result.cacheMissesPerQuery;
+        else output << "null";
+        output << "}";
+    }
+    output << "\n]}\n";
+    return output.str();
+}
+
+/** @brief Compares the results with a stored report.
+ *
+ * A benchmark regressed if its p50 latency grew more than the tolerance.
+ *
+ * @param results Of const vector<Result> type, by reference.
+ * @param path Of const string type, by reference, path of the stored report.
+ * @param tolerance Of double type, the allowed growth, 0.1 for 10%.
+ * @return int number of regressions, or -1 if the report could not be read.
+ */
+static int compare(const vector<Result> &results, const string &path, double tolerance) {
+    ifstream file(path);
+    if (!file) {
+        cerr << "Could not open " << path << endl;
+        return -1;
+    }
+
+    Json baseline;
+    try {
+        baseline = Json::parse(string(istreambuf_iterator<char>(file), istreambuf_iterator<char>()));
+    } catch (const invalid_argument &error) {
+        cerr << "Could not read " << path << ": " << error.what() << endl;
+        return -1;
+    }
+
+    int regressions = 0;
+    cerr << endl << "Compared with " << path << ":" << endl;
+    for (const Result &result: results)
+        for (const Json &stored: baseline["benchmarks"].getItems()) {
+            if (stored["name"].asString() != result.name) continue;
+
+            double before = stored["p50_us"].asNumber();
+            double ratio = before > 0 ? result.p50 / before : 1;
+            bool regressed = ratio > 1 + tolerance;
+            regressions += regressed;
+            cerr << left << setw(40) << result.name << right << fixed << setprecision(2)
+                 << setw(8) << ratio << "x p50" << (regressed ? "  REGRESSION" : "") << endl;
+        }
+    return regressions;
+}
+
+int main(int argc, char *argv[]) {
+    string output, baseline, data, scales = "1000,10000";
+    int queries = 200;
+    unsigned seed = 42, threads = 0;
+    double tolerance = 0.10;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        string option = argv[i], value = argv[i + 1];
+        if (option == "--output") output = value;
+        else if (option == "--baseline") baseline = value;
+        else if (option == "--data") data = value;
+        else if (option == "--scales") scales = value;
+        else if (option == "--queries") queries = max(1, atoi(value.c_str()));
+        else if (option == "--seed") seed = strtoul(value.c_str(), nullptr, 10);
+        else if (option == "--threads") threads = strtoul(value.c_str(), nullptr, 10);
+        else if (option == "--tolerance") tolerance = atof(value.c_str()) / 100;
+        else {
+            cerr << "Usage: " << argv[0] << " [--output report.json] [--baseline report.json] [--tolerance percent]"
+                 << " [--data directory] [--queries n] [--scales n,n,...] [--seed n] [--threads n]" << endl;
+            return 1;
+        }
+    }
+    Scheduler::setThreads(threads);
+
+    vector<Result> results;
+    int mismatches = measureDatabase(data, queries, seed, results);
+    measureRenumbering(data, queries, seed, results);
+
+    istringstream sizes(scales);
+    string size;
+    while (getline(sizes, size, ',')) {
+        int numAirports = min(NUM_CODES, max(2, atoi(size.c_str())));
+        SyntheticGraph graph;
+        buildGraph(graph, numAirports, 20, seed);
+        measureFlightMap("synthetic-" + to_string(numAirports) + "/", graph.flightMap, queries,
+                         numAirports <= 2000, seed, results);
+    }
+
+    string report = toJson(results);
+    if (output.empty()) {
+        cout << report;
+    } else {
+        ofstream file(output);
+        file << report;
+    }
+
+    if (mismatches > 0) {
+        cerr << mismatches << " queries were answered wrong" << endl;
+        return 1;
+    }
+    if (baseline.empty()) return 0;
+    int regressions = compare(results, baseline, tolerance);
+    return regressions == 0 ? 0 : 1;
+}
@@ -6,6 +6,12 @@
 
 #include "Application.h"
 #include <stdexcept>
+#include <fstream>
+#include <chrono>
+#include "../BatchApplication/BatchApplication.h"
+#include "../ServerApplication/ServerApplication.h"
+#include "../Scheduler/Scheduler.h"
+#include "../Instrumentation/Instrumentation.h"
 #include "../Graph/Locals/Coordinates.h"
 #include "../Graph/Locals/CityLocal.h"
 #include "../Graph/Locals/AirportLocal.h"
@@ -13,10 +19,66 @@
 Application::Application() {}
 
 void Application::startApplication() {
-    database->read();
+    loaded = database->readAsync();
     startMenu();
 }
 
+void Application::waitForDatabase() {
+    if (!loaded.valid()) return;
+    bool shown = false;
+    while (loaded.wait_for(chrono::milliseconds(100)) != future_status::ready) {
+        Database::LoadProgress progress = database->getLoadProgress();
+        cout << "\rLoading the network: " << progress.bytesParsed / 1024 << " of " << progress.bytesTotal / 1024
+             << " KB parsed, " << progress.rows << " rows loaded" << flush;
+        shown = true;
+    }
+    if (shown) cout << endl;
+    loaded.get();
+}
+
+int Application::startBatch(const string &path) {
+    ifstream file;
+    if (path != "-") {
+        file.open(path);
+        if (!file) {
+            cerr << "Could not open " << path << endl;
+            return 1;
+        }
+    }
+
+    database->read();
+    BatchApplication batchApplication(database);
+    int failures = batchApplication.run(path == "-" ? cin : file, cout);
+    if (failures)
+        cerr << failures << " queries could not be answered" << endl;
+    return 0;
+}
+
+int Application::startServer(const string &path, int deadline) {
+    // Reading starts the workers of the scheduler, which must not take the shutdown signals.
+    ServerApplication::blockSignals();
+    database->read();
+    database->startAnalytics();
+    ServerApplication serverApplication(database, Scheduler::global().getThreads(), deadline);
+    return serverApplication.run(path);
+}
+
+void Application::setFormat(ResultWriter::Format format) {
+    listingApplication.setFormat(format);
+}
+
+void Application::setDataDirectory(const string &directory) {
+    database->setDirectory(directory);
+}
+
+void Application::setCacheBudget(int megabytes) {
+    database->setCacheBudget((size_t) megabytes << 20);
+}
+
+void Application::setOrder(Renumbering::Order order) {
+    database->setOrder(order);
+}
+
 void Application::startMenu() {
     menu.startMenu();
     menu.breakLine();
@@ -72,6 +134,30 @@ void Application::statisticsMenuSafety(std::string &option, int &safeOption) {
     }
 }
 
+Statistics::Ranking Application::rankingMenu() {
+    string option;
+    int safeOption = 0;
+    while (safeOption < BY_OUT_DEGREE || safeOption > BY_AIRLINES) {
+        menu.displayRankingMenu();
+        safeInput(option, safeOption);
+        if (safeOption && (safeOption < BY_OUT_DEGREE || safeOption > BY_AIRLINES)) {
+            menu.breakLine();
+            menu.getWrongMessage();
+        }
+    }
+
+    switch (safeOption) {
+        case BY_IN_DEGREE:
+            return Statistics::IN_DEGREE;
+        case BY_DESTINATIONS:
+            return Statistics::DESTINATIONS;
+        case BY_AIRLINES:
+            return Statistics::AIRLINES;
+        default:
+            return Statistics::OUT_DEGREE;
+    }
+}
+
 void Application::maxYFlightsMenuSafety(std::string &option, int &safeOption) {
     while (!safeOption) {
         menu.displayMaxYFlightsMenu();
@@ -96,6 +182,7 @@ void Application::airportNumbersMenu(int &oldOption) {
                 string airportCode;
                 cout << "Type the airport code to check flights total number:";
                 cin >> airportCode;
+                waitForDatabase();
                 cout << numbersApplication.numbersFlights(airportCode) << endl;
                 break;
             }
@@ -103,6 +190,7 @@ void Application::airportNumbersMenu(int &oldOption) {
                 string airportCode;
                 cout << "Type the airport code to check all airlines operating:";
                 cin >> airportCode;
+                waitForDatabase();
                 cout << numbersApplication.numbersAirlines(airportCode) << endl;
                 break;
             }
@@ -110,6 +198,7 @@ void Application::airportNumbersMenu(int &oldOption) {
                 string airportCode;
                 cout << "Type the airport code to check all flights cities:";
                 cin >> airportCode;
+                waitForDatabase();
                 cout << numbersApplication.numbersCities(airportCode) << endl;
                 break;
             }
@@ -117,6 +206,7 @@ void Application::airportNumbersMenu(int &oldOption) {
                 string airportCode;
                 cout << "Type the airport code to check the number of countries to flight:";
                 cin >> airportCode;
+                waitForDatabase();
                 cout << numbersApplication.numbersCountries(airportCode) << endl;
                 break;
             }
@@ -149,6 +239,7 @@ void Application::displayMaxYFlightsMenu(int &oldOption) {
         localMenuSafety(option, safeOption, "Target");
         getLocal(safeOption, fail, local, "Target");
         if (!fail) {
+            waitForDatabase();
             switch (trueOption) {
                 case MAX_AIRPORTS: {
                     listingApplication.showReachableAirports(local, y);
@@ -198,7 +289,7 @@ void Application::filterNetworkTrajectories(int &oldOption) {
                     menu.breakLine();
                     if (!airlines.empty()) {
                         cout << "Filter contains " << airlines.size() << " airlines..." << endl;
-                        for (auto a: airlines)
+                        for (const string &a: airlines)
                             cout << a << endl;
                         menu.breakLine();
                     }
@@ -214,6 +305,7 @@ void Application::filterNetworkTrajectories(int &oldOption) {
                 safeOption = 0;
                 localMenuSafety(option, safeOption, "Destination");
                 getLocal(safeOption, fail, destination, "Destination");
+                waitForDatabase();
                 listingApplication.showTrajectories(origin, destination, true, airlines);
                 menu.breakLine();
                 break;
@@ -243,6 +335,7 @@ void Application::airportListMenu(int &oldOption) {
                 string airportCode;
                 cout << "Type the airport code to check all flights:";
                 cin >> airportCode;
+                waitForDatabase();
                 listingApplication.listFlights(airportCode);
                 break;
             }
@@ -250,6 +343,7 @@ void Application::airportListMenu(int &oldOption) {
                 string airportCode;
                 cout << "Type the airport code to check all flights:";
                 cin >> airportCode;
+                waitForDatabase();
                 listingApplication.listAirlines(airportCode);
                 break;
             }
@@ -257,6 +351,7 @@ void Application::airportListMenu(int &oldOption) {
                 string airportCode;
                 cout << "Type the airport code to check all flights:";
                 cin >> airportCode;
+                waitForDatabase();
                 listingApplication.listCities(airportCode);
                 break;
             }
@@ -265,6 +360,7 @@ void Application::airportListMenu(int &oldOption) {
                 string airportCode;
                 cout << "Type the airport code to check all flights:";
                 cin >> airportCode;
+                waitForDatabase();
                 listingApplication.listCountries(airportCode);
                 break;
             }
@@ -300,6 +396,7 @@ void Application::optionFilter(int &option) {
                 getline(cin, city);
                 cout << "Type the name of its country:";
                 getline(cin, country);
+                waitForDatabase();
                 listingApplication.listAirportsByCity({city, country});
                 break;
             }
@@ -327,8 +424,10 @@ void Application::displayTrajectoriesMenu(int &oldOption) {
         safeOption = 0;
         localMenuSafety(option, safeOption, "Destination");
         getLocal(safeOption, fail, destination, "Destination");
-        if (!fail)
+        if (!fail) {
+            waitForDatabase();
             listingApplication.showTrajectories(origin, destination, false, {});
+        }
         menu.breakLine();
         safeOption = 0;
         localMenuSafety(option, safeOption, "Origin");
@@ -352,6 +451,8 @@ void Application::getLocal(int safeOption, bool &fail, LocalPTR &local, string t
             getline(cin, city);
             cout << typeLocal << " Country Name: ";
             getline(cin, country);
+            // City resolves its names through the string pool, which the loader is still filling.
+            waitForDatabase();
             local = LocalPTR(new CityLocal({city, country}));
             break;
         }
@@ -384,7 +485,9 @@ void Application::displayStatisticsMenu(int &oldOption) {
                 int k;
                 cout << "Type the number for the top airports with most flights: ";
                 cin >> k;
-                listingApplication.globalStatistic(k);
+                Statistics::Ranking ranking = rankingMenu();
+                waitForDatabase();
+                listingApplication.globalStatistic(k, ranking);
                 break;
             }
             case STATISTICS_BY_COUNTRY: {
@@ -395,17 +498,25 @@ void Application::displayStatisticsMenu(int &oldOption) {
                 getline(cin, country);
                 cout << "Type the number for the top airports with most flights: ";
                 cin >> k;
-                listingApplication.statisticPerCountry(country, k);
+                Statistics::Ranking ranking = rankingMenu();
+                waitForDatabase();
+                listingApplication.statisticPerCountry(country, k, ranking);
                 break;
             }
             case ARTICULATION_POINTS: {
+                waitForDatabase();
                 listingApplication.listArticulationPoints();
                 break;
             }
             case CONNECTED_COMPONENTS: {
+                waitForDatabase();
                 numbersApplication.showNumberOfComponents();
                 break;
             }
+            case TIMINGS: {
+                Instrumentation::global().report(cout);
+                break;
+            }
             default: {
                 menu.breakLine();
                 menu.getWrongMessage();
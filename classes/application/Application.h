@@ -38,10 +38,16 @@ private:
 
     //! @brief enum with the Statistics options.
     enum {
-        GLOBAL_STATISTICS = 1, STATISTICS_BY_COUNTRY = 2, ARTICULATION_POINTS = 3, CONNECTED_COMPONENTS = 4
+        GLOBAL_STATISTICS = 1, STATISTICS_BY_COUNTRY = 2, ARTICULATION_POINTS = 3, CONNECTED_COMPONENTS = 4,
+        TIMINGS = 5
     };
 
 
+    //! @brief enum with the ranking options for the top airports.
+    enum {
+        BY_OUT_DEGREE = 1, BY_IN_DEGREE = 2, BY_DESTINATIONS = 3, BY_AIRLINES = 4
+    };
+
     //! @brief Max Y flights options.
     enum {
         MAX_AIRPORTS = 1, MAX_CITIES = 2, MAX_COUNTRIES = 3
@@ -74,6 +80,17 @@ private:
     //! @brief Initialization of the menu.
     Menu menu;
 
+    //! @brief Holds the future of the network read in the background, invalid if it was read before.
+    shared_future<void> loaded;
+
+    /** @brief Waits for the network to be read, showing how much of it was.
+     *
+     * Called before any option that needs the network, so the menu is shown while it is read.
+     *
+     * @return Void.
+     */
+    void waitForDatabase();
+
     /** @brief Starts the menu.
      *
      * @return Void.
@@ -144,6 +161,12 @@ private:
     */
     void statisticsMenuSafety(string &option, int &safeOption);
 
+    /** @brief Asks how to rank the top airports until a valid option is given.
+    *
+    * @return Statistics::Ranking of the chosen option.
+    */
+    Statistics::Ranking rankingMenu();
+
     /** @brief Display the max flights menu if the given menu option is correct.
     *
     * Checks if the safeOption argument is correct for that specific menu.
@@ -254,6 +277,49 @@ public:
      */
     void startApplication();
 
+    /** @brief Reads the database and answers a file of queries, without the menus.
+     *
+     * @param path Of const string type, by reference, path of the queries, or "-" for the standard input.
+     * @return int exit code, 1 if the file could not be opened.
+     */
+    int startBatch(const string &path);
+
+    /** @brief Reads the database and answers queries over a Unix domain socket until interrupted.
+     *
+     * @param path Of const string type, by reference, path of the socket.
+     * @param deadline Of int type, the default deadline of a request in milliseconds.
+     * @return int exit code, 1 if the socket could not be set up.
+     */
+    int startServer(const string &path, int deadline);
+
+    /** @brief Sets the format the listings are written in.
+     *
+     * @param format Of ResultWriter::Format type.
+     * @return Void.
+     */
+    void setFormat(ResultWriter::Format format);
+
+    /** @brief Sets the directory the input files are read from.
+     *
+     * @param directory Of const string type, by reference.
+     * @return Void.
+     */
+    void setDataDirectory(const string &directory);
+
+    /** @brief Sets the memory the cached query results may take.
+     *
+     * @param megabytes Of int type, 0 to cache none.
+     * @return Void.
+     */
+    void setCacheBudget(int megabytes);
+
+    /** @brief Sets the order the airports are given ids in.
+     *
+     * @param order Of Renumbering::Order type.
+     * @return Void.
+     */
+    void setOrder(Renumbering::Order order);
+
     /** @brief Gets the trajectory by local destination, always checking for possible
      * fail moment and verifying that.
      *
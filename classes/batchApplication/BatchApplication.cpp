@@ -0,0 +1,530 @@
+/** @file BatchApplication.cpp
+ *  @brief Contains the BatchApplication Class implementation.
+ *  @author -
+ *  @bug No known bugs.
+ */
+
+#include "BatchApplication.h"
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include "../Database/Database.h"
+#include "../Scheduler/Scheduler.h"
+#include "../Graph/Locals/AirportLocal.h"
+#include "../Graph/Locals/CityLocal.h"
+#include "../Graph/Locals/Coordinates.h"
+
+const size_t BatchApplication::MAX_PENDING;
+
+//! @brief Represents a line of the input, from the time it is read until its result is written.
+struct PendingLine {
+    string line;
+    size_t number = 0;
+    string result;
+    bool failed = false;
+    bool ready = false;
+};
+
+/** @brief Returns a member that must be present.
+ *
+ * @param query Of const Json type, by reference.
+ * @param key Of const string type, by reference.
+ * @return read-only reference to the member.
+ */
+static const Json &require(const Json &query, const string &key) {
+    if (!query.has(key)) throw invalid_argument("missing \"" + key + "\"");
+    return query[key];
+}
+
+/** @brief Returns a member that must be a string.
+ *
+ * @param query Of const Json type, by reference.
+ * @param key Of const string type, by reference.
+ * @return read-only reference to the string.
+ */
+static const string &requireString(const Json &query, const string &key) {
+    const Json &value = require(query, key);
+    if (value.getType() != Json::STRING) throw invalid_argument("\"" + key + "\" must be a string");
+    return value.asString();
+}
+
+/** @brief Returns a member that must be a number.
+ *
+ * @param query Of const Json type, by reference.
+ * @param key Of const string type, by reference.
+ * @return double.
+ */
+static double requireNumber(const Json &query, const string &key) {
+    const Json &value = require(query, key);
+    if (value.getType() != Json::NUMBER) throw invalid_argument("\"" + key + "\" must be a number");
+    return value.asNumber();
+}
+
+/** @brief Writes a list of strings as a JSON array.
+ *
+ * @param values Of const vector<string> type, by reference.
+ * @return string.
+ */
+static string toArray(const vector<string> &values) {
+    string output = "[";
+    for (size_t i = 0; i < values.size(); i++)
+        output += (i ? "," : "") + Json::quote(values[i]);
+    return output + "]";
+}
+
+BatchApplication::BatchApplication(DatabasePTR database) : database(database) {}
+
+LocalPTR BatchApplication::parseLocal(const Json &local) const {
+    if (local.getType() != Json::OBJECT) throw invalid_argument("a local must be an object");
+
+    if (local.has("airport")) {
+        const string &code = requireString(local, "airport");
+        if (!database->getAirport(code)) throw invalid_argument("unknown airport \"" + code + "\"");
+        return LocalPTR(new AirportLocal(code));
+    }
+    if (local.has("city"))
+        return LocalPTR(new CityLocal(City(requireString(local, "city"), requireString(local, "country"))));
+    if (local.has("latitude"))
+        return LocalPTR(new Coordinates(requireNumber(local, "latitude"), requireNumber(local, "longitude"),
+                                        requireNumber(local, "radius")));
+
+    throw invalid_argument("a local needs an \"airport\", a \"city\" or a \"latitude\"");
+}
+
+AirlineFilter BatchApplication::parseAirlines(const Json &query) const {
+    if (!query.has("airlines")) return database->getAirlineFilter();
+
+    unordered_set<string> codes;
+    for (const Json &airline: query["airlines"].getItems())
+        codes.insert(airline.asString());
+    return database->getAirlineFilter(codes);
+}
+
+//! @brief Defines the keys of a trajectories query that restrict it beyond the airlines.
+static const char *const CONSTRAINT_KEYS[] = {"avoid_airports", "avoid_countries", "avoid_airlines", "via",
+                                              "minimum_flights", "maximum_flights"};
+
+/** @brief Returns the id of an airport, given by its code.
+ *
+ * @param database Of const Database type, by reference.
+ * @param code Of const Json type, by reference.
+ * @return int.
+ */
+static int airportIdOf(const Database &database, const Json &code) {
+    AirportPTR airport = database.getAirport(code.asString());
+    if (!airport) throw invalid_argument("unknown airport \"" + code.asString() + "\"");
+    return airport->id;
+}
+
+Constraints BatchApplication::parseConstraints(const Json &query) const {
+    Constraints constraints = database->getConstraints(parseAirlines(query));
+
+    if (query.has("avoid_airports"))
+        for (const Json &code: query["avoid_airports"].getItems())
+            constraints.excludeAirport(airportIdOf(*database, code));
+    if (query.has("avoid_countries"))
+        for (const Json &name: query["avoid_countries"].getItems()) {
+            int country = StringPool::global().find(name.asString());
+            if (country == StringPool::NOT_FOUND) throw invalid_argument("unknown country \"" + name.asString() + "\"");
+            constraints.excludeCountry(country, database->getAirports());
+        }
+    if (query.has("avoid_airlines"))
+        for (const Json &code: query["avoid_airlines"].getItems()) {
+            int airline = database->getAirlineId(code.asString());
+            if (airline == -1) throw invalid_argument("unknown airline \"" + code.asString() + "\"");
+            constraints.excludeAirline(airline);
+        }
+    if (query.has("via"))
+        constraints.setVia(airportIdOf(*database, query["via"]));
+
+    int minimum = query.has("minimum_flights") ? require(query, "minimum_flights").asInt() : 1;
+    int maximum = query.has("maximum_flights") ? require(query, "maximum_flights").asInt() : Constraints::UNLIMITED;
+    if (minimum < 1 || minimum > 8) throw invalid_argument("\"minimum_flights\" must be between 1 and 8");
+    if (maximum < minimum) throw invalid_argument("\"maximum_flights\" must not be below \"minimum_flights\"");
+    constraints.setFlights(minimum, maximum);
+    return constraints;
+}
+
+Statistics::Ranking BatchApplication::parseRanking(const Json &ranking) {
+    if (ranking.getType() == Json::NUL) return Statistics::OUT_DEGREE;
+
+    const string &name = ranking.asString();
+    if (name == "departures") return Statistics::OUT_DEGREE;
+    if (name == "arrivals") return Statistics::IN_DEGREE;
+    if (name == "destinations") return Statistics::DESTINATIONS;
+    if (name == "airlines") return Statistics::AIRLINES;
+    throw invalid_argument("unknown ranking \"" + name + "\"");
+}
+
+string BatchApplication::trajectories(const Json &query) const {
+    LocalPTR origin = parseLocal(require(query, "origin"));
+    LocalPTR destination = parseLocal(require(query, "destination"));
+
+    bool constrained = false;
+    for (const char *key: CONSTRAINT_KEYS)
+        constrained = constrained || query.has(key);
+
+    list<pair<AirportPTR, list<Flight>>> found;
+    if (constrained) {
+        found = database->getTrajectories(origin, destination, parseConstraints(query));
+    } else if (query.has("airlines")) {
+        unordered_set<string> airlines;
+        for (const Json &airline: query["airlines"].getItems())
+            airlines.insert(airline.asString());
+        found = database->getTrajectories(origin, destination, airlines);
+    } else {
+        found = database->getTrajectories(origin, destination);
+    }
+
+    vector<pair<vector<string>, vector<string>>> trajectories;
+    for (const auto &trajectory: found) {
+        vector<string> airports{trajectory.first->code}, airlines;
+        for (const Flight &flight: trajectory.second) {
+            airports.push_back(database->getAirport(flight.destination)->code);
+            airlines.push_back(database->getAirline(flight.airline).code);
+        }
+        trajectories.emplace_back(airports, airlines);
+    }
+    sort(trajectories.begin(), trajectories.end());
+
+    string output = "{\"count\":" + to_string(trajectories.size()) + ",\"trajectories\":[";
+    for (size_t i = 0; i < trajectories.size(); i++)
+        output += string(i ? "," : "") + "{\"airports\":" + toArray(trajectories[i].first) +
+                  ",\"airlines\":" + toArray(trajectories[i].second) + "}";
+    return output + "]}";
+}
+
+string BatchApplication::reachable(const Json &query) const {
+    LocalPTR origin = parseLocal(require(query, "origin"));
+    int y = require(query, "flights").asInt();
+    string of = query.has("of") ? requireString(query, "of") : "airports";
+
+    vector<string> values;
+    if (of == "airports") {
+        for (const AirportPTR &airport: database->airportsWithMaxYFlights(origin, y))
+            values.push_back(airport->code);
+    } else if (of == "cities") {
+        vector<pair<string, string>> cities;
+        for (const City &city: database->citiesWithMaxYFlights(origin, y))
+            cities.emplace_back(city.getName(), city.getCountry());
+        sort(cities.begin(), cities.end());
+
+        string output = "{\"count\":" + to_string(cities.size()) + ",\"cities\":[";
+        for (size_t i = 0; i < cities.size(); i++)
+            output += string(i ? "," : "") + "{\"city\":" + Json::quote(cities[i].first) +
+                      ",\"country\":" + Json::quote(cities[i].second) + "}";
+        return output + "]}";
+    } else if (of == "countries") {
+        for (int country: database->countriesWithMaxYFlights(origin, y))
+            values.push_back(StringPool::global().get(country));
+    } else {
+        throw invalid_argument("\"of\" must be \"airports\", \"cities\" or \"countries\"");
+    }
+
+    sort(values.begin(), values.end());
+    return "{\"count\":" + to_string(values.size()) + ",\"" + of + "\":" + toArray(values) + "}";
+}
+
+string BatchApplication::airport(const Json &query) const {
+    const string &code = requireString(query, "code");
+    AirportPTR airport = database->getAirport(code);
+    if (!airport) throw invalid_argument("unknown airport \"" + code + "\"");
+
+    const Statistics::AirportStatistics &statistics = database->getStatistics().getAirport(airport->id);
+    ostringstream output;
+    output << "{\"code\":" << Json::quote(airport->code) << ",\"name\":" << Json::quote(airport->getName())
+           << ",\"city\":" << Json::quote(airport->getCity()) << ",\"country\":" << Json::quote(airport->getCountry())
+           << ",\"latitude\":" << airport->latitude << ",\"longitude\":" << airport->longitude
+           << ",\"flights\":" << statistics.flights << ",\"arrivals\":" << statistics.arrivals
+           << ",\"destinations\":" << statistics.destinations << ",\"airlines\":" << statistics.airlines
+           << ",\"cities\":" << statistics.cities << ",\"countries\":" << statistics.countries << "}";
+    return output.str();
+}
+
+string BatchApplication::statistics(const Json &query) const {
+    const Statistics &statistics = database->getStatistics();
+    Statistics::Ranking ranking = parseRanking(query["ranking"]);
+    int k = query.has("k") ? query["k"].asInt() : 10;
+
+    int airports, flights, airlines;
+    Statistics::RankingSlice top;
+    if (query.has("country")) {
+        const string &country = requireString(query, "country");
+        int countryId = StringPool::global().find(country);
+        const Statistics::CountryStatistics &countryStatistics = statistics.getCountry(countryId);
+        if (!countryStatistics.airports) throw invalid_argument("unknown country \"" + country + "\"");
+
+        airports = countryStatistics.airports;
+        flights = countryStatistics.flights;
+        airlines = countryStatistics.airlines;
+        top = statistics.getTop(ranking, countryId, k);
+    } else {
+        airports = statistics.getNumAirports();
+        flights = statistics.getNumFlights();
+        airlines = statistics.getNumAirlines();
+        top = statistics.getTop(ranking, k);
+    }
+
+    vector<string> codes;
+    for (int id: top)
+        codes.push_back(database->getAirport(id)->code);
+
+    return "{\"airports\":" + to_string(airports) + ",\"flights\":" + to_string(flights) +
+           ",\"airlines\":" + to_string(airlines) + ",\"top\":" + toArray(codes) + "}";
+}
+
+string BatchApplication::articulationPoints(const Deadline &deadline) const {
+    vector<string> codes;
+    for (const AirportPTR &airport: database->getArticulationPoints(deadline))
+        codes.push_back(airport->code);
+    sort(codes.begin(), codes.end());
+    return "{\"count\":" + to_string(codes.size()) + ",\"airports\":" + toArray(codes) + "}";
+}
+
+string BatchApplication::centrality(const Json &query, const Deadline &deadline) const {
+    int k = query.has("k") ? require(query, "k").asInt() : 10;
+    if (k < 0) throw invalid_argument("\"k\" must not be negative");
+
+    const Analytics::Results &analytics = database->getAnalytics(deadline);
+    vector<int> ids(analytics.betweenness.size());
+    for (size_t id = 0; id < ids.size(); id++) ids[id] = id;
+    k = min(k, (int) ids.size());
+    partial_sort(ids.begin(), ids.begin() + k, ids.end(), [&analytics](int first, int second) {
+        if (analytics.betweenness[first] != analytics.betweenness[second])
+            return analytics.betweenness[first] > analytics.betweenness[second];
+        return first < second;
+    });
+
+    ostringstream output;
+    output << "{\"count\":" << k << ",\"airports\":[";
+    for (int i = 0; i < k; i++)
+        output << (i ? "," : "") << "{\"code\":" << Json::quote(database->getAirport(ids[i])->code)
+               << ",\"betweenness\":" << analytics.betweenness[ids[i]]
+               << ",\"eccentricity\":" << analytics.eccentricities[ids[i]] << "}";
+    output << "],\"hops\":[";
+    for (size_t distance = 0; distance < analytics.hops.size(); distance++)
+        output << (distance ? "," : "") << analytics.hops[distance];
+    output << "]}";
+    return output.str();
+}
+
+string BatchApplication::cache() const {
+    string output = "{";
+    bool first = true;
+    for (const auto &cache: database->getCacheStatistics()) {
+        const CacheStatistics &statistics = cache.second;
+        output += string(first ? "" : ",") + Json::quote(cache.first) +
+                  ":{\"entries\":" + to_string(statistics.entries) + ",\"bytes\":" + to_string(statistics.bytes) +
+                  ",\"hits\":" + to_string(statistics.hits) + ",\"misses\":" + to_string(statistics.misses) +
+                  ",\"evictions\":" + to_string(statistics.evictions) + "}";
+        first = false;
+    }
+    return output + "}";
+}
+
+/** @brief Returns the minimum connection time of a schedule query, checking the database has schedules.
+ *
+ * @param query Of const Json type, by reference.
+ * @param database Of const Database type, by reference.
+ * @return int, in minutes.
+ */
+static int minimumConnectionOf(const Json &query, const Database &database) {
+    if (!database.hasSchedules()) throw invalid_argument("no schedules were read");
+    if (!query.has("minimum_connection")) return Timetable::MINIMUM_CONNECTION;
+
+    int minutes = require(query, "minimum_connection").asInt();
+    if (minutes < 0) throw invalid_argument("\"minimum_connection\" must not be negative");
+    return minutes;
+}
+
+/** @brief Reads a time that must be written as "HH:MM".
+ *
+ * @param query Of const Json type, by reference.
+ * @param key Of const string type, by reference.
+ * @return int, in minutes since midnight.
+ */
+static int requireTime(const Json &query, const string &key) {
+    int minutes;
+    if (!Timetable::parseTime(requireString(query, key), minutes))
+        throw invalid_argument("\"" + key + "\" must be a time as \"HH:MM\"");
+    return minutes;
+}
+
+string BatchApplication::journeyToJson(const Journey &journey) const {
+    string output = "{\"departure\":" + Json::quote(Timetable::formatTime(journey.front().departure)) +
+                    ",\"arrival\":" + Json::quote(Timetable::formatTime(journey.back().arrival)) + ",\"legs\":[";
+    for (size_t i = 0; i < journey.size(); i++) {
+        const Connection &leg = journey[i];
+        output += string(i ? "," : "") + "{\"origin\":" + Json::quote(database->getAirport(leg.origin)->code) +
+                  ",\"destination\":" + Json::quote(database->getAirport(leg.destination)->code) +
+                  ",\"airline\":" + Json::quote(database->getAirline(leg.airline).code) +
+                  ",\"departure\":" + Json::quote(Timetable::formatTime(leg.departure)) +
+                  ",\"arrival\":" + Json::quote(Timetable::formatTime(leg.arrival)) + "}";
+    }
+    return output + "]}";
+}
+
+string BatchApplication::earliestArrival(const Json &query) const {
+    int minimumConnection = minimumConnectionOf(query, *database);
+    LocalPTR origin = parseLocal(require(query, "origin"));
+    LocalPTR destination = parseLocal(require(query, "destination"));
+
+    int departure = requireTime(query, "departure");
+
+    Journey journey = database->getEarliestArrival(origin, destination, departure, minimumConnection);
+    if (journey.empty()) return "{\"found\":false}";
+    return "{\"found\":true,\"journey\":" + journeyToJson(journey) + "}";
+}
+
+string BatchApplication::profile(const Json &query, const Deadline &deadline) const {
+    int minimumConnection = minimumConnectionOf(query, *database);
+    LocalPTR origin = parseLocal(require(query, "origin"));
+    LocalPTR destination = parseLocal(require(query, "destination"));
+
+    vector<Journey> journeys = database->getProfile(origin, destination, minimumConnection, deadline);
+    string output = "{\"count\":" + to_string(journeys.size()) + ",\"journeys\":[";
+    for (size_t i = 0; i < journeys.size(); i++)
+        output += (i ? "," : "") + journeyToJson(journeys[i]);
+    return output + "]}";
+}
+
+string BatchApplication::pareto(const Json &query, const Deadline &deadline) const {
+    int minimumConnection = minimumConnectionOf(query, *database);
+    LocalPTR origin = parseLocal(require(query, "origin"));
+    LocalPTR destination = parseLocal(require(query, "destination"));
+    int departure = requireTime(query, "departure");
+
+    int maximumLegs = query.has("maximum_legs") ? require(query, "maximum_legs").asInt() : Raptor::MAXIMUM_LEGS;
+    if (maximumLegs < 1 || maximumLegs > 8) throw invalid_argument("\"maximum_legs\" must be between 1 and 8");
+
+    AirlineFilter airlines = parseAirlines(query);
+
+    vector<Journey> journeys;
+    if (query.has("until")) {
+        int until = requireTime(query, "until");
+        if (until <= departure) until += Timetable::DAY;
+        journeys = database->getParetoJourneys(origin, destination, departure, until, airlines, minimumConnection,
+                                               maximumLegs, deadline);
+    } else {
+        journeys = database->getParetoJourneys(origin, destination, departure, airlines, minimumConnection,
+                                               maximumLegs, deadline);
+    }
+
+    string output = "{\"count\":" + to_string(journeys.size()) + ",\"journeys\":[";
+    for (size_t i = 0; i < journeys.size(); i++)
+        output += (i ? "," : "") + journeyToJson(journeys[i]);
+    return output + "]}";
+}
+
+string BatchApplication::answer(const string &line, size_t number, bool &failed, const Deadline &deadline) const {
+    string head = "{\"line\":" + to_string(number);
+    failed = true;
+
+    Json query;
+    try {
+        query = Json::parse(line);
+    } catch (const invalid_argument &error) {
+        return head + ",\"error\":" + Json::quote(string("invalid JSON: ") + error.what()) + "}";
+    }
+    if (query.getType() != Json::OBJECT)
+        return head + ",\"error\":\"a query must be an object\"}";
+
+    if (query.has("id")) head += ",\"id\":" + query["id"].dump();
+    else if (query.has("request_id")) head += ",\"id\":" + query["request_id"].dump();
+
+    try {
+        const string &type = requireString(query, "type");
+        string result;
+
+        if (type == "trajectories") result = trajectories(query);
+        else if (type == "reachable") result = reachable(query);
+        else if (type == "airport") result = airport(query);
+        else if (type == "statistics") result = statistics(query);
+        else if (type == "diameter") result = "{\"diameter\":" + to_string(database->diameter(deadline)) + "}";
+        else if (type == "articulation_points") result = articulationPoints(deadline);
+        else if (type == "centrality") result = centrality(query, deadline);
+        else if (type == "cache") result = cache();
+        else if (type == "components")
+            result = "{\"count\":" + to_string(database->getConnectedComponents(deadline)) + "}";
+        else if (type == "earliest_arrival") result = earliestArrival(query);
+        else if (type == "profile") result = profile(query, deadline);
+        else if (type == "pareto") result = pareto(query, deadline);
+        else throw invalid_argument("unknown type \"" + type + "\"");
+
+        failed = false;
+        return head + ",\"type\":" + Json::quote(type) + ",\"result\":" + result + "}";
+    } catch (const exception &error) {
+        return head + ",\"error\":" + Json::quote(error.what()) + "}";
+    }
+}
+
+int BatchApplication::run(istream &input, ostream &output) const {
+    // The lines read and not written yet, in order; only their results change while they are answered.
+    deque<PendingLine> pending;
+    mutex pendingMutex, outputMutex;
+    int failures = 0;
+
+    // Writes the results at the front that are ready; one writer at a time, so they go out in order.
+    auto writeReady = [&]() {
+        lock_guard<mutex> writing(outputMutex);
+        bool caughtUp = false;
+        while (true) {
+            string result;
+            {
+                lock_guard<mutex> lock(pendingMutex);
+                if (pending.empty() || !pending.front().ready) {
+                    caughtUp = pending.empty();
+                    break;
+                }
+                result = move(pending.front().result);
+                failures += pending.front().failed;
+                pending.pop_front();
+            }
+            output << result << '\n';
+        }
+        if (caughtUp) output.flush();
+    };
+
+    Scheduler::TaskGroup group;
+    bool alone = Scheduler::global().getThreads() <= 1;
+    string line;
+    for (size_t number = 1; getline(input, line); number++) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.find_first_not_of(" \t") == string::npos) continue;
+
+        PendingLine *slot;
+        {
+            lock_guard<mutex> lock(pendingMutex);
+            pending.emplace_back();
+            slot = &pending.back();
+        }
+        slot->line = move(line);
+        slot->number = number;
+
+        group.run([&, slot]() {
+            bool lineFailed;
+            string result = answer(slot->line, slot->number, lineFailed);
+            {
+                lock_guard<mutex> lock(pendingMutex);
+                slot->result = move(result);
+                slot->failed = lineFailed;
+                slot->ready = true;
+            }
+            writeReady();
+        });
+
+        // Waiting runs queries in the meantime, so the reading thread works too;
+        // with no workers, it answers each line before reading the next.
+        group.waitUntil([&]() {
+            lock_guard<mutex> lock(pendingMutex);
+            return alone ? pending.empty() : pending.size() < MAX_PENDING;
+        });
+    }
+
+    group.wait();
+    writeReady();
+    output.flush();
+    return failures;
+}
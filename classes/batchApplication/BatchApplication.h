@@ -0,0 +1,199 @@
+/** @file BatchApplication.h
+ *  @brief Contains the BatchApplication class declaration.
+ *  @author -
+ *  @bug No known bugs.
+ */
+
+#ifndef AED_FEUP_PROJ_2_22_23_BATCHAPPLICATION_H
+#define AED_FEUP_PROJ_2_22_23_BATCHAPPLICATION_H
+
+#include <iostream>
+#include <string>
+#include "../../Pointers.h"
+#include "../Json/Json.h"
+#include "../Deadline/Deadline.h"
+#include "../Database/Statistics/Statistics.h"
+#include "../Graph/Connection/Connection.h"
+#include "../Graph/Constraints/Constraints.h"
+
+/** @brief BatchApplication class to answer a file of queries without the menus.
+ *
+ *  Reads one JSON query per line and writes one JSON result per line, in the same order.
+ *  The queries are answered by tasks on the global scheduler, sharing the read-only database,
+ *  while the input is still being read, so results stream out of a pipe as they are ready.
+ *
+ *  Every query is an object with a "type" and, optionally, an "id" echoed in its result:
+ *  - "trajectories": "origin", "destination" and optionally "airlines", an array of airline codes,
+ *    "avoid_airports", "avoid_countries" and "avoid_airlines", arrays of codes and names, "via", an airport code,
+ *    "minimum_flights", 1 by default, and "maximum_flights";
+ *  - "reachable": "origin", "flights" and "of", one of "airports", "cities" or "countries";
+ *  - "airport": "code";
+ *  - "statistics": optionally "country", "k", 10 by default, and "ranking",
+ *    one of "departures", "arrivals", "destinations" or "airlines";
+ *  - "diameter", "articulation_points" and "components";
+ *  - "centrality": optionally "k", 10 by default, the airports with the highest betweenness centrality,
+ *    with their eccentricity, and how many pairs of airports are each number of flights apart;
+ *  - "cache", the entries, bytes, hits, misses and evictions of the trajectory and reachability caches;
+ *  - "earliest_arrival": "origin", "destination", "departure", as "HH:MM", and optionally "minimum_connection",
+ *    in minutes, 45 by default;
+ *  - "profile": "origin", "destination" and optionally "minimum_connection";
+ *  - "pareto": "origin", "destination", "departure" and optionally "until", the end of a range of departures,
+ *    "airlines", "minimum_connection" and "maximum_legs", 4 by default.
+ *  The last three need a schedules file.
+ *  A local is {"airport": code}, {"city": name, "country": name}
+ *  or {"latitude": degrees, "longitude": degrees, "radius": kilometres}.
+ *  A line that is not a valid query gets a result with an "error" instead of a "result".
+ */
+class BatchApplication {
+
+private:
+
+    //! @brief Defines the most lines read ahead of the last result written, to bound the memory of a long input.
+    static const size_t MAX_PENDING = 4096;
+
+    //! @brief Holds the database.
+    DatabasePTR database;
+
+    /** @brief Reads a local.
+     *
+     * @param local Of const Json type, by reference.
+     * @return LocalPTR.
+     */
+    LocalPTR parseLocal(const Json &local) const;
+
+    /** @brief Reads the "airlines" of a query, allowing every airline if there are none.
+     *
+     * @param query Of const Json type, by reference.
+     * @return AirlineFilter.
+     */
+    AirlineFilter parseAirlines(const Json &query) const;
+
+    /** @brief Reads the constraints of a trajectories query into masks.
+     *
+     * @param query Of const Json type, by reference.
+     * @return Constraints.
+     */
+    Constraints parseConstraints(const Json &query) const;
+
+    /** @brief Reads a ranking name.
+     *
+     * @param ranking Of const Json type, by reference.
+     * @return Statistics::Ranking.
+     */
+    static Statistics::Ranking parseRanking(const Json &ranking);
+
+    /** @brief Answers a trajectories query.
+     *
+     * @param query Of const Json type, by reference.
+     * @return string with the JSON result.
+     */
+    string trajectories(const Json &query) const;
+
+    /** @brief Answers a reachable query.
+     *
+     * @param query Of const Json type, by reference.
+     * @return string with the JSON result.
+     */
+    string reachable(const Json &query) const;
+
+    /** @brief Answers an airport query.
+     *
+     * @param query Of const Json type, by reference.
+     * @return string with the JSON result.
+     */
+    string airport(const Json &query) const;
+
+    /** @brief Answers a statistics query.
+     *
+     * @param query Of const Json type, by reference.
+     * @return string with the JSON result.
+     */
+    string statistics(const Json &query) const;
+
+    /** @brief Answers an articulation points query.
+     *
+     * @param deadline Of const Deadline type, by reference.
+     * @return string with the JSON result.
+     */
+    string articulationPoints(const Deadline &deadline) const;
+
+    /** @brief Answers a cache query, with the use of each query cache.
+     *
+     * @return string with the JSON result.
+     */
+    string cache() const;
+
+    /** @brief Answers a centrality query, with the airports most shortest paths go through.
+     *
+     * @param query Of const Json type, by reference.
+     * @param deadline Of const Deadline type, by reference.
+     * @return string with the JSON result.
+     */
+    string centrality(const Json &query, const Deadline &deadline) const;
+
+    /** @brief Writes a journey, with the times and the legs, as JSON.
+     *
+     * @param journey Of const Journey type, by reference, not empty.
+     * @return string.
+     */
+    string journeyToJson(const Journey &journey) const;
+
+    /** @brief Answers an earliest arrival query.
+     *
+     * @param query Of const Json type, by reference.
+     * @return string with the JSON result.
+     */
+    string earliestArrival(const Json &query) const;
+
+    /** @brief Answers a profile query.
+     *
+     * @param query Of const Json type, by reference.
+     * @param deadline Of const Deadline type, by reference.
+     * @return string with the JSON result.
+     */
+    string profile(const Json &query, const Deadline &deadline) const;
+
+    /** @brief Answers a pareto query.
+     *
+     * @param query Of const Json type, by reference.
+     * @param deadline Of const Deadline type, by reference.
+     * @return string with the JSON result.
+     */
+    string pareto(const Json &query, const Deadline &deadline) const;
+
+public:
+
+    /** Creates a new BatchApplication with a database.
+     *
+     * @param database of DatabasePTR type, already read.
+     */
+    explicit BatchApplication(DatabasePTR database);
+
+    /** @brief Answers one line of the input.
+     *
+     * Safe to call from several threads at once.
+     *
+     * @param line Of const string type, by reference.
+     * @param number Of size_t type, the line number, starting at 1.
+     * @param failed Of bool type, by reference, set to true if the line is not a valid query.
+     * @param deadline Of const Deadline type, by reference, after which the long searches give up
+     * and the line is answered with a "deadline exceeded" error; none by default.
+     * @return string with the JSON result, without a line break.
+     */
+    string answer(const string &line, size_t number, bool &failed, const Deadline &deadline = Deadline()) const;
+
+    /** @brief Answers every line of the input.
+     *
+     * Each line is handed to a task as soon as it is read, and each result is written, by the task that
+     * finishes it, as soon as it and every result before it are ready; the output is flushed once it caught up
+     * with the input. Reading waits while MAX_PENDING lines are not written yet.
+     * Blank lines are skipped.
+     *
+     * @param input Of istream type, by reference.
+     * @param output Of ostream type, by reference.
+     * @return int number of lines that failed.
+     */
+    int run(istream &input, ostream &output) const;
+};
+
+#endif //AED_FEUP_PROJ_2_22_23_BATCHAPPLICATION_H
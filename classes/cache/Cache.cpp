@@ -0,0 +1,57 @@
+/** @file Cache.cpp
+ *  @brief Contains the CacheKey implementation.
+ *  @author -
+ *  @bug No known bugs.
+ */
+
+#include "Cache.h"
+#include <algorithm>
+
+/** @brief Mixes a value into a hash.
+ *
+ * @param hash Of size_t type.
+ * @param value Of unsigned long long type.
+ * @return size_t.
+ */
+static size_t combine(size_t hash, unsigned long long value) {
+    value *= 0x9E3779B97F4A7C15ULL;
+    return hash ^ ((size_t) (value ^ (value >> 32)) + (hash << 6) + (hash >> 2));
+}
+
+CacheKey CacheKey::of(int kind, int parameter, vector<int> origins, vector<int> destinations,
+                      const vector<bool> &airlines) {
+    CacheKey key;
+    key.kind = kind;
+    key.parameter = parameter;
+
+    sort(origins.begin(), origins.end());
+    origins.erase(unique(origins.begin(), origins.end()), origins.end());
+    sort(destinations.begin(), destinations.end());
+    destinations.erase(unique(destinations.begin(), destinations.end()), destinations.end());
+    key.origins = move(origins);
+    key.destinations = move(destinations);
+
+    key.airlines.assign((airlines.size() + 63) / 64, 0);
+    for (size_t airline = 0; airline < airlines.size(); airline++)
+        if (airlines[airline])
+            key.airlines[airline / 64] |= 1ULL << (airline % 64);
+
+    size_t hash = combine(combine(0, kind), parameter);
+    for (int origin: key.origins) hash = combine(hash, origin);
+    hash = combine(hash, key.origins.size());
+    for (int destination: key.destinations) hash = combine(hash, destination);
+    hash = combine(hash, key.destinations.size());
+    for (unsigned long long word: key.airlines) hash = combine(hash, word);
+    key.hash = hash;
+    return key;
+}
+
+size_t CacheKey::bytes() const {
+    return sizeof(CacheKey) + (origins.size() + destinations.size()) * sizeof(int) +
+           airlines.size() * sizeof(unsigned long long);
+}
+
+bool CacheKey::operator==(const CacheKey &other) const {
+    return hash == other.hash && kind == other.kind && parameter == other.parameter && origins == other.origins &&
+           destinations == other.destinations && airlines == other.airlines;
+}
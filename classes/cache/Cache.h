@@ -0,0 +1,298 @@
+/** @file Cache.h
+ *  @brief Contains the CacheKey struct and the Cache class declaration.
+ *  @author -
+ *  @bug No known bugs.
+ */
+
+#ifndef AED_FEUP_PROJ_2_22_23_CACHE_H
+#define AED_FEUP_PROJ_2_22_23_CACHE_H
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+/** @brief cacheKey struct to represent a query in a canonical form.
+ *
+ *  Two queries that search from the same airports to the same airports, with the same airlines,
+ *  have equal keys however their locals were given.
+ */
+struct CacheKey {
+
+    //! @brief Holds the kind of query.
+    int kind = 0;
+
+    //! @brief Holds a number the result depends on, such as a maximum number of flights.
+    int parameter = 0;
+
+    //! @brief Holds the ids of the origin airports, sorted.
+    vector<int> origins;
+
+    //! @brief Holds the ids of the destination airports, sorted.
+    vector<int> destinations;
+
+    //! @brief Holds the airlines allowed, one bit per airline id.
+    vector<unsigned long long> airlines;
+
+    //! @brief Holds the hash of all the fields.
+    size_t hash = 0;
+
+    /** @brief Builds the key of a query, sorting the airports and packing the airlines.
+     *
+     * @param kind Of int type.
+     * @param parameter Of int type.
+     * @param origins Of vector<int> type, the ids of the origin airports.
+     * @param destinations Of vector<int> type, the ids of the destination airports.
+     * @param airlines Of const vector<bool> type, by reference, the airlines allowed, indexed by id.
+     * @return CacheKey.
+     */
+    static CacheKey of(int kind, int parameter, vector<int> origins, vector<int> destinations,
+                       const vector<bool> &airlines);
+
+    /** @brief Returns the number of bytes the key takes.
+     *
+     * @return size_t.
+     */
+    size_t bytes() const;
+
+    bool operator==(const CacheKey &other) const;
+
+    struct hashFunction {
+        size_t operator()(const CacheKey &key) const {
+            return key.hash;
+        }
+    };
+};
+
+/** @brief cacheStatistics struct to represent the use of a cache.
+ *
+ */
+struct CacheStatistics {
+
+    //! @brief Holds the number of results held.
+    size_t entries = 0;
+
+    //! @brief Holds the estimated number of bytes the results take.
+    size_t bytes = 0;
+
+    //! @brief Holds the number of lookups that found a result.
+    unsigned long long hits = 0;
+
+    //! @brief Holds the number of lookups that did not.
+    unsigned long long misses = 0;
+
+    //! @brief Holds the number of results dropped to stay in the budget.
+    unsigned long long evictions = 0;
+};
+
+/** @brief Cache class to represent a thread-safe memo of query results, dropping the least recently used.
+ *
+ *  The keys are split among shards by their hash, each with its own lock, list and index,
+ *  so lookups from several threads rarely wait for each other.
+ *  Each shard keeps its results from the most to the least recently used,
+ *  and drops from the end while they take more than its part of the memory budget.
+ *  The results are shared and read-only, so a lookup does not copy them while holding the lock.
+ *  The results belong to a version of the data, and are all dropped when it changes.
+ */
+template<typename Value>
+class Cache {
+
+private:
+
+    /** @brief entry struct to represent a result held by the cache.
+     *
+     */
+    struct Entry {
+
+        //! @brief Holds the key of the query.
+        CacheKey key;
+
+        //! @brief Holds the result.
+        shared_ptr<const Value> value;
+
+        //! @brief Holds the estimated number of bytes of the key and the result.
+        size_t bytes;
+    };
+
+    /** @brief shard struct to represent the part of the cache with a range of hashes.
+     *
+     */
+    struct Shard {
+
+        //! @brief Holds the lock of the shard.
+        mutex lock;
+
+        //! @brief Holds the entries, from the most to the least recently used.
+        list<Entry> entries;
+
+        //! @brief Holds the position of each entry in the list, by key.
+        unordered_map<CacheKey, typename list<Entry>::iterator, CacheKey::hashFunction> index;
+
+        //! @brief Holds the estimated number of bytes of the entries.
+        size_t bytes = 0;
+    };
+
+    //! @brief Holds the shards.
+    vector<Shard> shards;
+
+    //! @brief Holds the number of bytes each shard may take.
+    atomic<size_t> shardBudget;
+
+    //! @brief Holds the version of the data the results belong to.
+    atomic<unsigned long long> version{0};
+
+    //! @brief Holds the number of lookups that found a result.
+    atomic<unsigned long long> hits{0};
+
+    //! @brief Holds the number of lookups that did not.
+    atomic<unsigned long long> misses{0};
+
+    //! @brief Holds the number of results dropped to stay in the budget.
+    atomic<unsigned long long> evictions{0};
+
+    /** @brief Returns the shard of a key.
+     *
+     * @param key Of const CacheKey type, by reference.
+     * @return Shard, by reference.
+     */
+    Shard &shardOf(const CacheKey &key) {
+        return shards[key.hash % shards.size()];
+    }
+
+    /** @brief Drops the least recently used entries of a shard until it fits a budget.
+     *
+     * @param shard Of Shard type, by reference, whose lock is held.
+     * @param budget Of size_t type.
+     * @return Void.
+     */
+    void shrink(Shard &shard, size_t budget) {
+        while (shard.bytes > budget) {
+            shard.bytes -= shard.entries.back().bytes;
+            shard.index.erase(shard.entries.back().key);
+            shard.entries.pop_back();
+            evictions++;
+        }
+    }
+
+public:
+
+    //! @brief Defines the number of shards.
+    static const size_t SHARDS = 16;
+
+    /** Create a new, empty, Cache.
+     *
+     * @param budget Of size_t type, the number of bytes the results may take, 0 to hold none.
+     */
+    explicit Cache(size_t budget) : shards(SHARDS), shardBudget(budget / SHARDS) {}
+
+    Cache(const Cache &) = delete;
+
+    Cache &operator=(const Cache &) = delete;
+
+    /** @brief Returns the result of a query, if it is held.
+     *
+     * Marks it as the most recently used.
+     *
+     * @param key Of const CacheKey type, by reference.
+     * @return shared_ptr<const Value>, null if it is not held.
+     */
+    shared_ptr<const Value> find(const CacheKey &key) {
+        Shard &shard = shardOf(key);
+        lock_guard<mutex> guard(shard.lock);
+        auto found = shard.index.find(key);
+        if (found == shard.index.end()) {
+            misses++;
+            return nullptr;
+        }
+        hits++;
+        shard.entries.splice(shard.entries.begin(), shard.entries, found->second);
+        return found->second->value;
+    }
+
+    /** @brief Holds the result of a query, dropping the least recently used ones if needed.
+     *
+     * A result bigger than the budget of a shard is not held.
+     *
+     * @param key Of const CacheKey type, by reference.
+     * @param value Of shared_ptr<const Value> type.
+     * @param bytes Of size_t type, the estimated number of bytes of the result.
+     * @return Void.
+     */
+    void insert(const CacheKey &key, shared_ptr<const Value> value, size_t bytes) {
+        bytes += key.bytes() + sizeof(Entry);
+        size_t budget = shardBudget;
+        if (bytes > budget) return;
+
+        Shard &shard = shardOf(key);
+        lock_guard<mutex> guard(shard.lock);
+        auto found = shard.index.find(key);
+        if (found != shard.index.end()) {
+            shard.bytes -= found->second->bytes;
+            shard.entries.erase(found->second);
+            shard.index.erase(found);
+        }
+        shard.entries.push_front({key, move(value), bytes});
+        shard.index[key] = shard.entries.begin();
+        shard.bytes += bytes;
+        shrink(shard, budget);
+    }
+
+    /** @brief Sets the version of the data, dropping every result if it changed.
+     *
+     * @param version Of unsigned long long type.
+     * @return Void.
+     */
+    void setVersion(unsigned long long version) {
+        if (this->version.exchange(version) != version)
+            clear();
+    }
+
+    /** @brief Sets the memory budget, dropping the least recently used results that no longer fit.
+     *
+     * @param budget Of size_t type, in bytes.
+     * @return Void.
+     */
+    void setBudget(size_t budget) {
+        shardBudget = budget / SHARDS;
+        for (Shard &shard: shards) {
+            lock_guard<mutex> guard(shard.lock);
+            shrink(shard, shardBudget);
+        }
+    }
+
+    /** @brief Drops every result.
+     *
+     * @return Void.
+     */
+    void clear() {
+        for (Shard &shard: shards) {
+            lock_guard<mutex> guard(shard.lock);
+            shard.entries.clear();
+            shard.index.clear();
+            shard.bytes = 0;
+        }
+    }
+
+    /** @brief Returns the use of the cache.
+     *
+     * @return CacheStatistics.
+     */
+    CacheStatistics getStatistics() {
+        CacheStatistics statistics;
+        for (Shard &shard: shards) {
+            lock_guard<mutex> guard(shard.lock);
+            statistics.entries += shard.entries.size();
+            statistics.bytes += shard.bytes;
+        }
+        statistics.hits = hits;
+        statistics.misses = misses;
+        statistics.evictions = evictions;
+        return statistics;
+    }
+};
+
+#endif //AED_FEUP_PROJ_2_22_23_CACHE_H
@@ -8,13 +8,56 @@
 #include <sstream>
 #include <fstream>
 #include <unordered_set>
+#include <future>
+#include <atomic>
+#include "../Scheduler/Scheduler.h"
+#include "../Instrumentation/Instrumentation.h"
 
 using namespace std;
 
+const string Database::AIRPORTS_FILE = "airports.csv";
+const string Database::AIRLINES_FILE = "airlines.csv";
+const string Database::FLIGHTS_FILE = "flights.csv";
+const string Database::SNAPSHOT_FILE = "flightmap.snapshot";
+const string Database::ANALYTICS_FILE = "analytics.cache";
+const string Database::SCHEDULES_FILE = "schedules.csv";
+const size_t Database::CACHE_BUDGET;
+const size_t Database::SUBGRAPH_BUDGET;
+
+//! @brief Defines the kinds of query the caches hold results of.
+enum CachedQuery {
+    TRAJECTORIES, REACHABLE, SUBGRAPH
+};
+
+//! @brief Holds the last version given to the data of a database.
+static atomic<unsigned long long> lastVersion{0};
+
+//! @brief Defines the number of lines parsed between each update of the load progress.
+static const int PROGRESS_LINES = 4096;
+
+/** @brief Returns the size of a file.
+ *
+ * @param path Of const string type, by reference.
+ * @return size_t, 0 if the file could not be opened.
+ */
+static size_t fileSize(const string &path) {
+    ifstream file(path, ios::binary | ios::ate);
+    return file ? (size_t) file.tellg() : 0;
+}
+
 Database::Database() = default;
 
+Database::~Database() {
+    if (loader.joinable()) loader.join();
+}
+
+void Database::setDirectory(const string &directory) {
+    this->directory = directory.empty() || directory.back() == '/' ? directory : directory + '/';
+}
+
 void Database::readAirlines() {
-    ifstream airlineFile("../resources/airlines.csv");
+    INSTRUMENT_SCOPE("startup/readAirlines");
+    ifstream airlineFile(directory + AIRLINES_FILE);
     string line;
 
     getline(airlineFile, line);
@@ -27,14 +70,19 @@ void Database::readAirlines() {
         getline(airlineFile, name, ',');
         getline(airlineFile, callSign, ',');
         getline(airlineFile, country);
-        airlines.insert(pair<string, Airline>(code, {code, name, callSign, country}));
+        bytesParsed += code.size() + name.size() + callSign.size() + country.size() + 4;
+        rowsLoaded++;
+        Airline airline{(int) airlines.size(), code, name, callSign, country};
+        if (!airlineIds.set(code, airline.id)) continue;
+        airlines.push_back(airline);
 
     } while (true);
 
 }
 
 void Database::readAirports() {
-    ifstream airportFile("../resources/airports.csv");
+    INSTRUMENT_SCOPE("startup/readAirports");
+    ifstream airportFile(directory + AIRPORTS_FILE);
     string line;
 
     getline(airportFile, line);
@@ -49,114 +97,556 @@ void Database::readAirports() {
         getline(airportFile, country, ',');
         getline(airportFile, latitude, ',');
         getline(airportFile, longitude);
+        bytesParsed += code.size() + name.size() + cityName.size() + country.size() + latitude.size() +
+                       longitude.size() + 6;
+        rowsLoaded++;
 
-        AirportPTR airport{new Airport(
-                code, name, cityName, country, stof(latitude), stof(longitude))};
+        AirportPTR airport = arena.create<Airport>(
+                code, name, cityName, country, stof(latitude), stof(longitude));
+        airport->id = this->airports.size();
+        if (!airportIds.set(code, airport->id)) continue;
+        this->airports.push_back(airport);
 
-        City city{cityName, country};
-        if (airportsPerCity.find(city) != airportsPerCity.end())
-            airportsPerCity[city].insert(airport);
+        airportsPerCity[City(airport->city, airport->country)].insert(airport);
+    } while (true);
+}
+
+string Database::readFile(const string &path) {
+    INSTRUMENT_SCOPE("startup/readFile");
+    ifstream file(path, ios::binary);
+    return string(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+}
 
-        else {
-            unordered_set<AirportPTR, Airport::hashFunction> airports;
-            airports.insert(airport);
-            airportsPerCity.insert(pair<City, unordered_set<AirportPTR, Airport::hashFunction>>(city, airports));
+void Database::parseFlights(const char *begin, const char *end,
+                            vector<FlightRecord> &records, vector<int> &counts) const {
+    const char *fields[3];
+    size_t lengths[3];
+    const char *reported = begin;
+    size_t reportedRecords = records.size();
+    int lines = 0;
+
+    while (begin < end) {
+        if (++lines % PROGRESS_LINES == 0) {
+            bytesParsed += begin - reported;
+            rowsLoaded += records.size() - reportedRecords;
+            reported = begin;
+            reportedRecords = records.size();
         }
-        this->airports.insert(pair<string, AirportPTR>(code, airport));
 
-    } while (true);
+        const char *lineEnd = find(begin, end, '\n');
+
+        const char *field = begin;
+        int fieldCount = 0;
+        for (const char *c = begin; c <= lineEnd && fieldCount < 3; c++) {
+            if (c == lineEnd || *c == ',') {
+                fields[fieldCount] = field;
+                lengths[fieldCount++] = c - field;
+                field = c + 1;
+            }
+        }
+        begin = lineEnd + 1;
+
+        if (fieldCount < 3) continue;
+        if (lengths[2] && fields[2][lengths[2] - 1] == '\r') lengths[2]--;
+
+        int origin = airportIds.get(fields[0], lengths[0]);
+        int destination = airportIds.get(fields[1], lengths[1]);
+        int airline = airlineIds.get(fields[2], lengths[2]);
+        if (origin == -1 || destination == -1 || airline == -1)
+            continue;
+
+        records.push_back({origin, destination, airline});
+        counts[origin]++;
+    }
+    bytesParsed += end - reported;
+    rowsLoaded += records.size() - reportedRecords;
 }
 
-void Database::readFlights() {
-    ifstream flightsFile("../resources/flights.csv");
-    string line;
+void Database::readFlights(const string &content) {
+    INSTRUMENT_SCOPE("startup/readFlights");
+    const char *begin = content.data();
+    const char *end = begin + content.size();
 
-    getline(flightsFile, line);
+    begin = find(begin, end, '\n');
+    if (begin != end) begin++;
+    bytesParsed += begin - content.data();
 
-    string originCode, destinationCode, companyCode;
+    Scheduler &scheduler = Scheduler::global();
+    unsigned threads = min<unsigned>(scheduler.getThreads(), (end - begin) / 4096 + 1);
 
-    do {
-        getline(flightsFile, originCode, ',');
-        if (originCode == "") break;
-        getline(flightsFile, destinationCode, ',');
-        getline(flightsFile, companyCode);
+    vector<const char *> limits{begin};
+    for (unsigned i = 1; i < threads; i++) {
+        const char *limit = begin + (end - begin) * i / threads;
+        limit = max(limit, limits.back());
+        limit = find(limit, end, '\n');
+        limits.push_back(limit == end ? end : limit + 1);
+    }
+    limits.push_back(end);
+
+    size_t numAirports = airports.size();
+    vector<vector<FlightRecord>> records(threads);
+    vector<vector<int>> counts(threads, vector<int>(numAirports, 0));
+
+    scheduler.parallelFor(0, threads, 1, [&](int first, int last) {
+        for (int i = first; i < last; i++)
+            parseFlights(limits[i], limits[i + 1], records[i], counts[i]);
+    });
+
+    vector<int> firstFlight(numAirports + 1, 0);
+    int offset = 0;
+    for (size_t airport = 0; airport < numAirports; airport++) {
+        firstFlight[airport] = offset;
+        for (unsigned i = 0; i < threads; i++) {
+            int count = counts[i][airport];
+            counts[i][airport] = offset;
+            offset += count;
+        }
+    }
+    firstFlight[numAirports] = offset;
 
-        airports[originCode]->addFlight({destinationCode, companyCode});
+    Flight *flights = arena.createArray<Flight>(offset);
+    scheduler.parallelFor(0, threads, 1, [&](int first, int last) {
+        for (int i = first; i < last; i++)
+            for (const FlightRecord &record: records[i])
+                flights[counts[i][record.source]++] = {record.destination, record.airline};
+    });
 
-    } while (true);
+    for (size_t airport = 0; airport < numAirports; airport++)
+        airports[airport]->setFlights(flights + firstFlight[airport], flights + firstFlight[airport + 1]);
 }
 
-void Database::read() {
-    readAirports();
-    readAirlines();
-    readFlights();
+bool Database::readSnapshot() {
+    INSTRUMENT_SCOPE("startup/readSnapshot");
+    if (!snapshot.open(directory + SNAPSHOT_FILE,
+                       {directory + AIRPORTS_FILE, directory + AIRLINES_FILE, directory + FLIGHTS_FILE}, order)) {
+        snapshot.close();
+        return false;
+    }
+    contentHash = snapshot.getContentHash();
+
+    uint32_t numAirlines = snapshot.getNumAirlines();
+    airlines.reserve(numAirlines);
+    for (uint32_t id = 0; id < numAirlines; id++) {
+        const Snapshot::AirlineRecord &record = snapshot.getAirline(id);
+        Airline airline{(int) id, snapshot.getString(record.code), snapshot.getString(record.name),
+                        snapshot.getString(record.callSign), snapshot.getString(record.country)};
+        airlineIds.set(airline.code, airline.id);
+        airlines.push_back(airline);
+    }
 
-    flightMap->setAirports(airports);
+    // The records refer to their names by index in the table, so each distinct string is interned once.
+    StringPool &pool = StringPool::global();
+    vector<int> poolIds(snapshot.getNumPoolStrings());
+    for (uint32_t index = 0; index < poolIds.size(); index++)
+        poolIds[index] = pool.intern(snapshot.getString(snapshot.getPoolString(index)));
+
+    uint32_t numAirports = snapshot.getNumAirports();
+    uint32_t numFlights = snapshot.getNumFlights();
+    airports.reserve(numAirports);
+    arena.reserve(numAirports * (sizeof(Airport) + alignof(Airport)));
+    for (uint32_t id = 0; id < numAirports; id++) {
+        const Snapshot::AirportRecord &record = snapshot.getAirport(id);
+        AirportPTR airport = arena.create<Airport>(
+                snapshot.getString(record.code), poolIds[record.name], poolIds[record.city],
+                poolIds[record.country], snapshot.getLatitude(id), snapshot.getLongitude(id));
+        airport->id = id;
+        airport->setFlights(snapshot.flightsBegin(id), snapshot.flightsEnd(id));
+        airportIds.set(airport->code, airport->id);
+        airports.push_back(airport);
+        inputOrder.push_back(snapshot.getInputOrder(id));
+    }
+    bytesParsed = bytesTotal.load();
+    rowsLoaded = numAirlines + numAirports + numFlights;
+
+    uint32_t numCities = snapshot.getNumCities();
+    airportsPerCity.reserve(numCities);
+    for (uint32_t index = 0; index < numCities; index++) {
+        const Snapshot::CityRecord &record = snapshot.getCity(index);
+        Airports_Set &cityAirports = airportsPerCity[City(poolIds[record.name], poolIds[record.country])];
+        cityAirports.reserve(record.numAirports);
+        for (uint32_t position = record.firstAirport; position < record.firstAirport + record.numAirports; position++)
+            cityAirports.insert(airports[snapshot.getCityAirport(position)]);
+    }
+
+    // The snapshot written over this one is a new file, so the mapping the flights point into stays valid.
+    if (snapshot.isTouched())
+        writeSnapshot();
+    return true;
+}
+
+void Database::writeSnapshot() {
+    INSTRUMENT_SCOPE("startup/writeSnapshot");
+    Snapshot::write(directory + SNAPSHOT_FILE,
+                    {directory + AIRPORTS_FILE, directory + AIRLINES_FILE, directory + FLIGHTS_FILE},
+                    airports, airlines, airportsPerCity, inputOrder, order);
+}
+
+void Database::renumber() {
+    INSTRUMENT_SCOPE("startup/renumber");
+    vector<int> newIds = Renumbering::newIds(airports, order);
+
+    vector<AirportPTR> renumbered(airports.size());
+    size_t numFlights = 0;
+    for (const AirportPTR &airport: airports) {
+        renumbered[newIds[airport->id]] = airport;
+        numFlights += airport->flights.size();
+    }
+
+    Flight *flights = arena.createArray<Flight>(numFlights);
+    for (size_t id = 0; id < renumbered.size(); id++) {
+        AirportPTR airport = arena.create<Airport>(*renumbered[id]);
+        Flight *first = flights;
+        for (const Flight &flight: renumbered[id]->flights)
+            *flights++ = {newIds[flight.destination], flight.airline};
+        airport->id = id;
+        airport->setFlights(first, flights);
+        airportIds.set(airport->code, airport->id);
+        renumbered[id] = airport;
+    }
+    airports = move(renumbered);
+    for (int &id: inputOrder) id = newIds[id];
+
+    airportsPerCity = AirportsPerCity_Set();
+    for (const AirportPTR &airport: airports)
+        airportsPerCity[City(airport->city, airport->country)].insert(airport);
+}
+
+void Database::readSchedules() {
+    INSTRUMENT_SCOPE("startup/readSchedules");
+    string content = readFile(directory + SCHEDULES_FILE);
+    if (content.empty()) return;
+
+    const char *begin = content.data();
+    const char *end = begin + content.size();
+    begin = find(begin, end, '\n');
+    if (begin != end) begin++;
+
+    vector<Connection> connections;
+    const char *fields[5];
+    size_t lengths[5];
+
+    while (begin < end) {
+        const char *lineEnd = find(begin, end, '\n');
+
+        const char *field = begin;
+        int fieldCount = 0;
+        for (const char *c = begin; c <= lineEnd && fieldCount < 5; c++) {
+            if (c == lineEnd || *c == ',') {
+                fields[fieldCount] = field;
+                lengths[fieldCount++] = c - field;
+                field = c + 1;
+            }
+        }
+        begin = lineEnd + 1;
+
+        if (fieldCount < 5) continue;
+        if (lengths[4] && fields[4][lengths[4] - 1] == '\r') lengths[4]--;
+
+        Connection connection{};
+        connection.origin = airportIds.get(fields[0], lengths[0]);
+        connection.destination = airportIds.get(fields[1], lengths[1]);
+        connection.airline = airlineIds.get(fields[2], lengths[2]);
+        if (connection.origin == -1 || connection.destination == -1 || connection.airline == -1 ||
+            !Timetable::parseTime(string(fields[3], lengths[3]), connection.departure) ||
+            !Timetable::parseTime(string(fields[4], lengths[4]), connection.arrival))
+            continue;
+
+        if (connection.arrival <= connection.departure) connection.arrival += Timetable::DAY;
+        connections.push_back(connection);
+    }
+    timetable.setConnections(connections, airports.size());
+    raptor.setConnections(connections, airports.size());
+}
+
+void Database::readNetwork(bool useSnapshot) {
+    bytesParsed = 0;
+    rowsLoaded = 0;
+    bytesTotal = fileSize(directory + AIRPORTS_FILE) + fileSize(directory + AIRLINES_FILE) +
+                 fileSize(directory + FLIGHTS_FILE);
+    if (!useSnapshot || !readSnapshot()) {
+        future<void> airportsRead = async(launch::async, &Database::readAirports, this);
+        future<void> airlinesRead = async(launch::async, &Database::readAirlines, this);
+        string flightsContent = readFile(directory + FLIGHTS_FILE);
+
+        airportsRead.get();
+        airlinesRead.get();
+        readFlights(flightsContent);
+        for (const AirportPTR &airport: airports) inputOrder.push_back(airport->id);
+        if (order != Renumbering::INPUT) renumber();
+        if (useSnapshot) writeSnapshot();
+        contentHash = Snapshot::contentHash({directory + AIRPORTS_FILE, directory + AIRLINES_FILE,
+                                             directory + FLIGHTS_FILE});
+    }
+
+    flightMap->setAirports(airports, inputOrder);
     flightMap->setAirportsPerCity(airportsPerCity);
+
+    version = ++lastVersion;
+    trajectoryCache.setVersion(version);
+    reachableCache.setVersion(version);
+    subgraphCache.setVersion(version);
+    // The analytics are indexed by id, so they belong to an order of the airports as well as to the input files.
+    uint64_t analyticsKey[2] = {contentHash, (uint64_t) order};
+    analytics.open(directory + ANALYTICS_FILE, Snapshot::hash(reinterpret_cast<const char *>(analyticsKey),
+                                                              sizeof(analyticsKey)), flightMap.get());
+
+    INSTRUMENT_SCOPE("startup/statistics");
+    statistics.build(airports, airlines.size());
+}
+
+void Database::read(bool useSnapshot) {
+    INSTRUMENT_SCOPE("startup");
+    readNetwork(useSnapshot);
+    readSchedules();
+}
+
+shared_future<void> Database::readAsync() {
+    shared_ptr<promise<void>> networkRead = make_shared<promise<void>>();
+    shared_future<void> loaded = networkRead->get_future().share();
+    loader = thread([this, networkRead]() {
+        INSTRUMENT_SCOPE("startup");
+        try {
+            readNetwork(true);
+        }
+        catch (...) {
+            networkRead->set_exception(current_exception());
+            return;
+        }
+        networkRead->set_value();
+        readSchedules();
+        startAnalytics();
+    });
+    return loaded;
 }
 
-AirportPTR Database::getAirport(string code) {
-    return airports[code];
+Database::LoadProgress Database::getLoadProgress() const {
+    return {bytesParsed, bytesTotal, rowsLoaded};
 }
 
-Airline Database::getAirline(string code) {
-    return airlines[code];
+AirportPTR Database::getAirport(const string &code) const {
+    int id = airportIds.get(code);
+    return id == -1 ? nullptr : airports[id];
 }
 
-AirportsPerCity_Set Database::getAirportsPerCity() {
+const AirportPTR &Database::getAirport(int id) const {
+    return airports[id];
+}
+
+const Airline &Database::getAirline(const string &code) const {
+    static const Airline noAirline{};
+    int id = airlineIds.get(code);
+    return id == -1 ? noAirline : airlines[id];
+}
+
+const Airline &Database::getAirline(int id) const {
+    return airlines[id];
+}
+
+const AirportsPerCity_Set &Database::getAirportsPerCity() const {
     return airportsPerCity;
 }
 
-unordered_map<string, AirportPTR> Database::getAirports() {
+const vector<AirportPTR> &Database::getAirports() const {
     return airports;
 }
 
-unordered_map<string, Airline> Database::getAirlines() {
+const vector<Airline> &Database::getAirlines() const {
     return airlines;
 }
 
-int Database::diameter() {
-    return flightMap->diameter();
+const Statistics &Database::getStatistics() const {
+    return statistics;
 }
 
-list<pair<AirportPTR, list<Flight>>> Database::getTrajectories(LocalPTR origin, LocalPTR destination) {
+int Database::diameter(const Deadline &deadline) const {
+    return analytics.get(deadline).diameter;
+}
 
-    unordered_set<string> airlinesCodes;
+void Database::startAnalytics() {
+    analytics.startBackground();
+}
+
+const Analytics::Results &Database::getAnalytics(const Deadline &deadline) const {
+    return analytics.get(deadline);
+}
 
-    for (auto airline: airlines) {
-        airlinesCodes.insert(airline.first);
+AirlineFilter Database::getAirlineFilter() const {
+    return AirlineFilter(airlines.size(), true);
+}
+
+AirlineFilter Database::getAirlineFilter(const unordered_set<string> &airlines) const {
+    AirlineFilter filter(this->airlines.size(), false);
+    for (const string &code: airlines) {
+        int id = airlineIds.get(code);
+        if (id != -1) filter[id] = true;
     }
+    return filter;
+}
+
+/** @brief Returns the ids of the airports of a local.
+ *
+ * @param local Of LocalPTR type.
+ * @param flightMap Of const FlightMap type, by pointer.
+ * @return vector<int>.
+ */
+static vector<int> airportIdsOf(LocalPTR local, const FlightMap *flightMap) {
+    vector<int> ids;
+    for (const AirportPTR &airport: local->getAirports(flightMap))
+        ids.push_back(airport->id);
+    return ids;
+}
+
+list<pair<AirportPTR, list<Flight>>>
+Database::cachedTrajectories(LocalPTR origin, LocalPTR destination, const AirlineFilter &airlines) const {
+    CacheKey key = CacheKey::of(TRAJECTORIES, 0, airportIdsOf(origin, flightMap.get()),
+                                airportIdsOf(destination, flightMap.get()), airlines);
+    shared_ptr<const list<pair<AirportPTR, list<Flight>>>> trajectories = trajectoryCache.find(key);
+    if (trajectories) return *trajectories;
+
+    trajectories = make_shared<const list<pair<AirportPTR, list<Flight>>>>(
+            flightMap->getFlights(origin, destination, airlines, planFlights(airlines)));
+    size_t bytes = 0;
+    for (const auto &trajectory: *trajectories)
+        bytes += sizeof(trajectory) + 2 * sizeof(void *) +
+                 trajectory.second.size() * (sizeof(Flight) + 2 * sizeof(void *));
+    trajectoryCache.insert(key, trajectories, bytes);
+    return *trajectories;
+}
+
+shared_ptr<const Airports_Set> Database::cachedReachable(LocalPTR origin, int y) const {
+    CacheKey key = CacheKey::of(REACHABLE, y, airportIdsOf(origin, flightMap.get()), {}, {});
+    shared_ptr<const Airports_Set> airports = reachableCache.find(key);
+    if (airports) return airports;
+
+    airports = make_shared<const Airports_Set>(flightMap->airportsWithMaxYFlights(origin, y));
+    reachableCache.insert(key, airports, airports->bytes());
+    return airports;
+}
+
+shared_ptr<const AirlineSubgraph> Database::getSubgraph(int airline) const {
+    CacheKey key = CacheKey::of(SUBGRAPH, airline, {}, {}, {});
+    shared_ptr<const AirlineSubgraph> subgraph = subgraphCache.find(key);
+    if (subgraph) return subgraph;
+
+    INSTRUMENT_SCOPE("query/buildSubgraph");
+    subgraph = make_shared<const AirlineSubgraph>(airports, airline);
+    subgraphCache.insert(key, subgraph, subgraph->bytes());
+    return subgraph;
+}
 
-    return flightMap->getFlights(origin, destination, airlinesCodes);
+FlightPlan Database::planFlights(const AirlineFilter &airlines) const {
+    FlightPlan plan;
+    vector<int> allowed;
+    for (int airline = 0; airline < (int) airlines.size(); airline++)
+        if (airlines[airline]) {
+            if ((int) allowed.size() == FlightPlan::MAX_SUBGRAPHS) return plan;
+            allowed.push_back(airline);
+        }
+    if (allowed.size() == this->airlines.size()) return plan;
+
+    plan.useSubgraphs = true;
+    for (int airline: allowed)
+        plan.subgraphs.push_back(getSubgraph(airline));
+    return plan;
+}
+
+list<pair<AirportPTR, list<Flight>>> Database::getTrajectories(LocalPTR origin, LocalPTR destination) const {
+    return cachedTrajectories(origin, destination, getAirlineFilter());
 }
 
 list<pair<AirportPTR, list<Flight>>>
-Database::getTrajectories(LocalPTR origin, LocalPTR destination, unordered_set<string> airlines) {
+Database::getTrajectories(LocalPTR origin, LocalPTR destination, const unordered_set<string> &airlines) const {
+    return cachedTrajectories(origin, destination, getAirlineFilter(airlines));
+}
 
+int Database::getAirlineId(const string &code) const {
+    return airlineIds.get(code);
+}
 
-    return flightMap->getFlights(origin, destination, airlines);
+Constraints Database::getConstraints(const AirlineFilter &airlines) const {
+    return Constraints(airports.size(), airlines);
+}
+
+list<pair<AirportPTR, list<Flight>>>
+Database::getTrajectories(LocalPTR origin, LocalPTR destination, const Constraints &constraints) const {
+    return flightMap->getConstrainedFlights(origin, destination, constraints, planFlights(constraints.getAirlines()));
 }
 
 FlightMapPtr Database::getFlightMapPtr() {
     return flightMap;
 }
 
-unordered_set<AirportPTR> Database::airportsWithMaxYFlights(LocalPTR origin, int y) {
-    return flightMap->airportsWithMaxYFlights(origin, y);
+Airports_Set Database::airportsWithMaxYFlights(LocalPTR origin, int y) const {
+    return *cachedReachable(origin, y);
+}
+
+Cities_Set Database::citiesWithMaxYFlights(LocalPTR origin, int y) const {
+    shared_ptr<const Airports_Set> airports = cachedReachable(origin, y);
+    Cities_Set cities;
+    for (const AirportPTR &airport: *airports)
+        cities.insert(City(airport->city, airport->country));
+    return cities;
+}
+
+FlatSet<int> Database::countriesWithMaxYFlights(LocalPTR origin, int y) const {
+    shared_ptr<const Airports_Set> airports = cachedReachable(origin, y);
+    FlatSet<int> countries;
+    for (const AirportPTR &airport: *airports)
+        countries.insert(airport->country);
+    return countries;
 }
 
-unordered_set<City, City::hashFunction> Database::citiesWithMaxYFlights(LocalPTR origin, int y) {
-    return flightMap->citiesWithMaxYFlights(origin, y);
+list<AirportPTR> Database::getArticulationPoints(const Deadline &deadline) const {
+    list<AirportPTR> articulationPoints;
+    for (int id: analytics.get(deadline).articulationPoints)
+        articulationPoints.push_back(airports[id]);
+    return articulationPoints;
 }
 
-unordered_set<string> Database::countriesWithMaxYFlights(LocalPTR origin, int y) {
-    return flightMap->countriesWithMaxYFlights(origin, y);
+int Database::getConnectedComponents(const Deadline &deadline) const {
+    return analytics.get(deadline).components;
 }
 
-list<AirportPTR> Database::getArticulationPoints() {
-    return flightMap->articulationPoints();
+void Database::setCacheBudget(size_t budget) {
+    trajectoryCache.setBudget(budget / 2);
+    reachableCache.setBudget(budget / 2);
 }
 
-int Database::getConnectedComponents() {
-    return flightMap->connectedComponents();
-}
\ No newline at end of file
+void Database::setOrder(Renumbering::Order order) {
+    this->order = order;
+}
+
+vector<pair<string, CacheStatistics>> Database::getCacheStatistics() const {
+    return {{"trajectories", trajectoryCache.getStatistics()}, {"reachable", reachableCache.getStatistics()},
+            {"subgraphs", subgraphCache.getStatistics()}};
+}
+
+bool Database::hasSchedules() const {
+    return !timetable.empty();
+}
+
+Journey Database::getEarliestArrival(LocalPTR origin, LocalPTR destination, int departure,
+                                     int minimumConnection) const {
+    return timetable.earliestArrival(airportIdsOf(origin, flightMap.get()), airportIdsOf(destination, flightMap.get()),
+                                     departure, minimumConnection);
+}
+
+vector<Journey> Database::getProfile(LocalPTR origin, LocalPTR destination, int minimumConnection,
+                                    const Deadline &deadline) const {
+    return timetable.profile(airportIdsOf(origin, flightMap.get()), airportIdsOf(destination, flightMap.get()),
+                             minimumConnection, deadline);
+}
+
+vector<Journey> Database::getParetoJourneys(LocalPTR origin, LocalPTR destination, int departure,
+                                            const AirlineFilter &airlines, int minimumConnection,
+                                            int maximumLegs, const Deadline &deadline) const {
+    return raptor.paretoJourneys(airportIdsOf(origin, flightMap.get()), airportIdsOf(destination, flightMap.get()),
+                                 departure, airlines, minimumConnection, maximumLegs, deadline);
+}
+
+vector<Journey> Database::getParetoJourneys(LocalPTR origin, LocalPTR destination, int first, int last,
+                                            const AirlineFilter &airlines, int minimumConnection,
+                                            int maximumLegs, const Deadline &deadline) const {
+    return raptor.paretoJourneys(airportIdsOf(origin, flightMap.get()), airportIdsOf(destination, flightMap.get()),
+                                 first, last, airlines, minimumConnection, maximumLegs, deadline);
+}
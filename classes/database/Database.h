@@ -11,32 +11,206 @@
 #include <unordered_map>
 #include <memory>
 #include <unordered_set>
+#include <string>
+#include <vector>
+#include <functional>
+#include <atomic>
+#include <future>
+#include <thread>
 #include "../Graph/FlightMap.h"
 #include "../Graph/Airline/Airline.h"
+#include "../Graph/Code/Code.h"
+#include "../Graph/Timetable/Timetable.h"
+#include "../Graph/Raptor/Raptor.h"
+#include "../Graph/Constraints/Constraints.h"
+#include "../Cache/Cache.h"
+#include "../Graph/Renumbering/Renumbering.h"
+#include "arena/Arena.h"
+#include "statistics/Statistics.h"
+#include "analytics/Analytics.h"
+#include "snapshot/Snapshot.h"
 
 /** @brief database class to read all input files and store all information.
  *
  *  Intended to be instanced once and creates a database
  *  for use within the app.
  *  Holds prototype functions to read the following input files:
- *  "airlines.csv", "airports.csv" and "flights.csv".
+ *  "airlines.csv", "airports.csv" and "flights.csv", and optionally "schedules.csv".
  *  Stores their data accordingly.
  */
 class Database {
 
 private:
 
+    //! @brief Defines the name of the airports input file.
+    static const string AIRPORTS_FILE;
+
+    //! @brief Defines the name of the airlines input file.
+    static const string AIRLINES_FILE;
+
+    //! @brief Defines the name of the flights input file.
+    static const string FLIGHTS_FILE;
+
+    //! @brief Defines the name of the snapshot written after reading the input files.
+    static const string SNAPSHOT_FILE;
+
+    //! @brief Defines the name of the file the analytics are kept in between runs.
+    static const string ANALYTICS_FILE;
+
+    //! @brief Defines the name of the optional schedules input file.
+    static const string SCHEDULES_FILE;
+
+    //! @brief Holds the directory of the input files, ending in a slash.
+    string directory = "../resources/";
+
+    //! @brief Holds the airports and the flights, which are freed all at once with the database.
+    Arena arena;
+
+    //! @brief Holds the snapshot the database was read from, if any, whose flights the airports point into.
+    Snapshot snapshot;
+
     //! @brief Represents the FlightMapPtr.
     FlightMapPtr flightMap{new FlightMap()};
 
+    //! @brief Holds the scheduled departures of the flights, empty if there is no schedules file.
+    Timetable timetable;
+
+    //! @brief Holds the scheduled departures of the flights grouped into routes, empty if there is no schedules file.
+    Raptor raptor;
+
     //! @brief Holds all airports per city.
     AirportsPerCity_Set airportsPerCity;
 
-    //! @brief Holds all airports..
-    unordered_map<string, AirportPTR> airports;
+    //! @brief Holds all airports, indexed by their id.
+    vector<AirportPTR> airports;
+
+    //! @brief Holds the ids of the airports in the order of the airports file.
+    vector<int> inputOrder;
+
+    //! @brief Holds all airlines, indexed by their id.
+    vector<Airline> airlines;
+
+    //! @brief Holds the id of each airport, indexed by its code.
+    CodeTable<int> airportIds{-1};
+
+    //! @brief Holds the id of each airline, indexed by its code.
+    CodeTable<int> airlineIds{-1};
+
+    //! @brief Holds the counts of the airports and countries, computed after reading.
+    Statistics statistics;
+
+    //! @brief Holds the version of the data, different each time the input files are read.
+    unsigned long long version = 0;
+
+    //! @brief Holds the hash of the content of the input files.
+    uint64_t contentHash = 0;
+
+    //! @brief Holds the order the airports are given ids in.
+    Renumbering::Order order = Renumbering::INPUT;
+
+    //! @brief Holds the results of the recent trajectory queries.
+    mutable Cache<list<pair<AirportPTR, list<Flight>>>> trajectoryCache{CACHE_BUDGET / 2};
+
+    //! @brief Holds the airports reachable in the recent reachability queries.
+    mutable Cache<Airports_Set> reachableCache{CACHE_BUDGET / 2};
+
+    //! @brief Holds the flights of the airlines searched for alone or in small groups recently.
+    mutable Cache<AirlineSubgraph> subgraphCache{SUBGRAPH_BUDGET};
+
+    //! @brief Holds the number of bytes of the airports, airlines and flights files parsed so far.
+    mutable atomic<size_t> bytesParsed{0};
+
+    //! @brief Holds the number of bytes of the airports, airlines and flights files.
+    atomic<size_t> bytesTotal{0};
+
+    //! @brief Holds the number of airports, airlines and flights loaded so far.
+    mutable atomic<size_t> rowsLoaded{0};
+
+    //! @brief Holds the thread reading the input files in the background, if any.
+    thread loader;
+
+    //! @brief Holds the results that depend on the whole network. Last, so it stops before the network is freed.
+    mutable Analytics analytics;
+
+    /** @brief Returns the trajectories of a query, from the cache if it was asked before.
+     *
+     * @param origin Of LocalPTR type.
+     * @param destination Of LocalPTR type.
+     * @param airlines Of const AirlineFilter type, by reference.
+     * @return list<pair<AirportPTR, list<flight>>>.
+     */
+    list<pair<AirportPTR, list<Flight>>> cachedTrajectories(LocalPTR origin, LocalPTR destination,
+                                                            const AirlineFilter &airlines) const;
+
+    /** @brief Returns the airports reachable from a local, from the cache if it was asked before.
+     *
+     * @param origin Of LocalPTR type.
+     * @param y Of int type.
+     * @return shared_ptr<const Airports_Set>.
+     */
+    shared_ptr<const Airports_Set> cachedReachable(LocalPTR origin, int y) const;
+
+    /** @brief Returns the subgraph of an airline, building it the first time it is asked for.
+     *
+     * @param airline Of int type, the id of the airline.
+     * @return shared_ptr<const AirlineSubgraph>.
+     */
+    shared_ptr<const AirlineSubgraph> getSubgraph(int airline) const;
+
+    /** @brief Chooses the flights a search with an airline filter looks at.
+     *
+     * A filter that allows at most FlightPlan::MAX_SUBGRAPHS airlines, and not all of them,
+     * is searched over the subgraphs of those airlines; any other over every flight, testing the filter.
+     *
+     * @param airlines Of const AirlineFilter type, by reference.
+     * @return FlightPlan.
+     */
+    FlightPlan planFlights(const AirlineFilter &airlines) const;
+
+    /** @brief flightRecord struct to represent a parsed line of the flights input file.
+     *
+     */
+    struct FlightRecord {
+
+        //! @brief Holds the id of the source airport.
+        int source;
+
+        //! @brief Holds the id of the target airport.
+        int destination;
+
+        //! @brief Holds the id of the airline.
+        int airline;
+    };
+
+    /** @brief Reads the airports, the airlines and the flights, and builds the network and its statistics.
+     *
+     * Reads the snapshot if the input files did not change since it was written.
+     * Otherwise, the airports and airlines files are read concurrently
+     * while the flights file is loaded into memory, and a new snapshot is written.
+     *
+     * @param useSnapshot Of bool type, false to read the input files without reading or writing the snapshot.
+     * @return Void.
+     */
+    void readNetwork(bool useSnapshot);
+
+    /** @brief Reads a whole input file into memory.
+     *
+     * @param path Of string type.
+     * @return string with the file content.
+     */
+    static string readFile(const string &path);
 
-    //! @brief Holds all airlines.
-    unordered_map<string, Airline> airlines;
+    /** @brief Parses a chunk of the flights input file.
+     *
+     * Lines whose airports or airline are unknown are skipped.
+     *
+     * @param begin Of const char* type, first character of the chunk.
+     * @param end Of const char* type, one past the last character of the chunk.
+     * @param records Of vector<FlightRecord> type, by reference, to which the parsed flights are appended.
+     * @param counts Of vector<int> type, by reference, with the number of flights per source airport.
+     * @return Void.
+     */
+    void parseFlights(const char *begin, const char *end, vector<FlightRecord> &records, vector<int> &counts) const;
 
     /** @brief Reads airlines input file and stores them accordingly.
      *
@@ -53,7 +227,7 @@ private:
      *  it reads an airport code and name, a name of the city and country that belongs to
      *  and its latitude and longitude.
      *  If the airport (name of the city, name of the country) corresponds to a new airport,
-     *  it creates a new airport object and adds it to the unordered_map of airports.
+     *  it creates a new airport object and adds it to the airports, under the next id.
      *
      *  @return Void.
      */
@@ -61,63 +235,194 @@ private:
 
     /** @brief Reads flights input file and stores them accordingly.
      *
-     *  Reads the file "flights.csv" and for each line
-     *  it reads its source, target and airline.
+     *  Splits the content of the file "flights.csv" at line boundaries and parses
+     *  each chunk on its own thread, reading the source, target and airline of each line.
+     *  The parsed flights are then grouped by source airport with a counting sort,
+     *  so the flights of each airport keep the order of the input file.
+     *  Needs the airports and the airlines to be read first.
      *
+     *  @param content Of const string type, by reference, with the content of the file.
      *  @return Void.
      */
-    void readFlights();
+    void readFlights(const string &content);
+
+    /** @brief Reads the snapshot of the input files, if it is up to date.
+     *
+     *  The snapshot is mapped into memory and stays mapped: the flights of every airport are spans of its flight
+     *  array, and its string pool table is interned once per distinct string, so the airports and the cities
+     *  are made from ids with no string work of their own.
+     *  If the input files were touched without changing, the snapshot is written again.
+     *
+     *  @return True if the snapshot was read.
+     */
+    bool readSnapshot();
+
+    /** @brief Writes a snapshot of the read input files.
+     *
+     *  @return Void.
+     */
+    void writeSnapshot();
+
+    /** @brief Reads the schedules input file, if there is one, and stores them in the timetable.
+     *
+     *  Reads the file "schedules.csv" and for each line
+     *  it reads the source, target and airline of a flight and the times it departs and arrives, as "HH:MM".
+     *  A flight that arrives at or before the time it departs arrives on the next day.
+     *  Lines whose airports, airline or times are unknown are skipped.
+     *  Needs the airports and the airlines to be read first.
+     *
+     *  @return Void.
+     */
+    void readSchedules();
+
+    /** @brief Gives the airports new ids in the order of the database.
+     *
+     * The airports are copied, in their new order, to new objects in the arena, with their flights after them,
+     * so that the airports and flights close in the order are close in memory too.
+     * The ids in the flights, the codes, the city index and the input order are changed to the new ids.
+     * Must be called before the schedules are read and the network is given to the flight map.
+     *
+     *  @return Void.
+     */
+    void renumber();
 
 public:
 
+    //! @brief Defines the number of bytes the cached query results may take by default.
+    static const size_t CACHE_BUDGET = 64 << 20;
+
+    //! @brief Defines the number of bytes the subgraphs of single airlines may take.
+    static const size_t SUBGRAPH_BUDGET = 16 << 20;
+
     /** @brief Does nothing.
      *
      */
     Database();
 
+    /** @brief Sets the directory the input files are read from, "../resources" by default.
+     *
+     * @param directory Of const string type, by reference.
+     * @return Void.
+     */
+    void setDirectory(const string &directory);
+
+    /** @brief Waits for the input files to be read in the background, if they were.
+     *
+     */
+    ~Database();
+
+    /** @brief loadProgress struct to represent how much of the network was read.
+     *
+     */
+    struct LoadProgress {
+
+        //! @brief Holds the number of bytes of the airports, airlines and flights files parsed so far.
+        size_t bytesParsed;
+
+        //! @brief Holds the number of bytes of the airports, airlines and flights files.
+        size_t bytesTotal;
+
+        //! @brief Holds the number of airports, airlines and flights loaded so far.
+        size_t rows;
+    };
+
     /** @brief Stores all the information of the database.
      *
+     * Reads the network, see readNetwork, and then the schedules.
+     *
+     * @param useSnapshot Of bool type, false to read the input files without reading or writing the snapshot.
      * @return Void.
      */
-    void read();
+    void read(bool useSnapshot = true);
+
+    /** @brief Stores all the information of the database in a background thread.
+     *
+     * The future is ready as soon as the network and its statistics are.
+     * The thread then goes on with the rest, from the most to the least needed:
+     * the schedules, and then the analytics, which start on a thread of their own.
+     * Nothing may be read from the database until the future is ready.
+     *
+     * @return shared_future<void>, holding the exception if the network could not be read.
+     */
+    shared_future<void> readAsync();
+
+    /** @brief Returns how much of the network was read so far.
+     *
+     * @return LoadProgress.
+     */
+    LoadProgress getLoadProgress() const;
 
     /** @brief Returns the code of an specific airport.
     *
     * @param code of string type.
-    * @return  airport of AirportPTR type.
+    * @return  airport of AirportPTR type, null if there is no such airport.
     */
-    AirportPTR getAirport(string code);
+    AirportPTR getAirport(const string &code) const;
+
+    /** @brief Returns the airport with the given id.
+    *
+    * @param id of int type.
+    * @return  read-only reference to the airport.
+    */
+    const AirportPTR &getAirport(int id) const;
 
     /** @brief Returns the code of an specific airline.
     *
-    * @param code of string type.
-    * @return  airline of airline type.
+    * @param code of const string type, by reference.
+    * @return  read-only reference to the airline, empty if there is no such airline.
     */
-    Airline getAirline(string code);
+    const Airline &getAirline(const string &code) const;
+
+    /** @brief Returns the airline with the given id.
+    *
+    * @param id of int type.
+    * @return  read-only reference to the airline.
+    */
+    const Airline &getAirline(int id) const;
 
     /** @brief Returns group of airport divided by cities.
     *
-    * @return  AirportsPerCity_Set.
+    * @return  read-only reference to the AirportsPerCity_Set.
     */
-    AirportsPerCity_Set getAirportsPerCity();
+    const AirportsPerCity_Set &getAirportsPerCity() const;
 
     /** @brief Returns all airports.
      *
-     * @return unordered_map<string, AirportPTR> with airports.
+     * @return read-only reference to the vector<AirportPTR> with airports, indexed by id.
      */
-    unordered_map<string, AirportPTR> getAirports();
+    const vector<AirportPTR> &getAirports() const;
 
     /** @brief Returns all airlines.
      *
-     * @return unordered_map<string, airline> with airlines.
+     * @return read-only reference to the vector<airline> with airlines, indexed by id.
+     */
+    const vector<Airline> &getAirlines() const;
+
+    /** @brief Returns the counts of the airports and countries.
+     *
+     * @return read-only reference to the Statistics.
      */
-    unordered_map<string, Airline> getAirlines();
+    const Statistics &getStatistics() const;
 
-    /** @brief Invoke diameter from FlightMap class.
+    /** @brief Returns the diameter of the network, from the analytics.
      *
+     * @param deadline Of const Deadline type, by reference, none by default.
      * @return int.
      */
-    int diameter();
+    int diameter(const Deadline &deadline = Deadline()) const;
+
+    /** @brief Starts computing the analytics in the background, unless they were kept from an earlier run.
+     *
+     * @return Void.
+     */
+    void startAnalytics();
+
+    /** @brief Returns the results that depend on the whole network, reading or computing them the first time.
+     *
+     * @param deadline Of const Deadline type, by reference, none by default.
+     * @return read-only reference to the Analytics::Results.
+     */
+    const Analytics::Results &getAnalytics(const Deadline &deadline = Deadline()) const;
 
     /** @brief Returns a list of list of flights to showcase possible trajectories
      * by origin and destination, for all airlines.
@@ -126,31 +431,31 @@ public:
      * @param destination Of LocalPTR type.
      * @return list<list<flight>> with the trajectories by origin and destination.
      */
-    list<pair<AirportPTR, list<Flight>>> getTrajectories(LocalPTR origin, LocalPTR destination);
+    list<pair<AirportPTR, list<Flight>>> getTrajectories(LocalPTR origin, LocalPTR destination) const;
 
     /** @brief Invokes getTrajectoriesAllAirlines from FlightMap class.
      *
      * @param origin Of LocalPTR type.
      * @param destination Of int type.
-     * @return set of reachable airports, of type unordered_set<AirportPTR>.
+     * @return set of reachable airports, of type Airports_Set.
      */
-    unordered_set<AirportPTR> airportsWithMaxYFlights(LocalPTR origin, int y);
+    Airports_Set airportsWithMaxYFlights(LocalPTR origin, int y) const;
 
     /** @brief Invokes getTrajectoriesAllAirlines from FlightMap class.
      *
      * @param origin Of LocalPTR type.
      * @param destination Of int type.
-     * @return set of reachable cities, of type unordered_set<city, city::hashFunction>.
+     * @return set of reachable cities, of type Cities_Set.
      */
-    unordered_set<City, City::hashFunction> citiesWithMaxYFlights(LocalPTR origin, int y);
+    Cities_Set citiesWithMaxYFlights(LocalPTR origin, int y) const;
 
     /** @brief Invokes getTrajectoriesAllAirlines from FlightMap class.
      *
      * @param origin Of LocalPTR type.
      * @param destination Of int type.
-     * @return set of reachable countries, of type unordered_set<string>.
+     * @return set of ids of the reachable countries in the global string pool, of type FlatSet<int>.
      */
-    unordered_set<string> countriesWithMaxYFlights(LocalPTR origin, int y);
+    FlatSet<int> countriesWithMaxYFlights(LocalPTR origin, int y) const;
 
     /** @brief Returns the flight map pointer to use outside database class.
      *
@@ -158,28 +463,153 @@ public:
      */
     FlightMapPtr getFlightMapPtr();
 
-    /** @brief Returns a list of articulation points.
+    /** @brief Returns a list of articulation points, from the analytics.
      *
+     * @param deadline Of const Deadline type, by reference, none by default.
      * @return list<AirportPTR> of airports.
      */
-    list<AirportPTR> getArticulationPoints();
+    list<AirportPTR> getArticulationPoints(const Deadline &deadline = Deadline()) const;
 
-    /** @brief Returns the number of connected components.
+    /** @brief Returns the number of connected components, from the analytics.
      *
+     * @param deadline Of const Deadline type, by reference, none by default.
      * @return int number.
      */
-    int getConnectedComponents();
+    int getConnectedComponents(const Deadline &deadline = Deadline()) const;
 
     /** @brief Returns a list of trajectories.
      *
      * @param origin Of LocalPTR type.
      * @param destination Of LocalPTR type.
-     * @param airlines Of unordered_set<string> type.
+     * @param airlines Of const unordered_set<string> type, by reference.
      * @return list<pair<AirportPTR, list<flight>>>.
      */
     list<pair<AirportPTR, list<Flight>>>getTrajectories(LocalPTR origin,
                                                         LocalPTR destination,
-                                                        unordered_set<string> airlines);
+                                                        const unordered_set<string> &airlines) const;
+
+    /** @brief Returns the id of the airline with the given code.
+     *
+     * @param code Of const string type, by reference.
+     * @return int, -1 if there is no such airline.
+     */
+    int getAirlineId(const string &code) const;
+
+    /** @brief Returns constraints that allow every airport and the given airlines, to be narrowed down.
+     *
+     * @param airlines Of const AirlineFilter type, by reference.
+     * @return Constraints.
+     */
+    Constraints getConstraints(const AirlineFilter &airlines) const;
+
+    /** @brief Returns the trajectories with the fewest flights that respect some constraints.
+     *
+     * @param origin Of LocalPTR type.
+     * @param destination Of LocalPTR type.
+     * @param constraints Of const Constraints type, by reference.
+     * @return list<pair<AirportPTR, list<flight>>>.
+     */
+    list<pair<AirportPTR, list<Flight>>> getTrajectories(LocalPTR origin, LocalPTR destination,
+                                                         const Constraints &constraints) const;
+
+    /** @brief Sets the number of bytes the cached query results may take, 0 to cache none.
+     *
+     * @param budget Of size_t type.
+     * @return Void.
+     */
+    void setCacheBudget(size_t budget);
+
+    /** @brief Sets the order the airports are given ids in the next time the input files are read.
+     *
+     * @param order Of Renumbering::Order type.
+     * @return Void.
+     */
+    void setOrder(Renumbering::Order order);
+
+    /** @brief Returns the use of the query caches and of the airline subgraphs.
+     *
+     * @return vector<pair<string, CacheStatistics>>, the name of each cache and its use.
+     */
+    vector<pair<string, CacheStatistics>> getCacheStatistics() const;
+
+    /** @brief Returns true if a schedules file was read.
+     *
+     * @return bool.
+     */
+    bool hasSchedules() const;
+
+    /** @brief Returns the scheduled journey that arrives first, leaving at or after a time.
+     *
+     * @param origin Of LocalPTR type.
+     * @param destination Of LocalPTR type.
+     * @param departure Of int type, in minutes since midnight.
+     * @param minimumConnection Of int type, in minutes between two flights.
+     * @return Journey, empty if there is none.
+     */
+    Journey getEarliestArrival(LocalPTR origin, LocalPTR destination, int departure,
+                               int minimumConnection = Timetable::MINIMUM_CONNECTION) const;
+
+    /** @brief Returns the scheduled journeys across a day that no other one leaves later and arrives earlier than.
+     *
+     * @param origin Of LocalPTR type.
+     * @param destination Of LocalPTR type.
+     * @param minimumConnection Of int type, in minutes between two flights.
+     * @param deadline Of const Deadline type, by reference, none by default.
+     * @return vector<Journey>, sorted by departure.
+     */
+    vector<Journey> getProfile(LocalPTR origin, LocalPTR destination,
+                               int minimumConnection = Timetable::MINIMUM_CONNECTION,
+                               const Deadline &deadline = Deadline()) const;
+
+    /** @brief Returns a filter that allows every airline.
+     *
+     * @return AirlineFilter.
+     */
+    AirlineFilter getAirlineFilter() const;
+
+    /** @brief Returns a filter that allows only the given airlines.
+     *
+     * @param airlines Of const unordered_set<string> type, by reference, the codes of the airlines.
+     * @return AirlineFilter.
+     */
+    AirlineFilter getAirlineFilter(const unordered_set<string> &airlines) const;
+
+    /** @brief Returns the scheduled journeys leaving at or after a time that no other one both arrives earlier
+     * than and takes fewer flights than.
+     *
+     * @param origin Of LocalPTR type.
+     * @param destination Of LocalPTR type.
+     * @param departure Of int type, in minutes since midnight.
+     * @param airlines Of const AirlineFilter type, by reference.
+     * @param minimumConnection Of int type, in minutes between two flights.
+     * @param maximumLegs Of int type.
+     * @param deadline Of const Deadline type, by reference, none by default.
+     * @return vector<Journey>, by increasing number of flights.
+     */
+    vector<Journey> getParetoJourneys(LocalPTR origin, LocalPTR destination, int departure,
+                                      const AirlineFilter &airlines,
+                                      int minimumConnection = Timetable::MINIMUM_CONNECTION,
+                                      int maximumLegs = Raptor::MAXIMUM_LEGS,
+                                      const Deadline &deadline = Deadline()) const;
+
+    /** @brief Returns the scheduled journeys leaving in a range of times that no other one leaves later than,
+     * arrives earlier than and takes fewer flights than.
+     *
+     * @param origin Of LocalPTR type.
+     * @param destination Of LocalPTR type.
+     * @param first Of int type, the earliest departure, in minutes since midnight.
+     * @param last Of int type, one past the latest departure.
+     * @param airlines Of const AirlineFilter type, by reference.
+     * @param minimumConnection Of int type, in minutes between two flights.
+     * @param maximumLegs Of int type.
+     * @param deadline Of const Deadline type, by reference, none by default.
+     * @return vector<Journey>, by departure and then number of flights.
+     */
+    vector<Journey> getParetoJourneys(LocalPTR origin, LocalPTR destination, int first, int last,
+                                      const AirlineFilter &airlines,
+                                      int minimumConnection = Timetable::MINIMUM_CONNECTION,
+                                      int maximumLegs = Raptor::MAXIMUM_LEGS,
+                                      const Deadline &deadline = Deadline()) const;
 };
 
 #endif //AED_FEUP_PROJ_22_23_DATABASE_H
@@ -0,0 +1,251 @@
+/** @file Analytics.cpp
+ *  @brief Contains the Analytics Class implementation.
+ *  @author -
+ *  @bug No known bugs.
+ */
+
+#include "Analytics.h"
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include "../snapshot/Snapshot.h"
+#include "../../Scheduler/Scheduler.h"
+#include "../../Instrumentation/Instrumentation.h"
+
+const uint32_t Analytics::VERSION;
+
+//! @brief Identifies an analytics file.
+static const char MAGIC[8] = {'F', 'L', 'T', 'M', 'A', 'P', 'A', 'N'};
+
+/** @brief Appends the bytes of an array to a buffer.
+ *
+ * @param buffer Of string type, by reference.
+ * @param values Of const vector<T> type, by reference.
+ * @return Void.
+ */
+template<typename T>
+static void append(string &buffer, const vector<T> &values) {
+    buffer.append(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(T));
+}
+
+/** @brief Reads an array from a buffer, moving past it.
+ *
+ * @param data Of const char* type, by reference.
+ * @param values Of vector<T> type, by reference, already sized.
+ * @return Void.
+ */
+template<typename T>
+static void extract(const char *&data, vector<T> &values) {
+    memcpy(values.data(), data, values.size() * sizeof(T));
+    data += values.size() * sizeof(T);
+}
+
+Analytics::Analytics() = default;
+
+Analytics::~Analytics() {
+    cancelled = true;
+    if (background.joinable()) background.join();
+}
+
+void Analytics::open(const string &path, uint64_t contentHash, const FlightMap *flightMap) {
+    lock_guard<timed_mutex> guard(lock);
+    this->path = path;
+    this->contentHash = contentHash;
+    this->flightMap = flightMap;
+    ready = false;
+
+    Header header{};
+    ifstream input(path, ios::binary);
+    stored = input.read(reinterpret_cast<char *>(&header), sizeof(Header)) &&
+             memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0 && header.version == VERSION &&
+             header.contentHash == contentHash && header.numAirports == flightMap->getAirports().size();
+}
+
+void Analytics::startBackground() {
+    if (stored || background.joinable()) return;
+    background = thread([this]() {
+        lock_guard<timed_mutex> guard(lock);
+        if (!ready) prepare(Deadline());
+    });
+}
+
+const Analytics::Results &Analytics::get(const Deadline &deadline) {
+    unique_lock<timed_mutex> guard(lock, defer_lock);
+    if (!deadline.isSet()) guard.lock();
+    else if (!guard.try_lock_until(deadline.getTime())) throw DeadlineExceeded();
+    if (!ready) prepare(deadline);
+    if (!ready) throw DeadlineExceeded();
+    return results;
+}
+
+void Analytics::prepare(const Deadline &deadline) {
+    if (stored && load()) {
+        ready = true;
+        return;
+    }
+    if (!compute(deadline)) return;
+    ready = true;
+    stored = save();
+}
+
+bool Analytics::load() {
+    INSTRUMENT_SCOPE("analytics/load");
+    ifstream input(path, ios::binary);
+    string content((istreambuf_iterator<char>(input)), istreambuf_iterator<char>());
+    if (content.size() < sizeof(Header)) return false;
+
+    Header header;
+    memcpy(&header, content.data(), sizeof(Header));
+    size_t numAirports = header.numAirports;
+    size_t size = sizeof(Header) + header.numArticulationPoints * sizeof(int32_t) +
+                  numAirports * (sizeof(int32_t) + sizeof(double)) + header.numHops * sizeof(uint64_t);
+    if (content.size() != size || numAirports != flightMap->getAirports().size() ||
+        Snapshot::hash(content.data() + sizeof(Header), size - sizeof(Header)) != header.checksum)
+        return false;
+
+    results.diameter = header.diameter;
+    results.components = header.components;
+    results.articulationPoints.resize(header.numArticulationPoints);
+    results.eccentricities.resize(numAirports);
+    results.betweenness.resize(numAirports);
+    results.hops.resize(header.numHops);
+
+    const char *data = content.data() + sizeof(Header);
+    extract(data, results.articulationPoints);
+    extract(data, results.eccentricities);
+    extract(data, results.betweenness);
+    extract(data, results.hops);
+    return true;
+}
+
+bool Analytics::save() const {
+    INSTRUMENT_SCOPE("analytics/save");
+    Header header{};
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.numAirports = results.eccentricities.size();
+    header.contentHash = contentHash;
+    header.diameter = results.diameter;
+    header.components = results.components;
+    header.numArticulationPoints = results.articulationPoints.size();
+    header.numHops = results.hops.size();
+
+    string body;
+    append(body, results.articulationPoints);
+    append(body, results.eccentricities);
+    append(body, results.betweenness);
+    append(body, results.hops);
+    header.checksum = Snapshot::hash(body.data(), body.size());
+
+    string temporaryPath = path + ".tmp";
+    {
+        ofstream output(temporaryPath, ios::binary | ios::trunc);
+        if (!output.write(reinterpret_cast<const char *>(&header), sizeof(Header)) ||
+            !output.write(body.data(), body.size()))
+            return false;
+    }
+    remove(path.c_str());
+    return rename(temporaryPath.c_str(), path.c_str()) == 0;
+}
+
+bool Analytics::compute(const Deadline &deadline) {
+    INSTRUMENT_SCOPE("analytics/compute");
+    const vector<AirportPTR> &airports = flightMap->getAirports();
+    int numAirports = airports.size();
+
+    // Several airlines flying the same route are one edge: the paths are counted between airports.
+    const RouteGraph &routeGraph = flightMap->getRouteGraph();
+    vector<int> firstNeighbour(numAirports + 1, 0), neighbours;
+    neighbours.reserve(routeGraph.getNumRoutes());
+    for (int airport = 0; airport < numAirports; airport++) {
+        size_t first = neighbours.size();
+        for (const Route &route: routeGraph.getRoutes(airport))
+            neighbours.push_back(route.destination);
+        sort(neighbours.begin() + first, neighbours.end());
+        firstNeighbour[airport + 1] = neighbours.size();
+    }
+
+    Results computed;
+    computed.eccentricities.assign(numAirports, 0);
+    computed.betweenness.assign(numAirports, 0);
+
+    atomic<int> nextSource{0}, searched{0};
+    mutex merge;
+    auto search = [&]() {
+        vector<int> dist(numAirports, -1), order;
+        vector<double> paths(numAirports, 0), dependency(numAirports, 0), betweenness(numAirports, 0);
+        vector<uint64_t> hops;
+        order.reserve(numAirports);
+
+        for (int source = nextSource++; source < numAirports && !cancelled && !deadline.passed();
+             source = nextSource++) {
+            order.clear();
+            order.push_back(source);
+            dist[source] = 0;
+            paths[source] = 1;
+            for (size_t next = 0; next < order.size(); next++) {
+                int airport = order[next];
+                for (int index = firstNeighbour[airport]; index < firstNeighbour[airport + 1]; index++) {
+                    int neighbour = neighbours[index];
+                    if (dist[neighbour] == -1) {
+                        dist[neighbour] = dist[airport] + 1;
+                        order.push_back(neighbour);
+                    }
+                    if (dist[neighbour] == dist[airport] + 1) paths[neighbour] += paths[airport];
+                }
+            }
+
+            int eccentricity = dist[order.back()];
+            computed.eccentricities[source] = eccentricity;
+            if ((int) hops.size() <= eccentricity) hops.resize(eccentricity + 1, 0);
+            for (int airport: order) hops[dist[airport]]++;
+
+            for (size_t back = order.size(); back-- > 1;) {
+                int airport = order[back];
+                for (int index = firstNeighbour[airport]; index < firstNeighbour[airport + 1]; index++) {
+                    int neighbour = neighbours[index];
+                    if (dist[neighbour] == dist[airport] + 1)
+                        dependency[airport] += paths[airport] / paths[neighbour] * (1 + dependency[neighbour]);
+                }
+                betweenness[airport] += dependency[airport];
+            }
+
+            for (int airport: order) {
+                dist[airport] = -1;
+                paths[airport] = dependency[airport] = 0;
+            }
+            searched++;
+        }
+
+        lock_guard<mutex> guard(merge);
+        for (int airport = 0; airport < numAirports; airport++)
+            computed.betweenness[airport] += betweenness[airport];
+        if (computed.hops.size() < hops.size()) computed.hops.resize(hops.size(), 0);
+        for (size_t distance = 0; distance < hops.size(); distance++)
+            computed.hops[distance] += hops[distance];
+    };
+
+    vector<thread> threads;
+    for (unsigned i = 1; i < Scheduler::global().getThreads(); i++)
+        threads.emplace_back(search);
+    search();
+    for (thread &worker: threads)
+        worker.join();
+    if (searched < numAirports) return false;
+
+    // The pairs of an airport with itself are not pairs.
+    if (!computed.hops.empty()) computed.hops[0] = 0;
+
+    int diameter = computed.eccentricities.empty() ? 0 :
+                   *max_element(computed.eccentricities.begin(), computed.eccentricities.end());
+    computed.diameter = diameter > 0 ? diameter : INT_MIN;
+    computed.components = flightMap->connectedComponents();
+    for (const AirportPTR &airport: flightMap->articulationPoints())
+        computed.articulationPoints.push_back(airport->id);
+
+    results = move(computed);
+    return true;
+}
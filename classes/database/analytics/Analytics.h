@@ -0,0 +1,182 @@
+/** @file Analytics.h
+ *  @brief Contains the Analytics class declaration.
+ *  @author -
+ *  @bug No known bugs.
+ */
+
+#ifndef AED_FEUP_PROJ_2_22_23_ANALYTICS_H
+#define AED_FEUP_PROJ_2_22_23_ANALYTICS_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../../Graph/FlightMap.h"
+#include "../../Deadline/Deadline.h"
+
+using namespace std;
+
+/** @brief Analytics class to represent the results that depend on the whole network, kept on disk between runs.
+ *
+ *  The diameter, the articulation points and the number of connected components are computed once,
+ *  along with the eccentricity and betweenness centrality of every airport
+ *  and how many pairs of airports are each number of flights apart.
+ *  They are written to a file keyed by the hash of the input files, and read back while the files do not change.
+ *  Opening only reads the header of the file: the results are read, or computed, the first time they are needed,
+ *  or ahead of time in a background thread.
+ *  The searches from every airport run on threads of their own rather than on the scheduler,
+ *  so a query task waiting for the results never has to run while they are being computed.
+ */
+class Analytics {
+
+public:
+
+    //! @brief Defines the version of the file format, to be increased on every layout change.
+    static const uint32_t VERSION = 1;
+
+    /** @brief results struct to represent the analytics of a network.
+     *
+     */
+    struct Results {
+
+        //! @brief Holds the maximum number of flights between two airports, INT_MIN if there are no flights.
+        int diameter = 0;
+
+        //! @brief Holds the number of connected components.
+        int components = 0;
+
+        //! @brief Holds the ids of the articulation points, in the order they were found.
+        vector<int> articulationPoints;
+
+        //! @brief Holds the most flights from each airport to another it can reach, indexed by id.
+        vector<int> eccentricities;
+
+        //! @brief Holds the number of shortest paths between other airports through each airport, indexed by id.
+        vector<double> betweenness;
+
+        //! @brief Holds the number of ordered pairs of airports each number of flights apart, indexed by it.
+        vector<uint64_t> hops;
+    };
+
+private:
+
+    //! @brief Layout of the beginning of the file.
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t numAirports;
+        uint64_t contentHash;
+        uint64_t checksum;
+        int32_t diameter;
+        int32_t components;
+        uint32_t numArticulationPoints;
+        uint32_t numHops;
+    };
+
+    //! @brief Holds the path of the file.
+    string path;
+
+    //! @brief Holds the hash of the input files the results must belong to.
+    uint64_t contentHash = 0;
+
+    //! @brief Holds the flight map the results are computed from.
+    const FlightMap *flightMap = nullptr;
+
+    //! @brief Holds true if the file holds results for the input files.
+    bool stored = false;
+
+    //! @brief Holds true once the results were read or computed.
+    bool ready = false;
+
+    //! @brief Holds the results.
+    Results results;
+
+    //! @brief Holds the lock taken while the results are read or computed, timed so a query can stop waiting.
+    timed_mutex lock;
+
+    //! @brief Holds the thread computing the results in the background, if any.
+    thread background;
+
+    //! @brief Holds true when the results are no longer wanted, to stop computing them.
+    atomic<bool> cancelled{false};
+
+    /** @brief Reads the results from the file.
+     *
+     * @return True if the file was complete and unchanged.
+     */
+    bool load();
+
+    /** @brief Writes the results to the file.
+     *
+     * The file is written to a temporary path first and then renamed.
+     *
+     * @return True if the file was written.
+     */
+    bool save() const;
+
+    /** @brief Computes the results.
+     *
+     * The eccentricities, the betweenness and the hops come from a search from every airport,
+     * accumulating the dependencies of Brandes' algorithm on the way back.
+     * Temporal Complexity: O(|A|(|A| + |F|)), A represents the number of airports and F the number of flights.
+     *
+     * @param deadline Of const Deadline type, by reference, checked before each search.
+     * @return True if the results were computed, false if cancelled or the deadline passed.
+     */
+    bool compute(const Deadline &deadline);
+
+    /** @brief Reads the results from the file or, if they are not there, computes and writes them.
+     *
+     * @param deadline Of const Deadline type, by reference, after which the computing stops.
+     * @return Void.
+     */
+    void prepare(const Deadline &deadline);
+
+public:
+
+    /** Create a new Analytics with no file.
+     *
+     * Does nothing.
+     */
+    Analytics();
+
+    Analytics(const Analytics &) = delete;
+
+    Analytics &operator=(const Analytics &) = delete;
+
+    /** Stops computing the results in the background, if it was, and waits for it.
+     *
+     */
+    ~Analytics();
+
+    /** @brief Sets the file and the network of the results, and checks if the file holds them.
+     *
+     * Only reads the header of the file.
+     *
+     * @param path Of const string type, by reference.
+     * @param contentHash Of uint64_t type, the hash of the input files.
+     * @param flightMap Of const FlightMap type, by pointer.
+     * @return Void.
+     */
+    void open(const string &path, uint64_t contentHash, const FlightMap *flightMap);
+
+    /** @brief Starts computing the results in a background thread, if the file does not hold them.
+     *
+     * @return Void.
+     */
+    void startBackground();
+
+    /** @brief Returns the results, reading or computing them the first time, or waiting for the background thread.
+     *
+     * Computing them for a caller with a deadline stops once it passes, leaving them to the next caller.
+     *
+     * @param deadline Of const Deadline type, by reference, none by default.
+     * @return read-only reference to the Results.
+     * @throws DeadlineExceeded if the deadline passed before the results were ready.
+     */
+    const Results &get(const Deadline &deadline = Deadline());
+};
+
+#endif //AED_FEUP_PROJ_2_22_23_ANALYTICS_H
@@ -0,0 +1,53 @@
+/** @file Arena.cpp
+ *  @brief Contains the Arena Class implementation.
+ *  @author -
+ *  @bug No known bugs.
+ */
+
+#include "Arena.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+
+const size_t Arena::BLOCK_SIZE;
+
+Arena::Arena() = default;
+
+Arena::~Arena() {
+    for (auto it = destructors.rbegin(); it != destructors.rend(); it++)
+        it->second(it->first);
+    for (char *block: blocks)
+        free(block);
+}
+
+void Arena::grow(size_t size) {
+    size = max(size, BLOCK_SIZE);
+    char *block = static_cast<char *>(malloc(size));
+    if (!block) throw bad_alloc();
+
+    blocks.push_back(block);
+    capacity += size;
+    current = block;
+    limit = block + size;
+}
+
+void Arena::reserve(size_t size) {
+    if ((size_t) (limit - current) < size)
+        grow(size);
+}
+
+void *Arena::allocate(size_t size, size_t alignment) {
+    uintptr_t address = (reinterpret_cast<uintptr_t>(current) + alignment - 1) & ~(uintptr_t) (alignment - 1);
+
+    if (!current || address + size > reinterpret_cast<uintptr_t>(limit)) {
+        grow(size + alignment);
+        address = (reinterpret_cast<uintptr_t>(current) + alignment - 1) & ~(uintptr_t) (alignment - 1);
+    }
+
+    current = reinterpret_cast<char *>(address + size);
+    return reinterpret_cast<void *>(address);
+}
+
+size_t Arena::getCapacity() const {
+    return capacity;
+}
@@ -0,0 +1,119 @@
+/** @file Arena.h
+ *  @brief Contains the Arena class declaration.
+ *  @author -
+ *  @bug No known bugs.
+ */
+
+#ifndef AED_FEUP_PROJ_2_22_23_ARENA_H
+#define AED_FEUP_PROJ_2_22_23_ARENA_H
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+/** @brief Arena class to represent a monotonic memory pool.
+ *
+ *  Objects are carved one after the other from large blocks and are never freed on their own:
+ *  every block is released at once when the arena is destroyed.
+ *  Objects that are not trivially destructible have their destructors run at that moment.
+ *  Not thread safe.
+ */
+class Arena {
+
+private:
+
+    //! @brief Defines the minimum size of a block in bytes.
+    static const size_t BLOCK_SIZE = 1 << 16;
+
+    //! @brief Holds all allocated blocks.
+    vector<char *> blocks;
+
+    //! @brief Holds the next free byte of the current block.
+    char *current = nullptr;
+
+    //! @brief Holds one past the last byte of the current block.
+    char *limit = nullptr;
+
+    //! @brief Holds the number of bytes taken from the system.
+    size_t capacity = 0;
+
+    //! @brief Holds the objects that need their destructor to be run, and that destructor.
+    vector<pair<void *, void (*)(void *)>> destructors;
+
+    /** @brief Allocates a new block of at least the given size.
+     *
+     * @param size Of size_t type.
+     * @return Void.
+     */
+    void grow(size_t size);
+
+public:
+
+    /** Create a new Arena.
+     *
+     * Does nothing.
+     */
+    Arena();
+
+    //! @brief Runs the registered destructors and frees every block.
+    ~Arena();
+
+    Arena(const Arena &) = delete;
+
+    Arena &operator=(const Arena &) = delete;
+
+    /** @brief Makes sure that the given number of bytes can be allocated without another block.
+     *
+     * Reserving the whole size up front keeps the arena in a single block.
+     *
+     * @param size Of size_t type.
+     * @return Void.
+     */
+    void reserve(size_t size);
+
+    /** @brief Allocates uninitialised memory.
+     *
+     * Temporal Complexity: O(1).
+     *
+     * @param size Of size_t type.
+     * @param alignment Of size_t type, a power of two.
+     * @return void* to the allocated memory.
+     */
+    void *allocate(size_t size, size_t alignment);
+
+    /** @brief Constructs an object in the arena.
+     *
+     * @param arguments Forwarded to the constructor of T.
+     * @return T* to the new object, owned by the arena.
+     */
+    template<typename T, typename... Args>
+    T *create(Args &&... arguments) {
+        T *object = new(allocate(sizeof(T), alignof(T))) T(forward<Args>(arguments)...);
+        if (!is_trivially_destructible<T>::value)
+            destructors.emplace_back(object, [](void *pointer) { static_cast<T *>(pointer)->~T(); });
+        return object;
+    }
+
+    /** @brief Allocates an array of trivial objects in the arena.
+     *
+     * @param size Of size_t type, number of elements.
+     * @return T* to the first element, left uninitialised.
+     */
+    template<typename T>
+    T *createArray(size_t size) {
+        static_assert(is_trivially_destructible<T>::value, "Arrays in the arena must be trivial");
+        return static_cast<T *>(allocate(sizeof(T) * size, alignof(T)));
+    }
+
+    /** @brief Returns the number of bytes taken from the system.
+     *
+     * @return size_t.
+     */
+    size_t getCapacity() const;
+};
+
+#endif //AED_FEUP_PROJ_2_22_23_ARENA_H
@@ -0,0 +1,71 @@
+/** @file MappedFile.cpp
+ *  @brief Contains the MappedFile Class implementation.
+ *  @author -
+ *  @bug No known bugs.
+ */
+
+#include "MappedFile.h"
+#include <fstream>
+#include <iterator>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+MappedFile::MappedFile() = default;
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+bool MappedFile::open(const string &path) {
+    close();
+
+#ifndef _WIN32
+    int descriptor = ::open(path.c_str(), O_RDONLY);
+    if (descriptor < 0) return false;
+
+    struct stat status;
+    if (fstat(descriptor, &status) != 0 || status.st_size == 0) {
+        ::close(descriptor);
+        return false;
+    }
+
+    void *mapping = mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    ::close(descriptor);
+    if (mapping == MAP_FAILED) return false;
+
+    data = static_cast<const char *>(mapping);
+    size = status.st_size;
+    return true;
+#else
+    ifstream file(path, ios::binary);
+    if (!file) return false;
+
+    buffer.assign(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+    data = buffer.data();
+    size = buffer.size();
+    return size != 0;
+#endif
+}
+
+void MappedFile::close() {
+#ifndef _WIN32
+    if (data) munmap(const_cast<char *>(data), size);
+#else
+    buffer.clear();
+#endif
+    data = nullptr;
+    size = 0;
+}
+
+const char *MappedFile::getData() const {
+    return data;
+}
+
+size_t MappedFile::getSize() const {
+    return size;
+}
@@ -0,0 +1,74 @@
+/** @file MappedFile.h
+ *  @brief Contains the MappedFile class declaration.
+ *  @author -
+ *  @bug No known bugs.
+ */
+
+#ifndef AED_FEUP_PROJ_2_22_23_MAPPEDFILE_H
+#define AED_FEUP_PROJ_2_22_23_MAPPEDFILE_H
+
+#include <string>
+#include <cstddef>
+
+using namespace std;
+
+/** @brief MappedFile class to represent a read-only file mapped into memory.
+ *
+ *  Uses mmap where it is available and falls back to reading
+ *  the whole file into a buffer otherwise.
+ */
+class MappedFile {
+
+private:
+
+    //! @brief Holds the first byte of the file.
+    const char *data = nullptr;
+
+    //! @brief Holds the size of the file in bytes.
+    size_t size = 0;
+
+    //! @brief Holds the file content when it could not be mapped.
+    string buffer;
+
+public:
+
+    /** Create a new MappedFile.
+     *
+     * Does nothing.
+     */
+    MappedFile();
+
+    //! @brief Unmaps the file.
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    /** @brief Maps a file into memory, unmapping the previous one.
+     *
+     * @param path Of const string type, by reference.
+     * @return True if the file was mapped.
+     */
+    bool open(const string &path);
+
+    /** @brief Unmaps the file.
+     *
+     * @return Void.
+     */
+    void close();
+
+    /** @brief Returns the first byte of the file.
+     *
+     * @return const char* to the file content.
+     */
+    const char *getData() const;
+
+    /** @brief Returns the size of the file.
+     *
+     * @return size_t number of bytes.
+     */
+    size_t getSize() const;
+};
+
+#endif //AED_FEUP_PROJ_2_22_23_MAPPEDFILE_H
@@ -0,0 +1,312 @@
+/** @file Snapshot.cpp
+ *  @brief Contains the Snapshot Class implementation.
+ *  @author -
+ *  @bug No known bugs.
+ */
+
+#include "Snapshot.h"
+#include <algorithm>
+#include <cstring>
+#include <cstdio>
+#include <fstream>
+#include <unordered_map>
+#include <sys/stat.h>
+
+//! @brief Identifies a snapshot file.
+static const char MAGIC[8] = {'F', 'L', 'T', 'M', 'A', 'P', 'S', 'N'};
+
+static_assert(sizeof(Flight) == 2 * sizeof(int32_t), "the flights are mapped as they are stored");
+
+Snapshot::Snapshot() = default;
+
+uint64_t Snapshot::hash(const char *data, size_t size) {
+    const uint64_t prime = 0x100000001b3ULL;
+    uint64_t result = 0xcbf29ce484222325ULL ^ size;
+
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t word;
+        memcpy(&word, data + i, 8);
+        result = (result ^ word) * prime;
+        result ^= result >> 29;
+    }
+    for (; i < size; i++)
+        result = (result ^ (unsigned char) data[i]) * prime;
+
+    return result ^ (result >> 32);
+}
+
+size_t Snapshot::layout(const Header &header, size_t offsets[NUM_SECTIONS]) {
+    size_t sizes[NUM_SECTIONS] = {
+            header.numAirports * sizeof(AirportRecord),
+            header.numAirports * sizeof(float),
+            header.numAirports * sizeof(float),
+            header.numAirlines * sizeof(AirlineRecord),
+            (header.numAirports + 1) * sizeof(uint32_t),
+            header.numFlights * sizeof(Flight),
+            header.numCities * sizeof(CityRecord),
+            header.numCityAirports * sizeof(uint32_t),
+            header.numAirports * sizeof(uint32_t),
+            header.numPoolStrings * sizeof(StringRef),
+            header.stringsSize
+    };
+
+    size_t offset = sizeof(Header);
+    for (int i = 0; i < NUM_SECTIONS; i++) {
+        offset = (offset + 7) & ~(size_t) 7;
+        offsets[i] = offset;
+        offset += sizes[i];
+    }
+    return offset;
+}
+
+bool Snapshot::fingerprint(const string &path, bool withHash, Fingerprint &fingerprint) {
+    struct stat status;
+    if (stat(path.c_str(), &status) != 0) return false;
+
+    fingerprint.size = status.st_size;
+    fingerprint.modified = status.st_mtime;
+    fingerprint.hash = 0;
+
+    if (withHash) {
+        MappedFile file;
+        if (!file.open(path)) return false;
+        fingerprint.hash = hash(file.getData(), file.getSize());
+    }
+    return true;
+}
+
+bool Snapshot::open(const string &path, const vector<string> &sources, uint32_t order) {
+    header = nullptr;
+    touched = false;
+
+    if (sources.size() != NUM_SOURCES || !file.open(path) || file.getSize() < sizeof(Header))
+        return false;
+
+    const char *data = file.getData();
+    const Header *candidate = reinterpret_cast<const Header *>(data);
+
+    if (memcmp(candidate->magic, MAGIC, sizeof(MAGIC)) != 0 || candidate->version != VERSION ||
+        candidate->numSources != NUM_SOURCES || candidate->order != order)
+        return false;
+
+    size_t offsets[NUM_SECTIONS];
+    if (layout(*candidate, offsets) != file.getSize())
+        return false;
+
+    if (hash(data + sizeof(Header), file.getSize() - sizeof(Header)) != candidate->checksum)
+        return false;
+
+    for (int i = 0; i < NUM_SOURCES; i++) {
+        const Fingerprint &saved = candidate->sources[i];
+        Fingerprint current;
+
+        if (!fingerprint(sources[i], false, current)) return false;
+        if (current.size == saved.size && current.modified == saved.modified) continue;
+
+        if (current.size != saved.size || !fingerprint(sources[i], true, current) || current.hash != saved.hash)
+            return false;
+        touched = true;
+    }
+
+    header = candidate;
+    airports = reinterpret_cast<const AirportRecord *>(data + offsets[0]);
+    latitudes = reinterpret_cast<const float *>(data + offsets[1]);
+    longitudes = reinterpret_cast<const float *>(data + offsets[2]);
+    airlines = reinterpret_cast<const AirlineRecord *>(data + offsets[3]);
+    firstFlights = reinterpret_cast<const uint32_t *>(data + offsets[4]);
+    flights = reinterpret_cast<const Flight *>(data + offsets[5]);
+    cities = reinterpret_cast<const CityRecord *>(data + offsets[6]);
+    cityAirports = reinterpret_cast<const uint32_t *>(data + offsets[7]);
+    inputOrder = reinterpret_cast<const uint32_t *>(data + offsets[8]);
+    poolStrings = reinterpret_cast<const StringRef *>(data + offsets[9]);
+    strings = data + offsets[10];
+    return true;
+}
+
+void Snapshot::close() {
+    header = nullptr;
+    file.close();
+}
+
+uint64_t Snapshot::contentHash(const vector<string> &sources) {
+    uint64_t hashes[NUM_SOURCES] = {};
+    for (size_t i = 0; i < sources.size() && i < NUM_SOURCES; i++) {
+        Fingerprint source{};
+        if (fingerprint(sources[i], true, source)) hashes[i] = source.hash;
+    }
+    return hash(reinterpret_cast<const char *>(hashes), sizeof(hashes));
+}
+
+uint64_t Snapshot::getContentHash() const {
+    uint64_t hashes[NUM_SOURCES];
+    for (int i = 0; i < NUM_SOURCES; i++)
+        hashes[i] = header->sources[i].hash;
+    return hash(reinterpret_cast<const char *>(hashes), sizeof(hashes));
+}
+
+bool Snapshot::isTouched() const {
+    return touched;
+}
+
+bool Snapshot::write(const string &path, const vector<string> &sources, const vector<AirportPTR> &airports,
+                     const vector<Airline> &airlines, const AirportsPerCity_Set &airportsPerCity,
+                     const vector<int> &inputOrder, uint32_t order) {
+    if (sources.size() != NUM_SOURCES) return false;
+
+    Header header{};
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.numSources = NUM_SOURCES;
+    header.order = order;
+    for (int i = 0; i < NUM_SOURCES; i++)
+        if (!fingerprint(sources[i], true, header.sources[i]))
+            return false;
+
+    string stringTable;
+    unordered_map<string, StringRef> stringRefs;
+    auto addString = [&](const string &value) {
+        auto found = stringRefs.find(value);
+        if (found != stringRefs.end()) return found->second;
+
+        StringRef ref{(uint32_t) stringTable.size(), (uint32_t) value.size()};
+        stringTable += value;
+        stringRefs.insert({value, ref});
+        return ref;
+    };
+
+    vector<AirportRecord> airportRecords;
+    vector<float> latitudeValues, longitudeValues;
+    vector<uint32_t> firstFlightValues{0};
+    vector<Flight> flightRecords;
+    for (const AirportPTR &airport: airports) {
+        airportRecords.push_back({addString(airport->code), (uint32_t) airport->name, (uint32_t) airport->city,
+                                  (uint32_t) airport->country});
+        latitudeValues.push_back(airport->latitude);
+        longitudeValues.push_back(airport->longitude);
+
+        flightRecords.insert(flightRecords.end(), airport->flights.begin(), airport->flights.end());
+        firstFlightValues.push_back(flightRecords.size());
+    }
+
+    vector<AirlineRecord> airlineRecords;
+    for (const Airline &airline: airlines)
+        airlineRecords.push_back({addString(airline.code), addString(airline.name),
+                                  addString(airline.callSign), addString(airline.country)});
+
+    vector<CityRecord> cityRecords;
+    vector<uint32_t> cityAirportValues;
+    for (const auto &city: airportsPerCity) {
+        cityRecords.push_back({(uint32_t) city.first.name, (uint32_t) city.first.country,
+                               (uint32_t) cityAirportValues.size(), (uint32_t) city.second.size()});
+        for (const AirportPTR &airport: city.second)
+            cityAirportValues.push_back(airport->id);
+        sort(cityAirportValues.end() - city.second.size(), cityAirportValues.end());
+    }
+
+    vector<uint32_t> inputOrderValues(inputOrder.begin(), inputOrder.end());
+    if (inputOrderValues.size() != airportRecords.size()) return false;
+
+    const StringPool &pool = StringPool::global();
+    vector<StringRef> poolStringValues;
+    for (int id = 0; id < pool.size(); id++)
+        poolStringValues.push_back(addString(pool.get(id)));
+
+    header.numAirports = airportRecords.size();
+    header.numAirlines = airlineRecords.size();
+    header.numFlights = flightRecords.size();
+    header.numCities = cityRecords.size();
+    header.numCityAirports = cityAirportValues.size();
+    header.numPoolStrings = poolStringValues.size();
+    header.stringsSize = stringTable.size();
+
+    size_t offsets[NUM_SECTIONS];
+    vector<char> buffer(layout(header, offsets), 0);
+    const void *sections[NUM_SECTIONS] = {airportRecords.data(), latitudeValues.data(), longitudeValues.data(),
+                                          airlineRecords.data(), firstFlightValues.data(), flightRecords.data(),
+                                          cityRecords.data(), cityAirportValues.data(), inputOrderValues.data(),
+                                          poolStringValues.data(), stringTable.data()};
+    size_t sizes[NUM_SECTIONS] = {airportRecords.size() * sizeof(AirportRecord), latitudeValues.size() * sizeof(float),
+                                  longitudeValues.size() * sizeof(float), airlineRecords.size() * sizeof(AirlineRecord),
+                                  firstFlightValues.size() * sizeof(uint32_t), flightRecords.size() * sizeof(Flight),
+                                  cityRecords.size() * sizeof(CityRecord), cityAirportValues.size() * sizeof(uint32_t),
+                                  inputOrderValues.size() * sizeof(uint32_t),
+                                  poolStringValues.size() * sizeof(StringRef), stringTable.size()};
+    for (int i = 0; i < NUM_SECTIONS; i++)
+        if (sizes[i]) memcpy(buffer.data() + offsets[i], sections[i], sizes[i]);
+
+    header.checksum = hash(buffer.data() + sizeof(Header), buffer.size() - sizeof(Header));
+    memcpy(buffer.data(), &header, sizeof(Header));
+
+    string temporaryPath = path + ".tmp";
+    {
+        ofstream output(temporaryPath, ios::binary | ios::trunc);
+        if (!output.write(buffer.data(), buffer.size())) return false;
+    }
+    remove(path.c_str());
+    return rename(temporaryPath.c_str(), path.c_str()) == 0;
+}
+
+uint32_t Snapshot::getNumAirports() const {
+    return header->numAirports;
+}
+
+uint32_t Snapshot::getNumFlights() const {
+    return header->numFlights;
+}
+
+uint32_t Snapshot::getNumAirlines() const {
+    return header->numAirlines;
+}
+
+uint32_t Snapshot::getNumCities() const {
+    return header->numCities;
+}
+
+uint32_t Snapshot::getNumPoolStrings() const {
+    return header->numPoolStrings;
+}
+
+Snapshot::StringRef Snapshot::getPoolString(uint32_t index) const {
+    return poolStrings[index];
+}
+
+const Snapshot::AirportRecord &Snapshot::getAirport(uint32_t id) const {
+    return airports[id];
+}
+
+float Snapshot::getLatitude(uint32_t id) const {
+    return latitudes[id];
+}
+
+float Snapshot::getLongitude(uint32_t id) const {
+    return longitudes[id];
+}
+
+const Snapshot::AirlineRecord &Snapshot::getAirline(uint32_t id) const {
+    return airlines[id];
+}
+
+const Flight *Snapshot::flightsBegin(uint32_t id) const {
+    return flights + firstFlights[id];
+}
+
+const Flight *Snapshot::flightsEnd(uint32_t id) const {
+    return flights + firstFlights[id + 1];
+}
+
+const Snapshot::CityRecord &Snapshot::getCity(uint32_t index) const {
+    return cities[index];
+}
+
+uint32_t Snapshot::getCityAirport(uint32_t position) const {
+    return cityAirports[position];
+}
+
+uint32_t Snapshot::getInputOrder(uint32_t position) const {
+    return inputOrder[position];
+}
+
+string Snapshot::getString(StringRef ref) const {
+    return string(strings + ref.offset, ref.length);
+}
@@ -0,0 +1,276 @@
+/** @file Snapshot.h
+ *  @brief Contains the Snapshot class declaration.
+ *  @author -
+ *  @bug No known bugs.
+ */
+
+#ifndef AED_FEUP_PROJ_2_22_23_SNAPSHOT_H
+#define AED_FEUP_PROJ_2_22_23_SNAPSHOT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "MappedFile.h"
+#include "../../Graph/FlightMap.h"
+#include "../../Graph/Airline/Airline.h"
+
+using namespace std;
+
+/** @brief Snapshot class to represent a binary image of the database.
+ *
+ *  Holds the string pool and the airline strings, the coordinates of the airports,
+ *  the flights grouped by source airport, the airports per city and the order of the airports in the input file,
+ *  all as flat arrays. The airports and the cities refer to their names by index in the string pool table,
+ *  and the flights are stored as Flight, so the database points into them instead of copying them.
+ *  The file is versioned, checksummed, and remembers the size, modification time
+ *  and hash of the input files it was built from, so it can be discarded when they change.
+ *  It is mapped into memory and read in place.
+ */
+class Snapshot {
+
+public:
+
+    //! @brief Defines the version of the file format, to be increased on every layout change.
+    static const uint32_t VERSION = 3;
+
+    //! @brief Reference to a string in the string table.
+    struct StringRef {
+
+        //! @brief Holds the offset of the first character in the string table.
+        uint32_t offset;
+
+        //! @brief Holds the number of characters.
+        uint32_t length;
+    };
+
+    //! @brief Represents an airport, except for its coordinates, with its names as indexes in the string pool table.
+    struct AirportRecord {
+        StringRef code;
+        uint32_t name, city, country;
+    };
+
+    //! @brief Represents an airline.
+    struct AirlineRecord {
+        StringRef code, name, callSign, country;
+    };
+
+    //! @brief Represents a city, with its names as indexes in the string pool table, and the range of its airports
+    //! in the city index.
+    struct CityRecord {
+        uint32_t name, country;
+
+        //! @brief Holds the position of the first airport of the city in the city index.
+        uint32_t firstAirport;
+
+        //! @brief Holds the number of airports of the city.
+        uint32_t numAirports;
+    };
+
+    //! @brief Identifies the content of an input file.
+    struct Fingerprint {
+
+        //! @brief Holds the size of the file in bytes.
+        uint64_t size;
+
+        //! @brief Holds the last modification time of the file.
+        int64_t modified;
+
+        //! @brief Holds the hash of the file content.
+        uint64_t hash;
+    };
+
+private:
+
+    //! @brief Holds the number of input files a snapshot is built from.
+    static const int NUM_SOURCES = 3;
+
+    //! @brief Holds the number of arrays after the header.
+    static const int NUM_SECTIONS = 11;
+
+    //! @brief Layout of the beginning of the file.
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t numSources;
+        uint64_t checksum;
+        Fingerprint sources[NUM_SOURCES];
+        uint32_t numAirports;
+        uint32_t numAirlines;
+        uint32_t numFlights;
+        uint32_t numCities;
+        uint32_t numCityAirports;
+        uint32_t numPoolStrings;
+        uint32_t order;
+        uint64_t stringsSize;
+    };
+
+    //! @brief Holds the mapped file.
+    MappedFile file;
+
+    //! @brief Holds the header of the mapped file.
+    const Header *header = nullptr;
+
+    //! @brief Holds whether the input files were modified without changing their content.
+    bool touched = false;
+
+    const AirportRecord *airports = nullptr;
+    const float *latitudes = nullptr;
+    const float *longitudes = nullptr;
+    const AirlineRecord *airlines = nullptr;
+    const uint32_t *firstFlights = nullptr;
+    const Flight *flights = nullptr;
+    const CityRecord *cities = nullptr;
+    const uint32_t *cityAirports = nullptr;
+    const uint32_t *inputOrder = nullptr;
+    const StringRef *poolStrings = nullptr;
+    const char *strings = nullptr;
+
+    /** @brief Computes the size of the file and the offset of each section.
+     *
+     * @param header Of const Header type, by reference.
+     * @param offsets Of size_t array type, to be filled with the offset of every section.
+     * @return size_t total size of the file.
+     */
+    static size_t layout(const Header &header, size_t offsets[NUM_SECTIONS]);
+
+    /** @brief Computes the fingerprint of an input file.
+     *
+     * @param path Of const string type, by reference.
+     * @param withHash Of bool type, if false the hash is left at 0.
+     * @param fingerprint Of Fingerprint type, by reference.
+     * @return True if the file exists.
+     */
+    static bool fingerprint(const string &path, bool withHash, Fingerprint &fingerprint);
+
+public:
+
+    /** Create a new Snapshot.
+     *
+     * Does nothing.
+     */
+    Snapshot();
+
+    /** @brief Hashes a block of memory.
+     *
+     * Used for both the checksum of the snapshot and the fingerprints of the input files.
+     *
+     * @param data Of const char* type.
+     * @param size Of size_t type.
+     * @return uint64_t hash.
+     */
+    static uint64_t hash(const char *data, size_t size);
+
+    /** @brief Maps a snapshot file and checks that it can be used.
+     *
+     * The snapshot is rejected if its magic, version or checksum are wrong,
+     * if the content of any input file changed since it was written, or if its airports are in another order.
+     * Input files whose size and modification time are unchanged are not hashed.
+     *
+     * @param path Of const string type, by reference, path of the snapshot.
+     * @param sources Of const vector<string> type, by reference, paths of the airports, airlines and flights files.
+     * @param order Of uint32_t type, the Renumbering::Order the airports must have been given ids in.
+     * @return True if the snapshot is valid.
+     */
+    bool open(const string &path, const vector<string> &sources, uint32_t order);
+
+    /** @brief Unmaps the snapshot.
+     *
+     * @return Void.
+     */
+    void close();
+
+    /** @brief Hashes the content of the input files, the same way a snapshot remembers them.
+     *
+     * @param sources Of const vector<string> type, by reference, paths of the airports, airlines and flights files.
+     * @return uint64_t hash, which changes when any of the files does.
+     */
+    static uint64_t contentHash(const vector<string> &sources);
+
+    /** @brief Returns the hash of the content of the input files the snapshot was built from.
+     *
+     * The same as contentHash of the input files, without reading them again.
+     *
+     * @return uint64_t hash.
+     */
+    uint64_t getContentHash() const;
+
+    /** @brief Returns true if an input file was touched but kept its content.
+     *
+     * The snapshot can still be used, but should be written again to save the new fingerprints.
+     *
+     * @return bool.
+     */
+    bool isTouched() const;
+
+    /** @brief Writes a snapshot file.
+     *
+     * The file is written to a temporary path first and then renamed.
+     * The whole global string pool is written, since the airports refer to their names by id in it.
+     *
+     * @param path Of const string type, by reference, path of the snapshot.
+     * @param sources Of const vector<string> type, by reference, paths of the airports, airlines and flights files.
+     * @param airports Of const vector<AirportPTR> type, by reference, indexed by id.
+     * @param airlines Of const vector<Airline> type, by reference, indexed by id.
+     * @param airportsPerCity Of const AirportsPerCity_Set type, by reference.
+     * @param inputOrder Of const vector<int> type, by reference, the ids of the airports in the order of the input file.
+     * @param order Of uint32_t type, the Renumbering::Order the airports were given ids in.
+     * @return True if the file was written.
+     */
+    static bool write(const string &path, const vector<string> &sources, const vector<AirportPTR> &airports,
+                      const vector<Airline> &airlines, const AirportsPerCity_Set &airportsPerCity,
+                      const vector<int> &inputOrder, uint32_t order);
+
+    //! @brief Returns the number of airports.
+    uint32_t getNumAirports() const;
+
+    //! @brief Returns the number of flights.
+    uint32_t getNumFlights() const;
+
+    //! @brief Returns the number of airlines.
+    uint32_t getNumAirlines() const;
+
+    //! @brief Returns the number of cities.
+    uint32_t getNumCities() const;
+
+    //! @brief Returns the number of strings of the string pool table.
+    uint32_t getNumPoolStrings() const;
+
+    //! @brief Returns the string at the given index of the string pool table.
+    StringRef getPoolString(uint32_t index) const;
+
+    //! @brief Returns the airport with the given id.
+    const AirportRecord &getAirport(uint32_t id) const;
+
+    //! @brief Returns the latitude of the airport with the given id.
+    float getLatitude(uint32_t id) const;
+
+    //! @brief Returns the longitude of the airport with the given id.
+    float getLongitude(uint32_t id) const;
+
+    //! @brief Returns the airline with the given id.
+    const AirlineRecord &getAirline(uint32_t id) const;
+
+    //! @brief Returns the first flight leaving the airport with the given id.
+    const Flight *flightsBegin(uint32_t id) const;
+
+    //! @brief Returns one past the last flight leaving the airport with the given id.
+    const Flight *flightsEnd(uint32_t id) const;
+
+    //! @brief Returns the city with the given index.
+    const CityRecord &getCity(uint32_t index) const;
+
+    //! @brief Returns the id of the airport at the given position of the city index.
+    uint32_t getCityAirport(uint32_t position) const;
+
+    //! @brief Returns the id of the airport at the given position of the input file.
+    uint32_t getInputOrder(uint32_t position) const;
+
+    /** @brief Returns a string of the string table.
+     *
+     * @param ref Of StringRef type.
+     * @return string.
+     */
+    string getString(StringRef ref) const;
+};
+
+#endif //AED_FEUP_PROJ_2_22_23_SNAPSHOT_H
@@ -0,0 +1,155 @@
+/** @file Statistics.cpp
+ *  @brief Contains the Statistics Class implementation.
+ *  @author -
+ *  @bug No known bugs.
+ */
+
+#include "Statistics.h"
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include "../../Scheduler/Scheduler.h"
+
+Statistics::Statistics() = default;
+
+void Statistics::build(const vector<AirportPTR> &airports, int numAirlines) {
+    StringPool &pool = StringPool::global();
+
+    this->airports.assign(airports.size(), AirportStatistics());
+    this->countries.assign(pool.size(), CountryStatistics());
+    this->numFlights = 0;
+    this->numAirlines = numAirlines;
+
+    // Each seen array remembers the last airport that counted a value, so it never has to be cleared.
+    vector<int> airlineSeen(numAirlines, -1);
+    vector<int> countrySeen(pool.size(), -1);
+    vector<int> destinationSeen(airports.size(), -1);
+    vector<City> cities;
+    vector<pair<int, int>> countryAirlines;
+
+    for (const AirportPTR &airport: airports) {
+        AirportStatistics &statistics = this->airports[airport->id];
+        statistics.flights = airport->flights.size();
+
+        cities.clear();
+        for (const Flight &flight: airport->flights) {
+            const AirportPTR &destination = airports[flight.destination];
+
+            if (airlineSeen[flight.airline] != airport->id) {
+                airlineSeen[flight.airline] = airport->id;
+                statistics.airlines++;
+                countryAirlines.emplace_back(airport->country, flight.airline);
+            }
+            if (destinationSeen[destination->id] != airport->id) {
+                destinationSeen[destination->id] = airport->id;
+                statistics.destinations++;
+            }
+            if (countrySeen[destination->country] != airport->id) {
+                countrySeen[destination->country] = airport->id;
+                statistics.countries++;
+            }
+            cities.emplace_back(destination->city, destination->country);
+            this->airports[destination->id].arrivals++;
+        }
+        sort(cities.begin(), cities.end());
+        statistics.cities = unique(cities.begin(), cities.end()) - cities.begin();
+
+        CountryStatistics &country = countries[airport->country];
+        country.airports++;
+        country.flights += statistics.flights;
+        numFlights += statistics.flights;
+    }
+
+    sort(countryAirlines.begin(), countryAirlines.end());
+    countryAirlines.erase(unique(countryAirlines.begin(), countryAirlines.end()), countryAirlines.end());
+    for (const auto &countryAirline: countryAirlines)
+        countries[countryAirline.first].airlines++;
+
+    int position = 0;
+    for (CountryStatistics &country: countries) {
+        country.firstAirport = position;
+        position += country.airports;
+    }
+
+    sortRankings(airports);
+}
+
+int Statistics::getKey(int id, Ranking ranking) const {
+    const AirportStatistics &statistics = airports[id];
+    switch (ranking) {
+        case IN_DEGREE:
+            return statistics.arrivals;
+        case DESTINATIONS:
+            return statistics.destinations;
+        case AIRLINES:
+            return statistics.airlines;
+        default:
+            return statistics.flights;
+    }
+}
+
+void Statistics::sortRankings(const vector<AirportPTR> &airports) {
+    vector<function<void()>> sorts;
+
+    for (int index = 0; index < NUM_RANKINGS; index++) {
+        Ranking ranking = (Ranking) index;
+        vector<int> &global = rankings[index];
+        vector<int> &byCountry = countryRankings[index];
+        global.resize(airports.size());
+        iota(global.begin(), global.end(), 0);
+        byCountry = global;
+
+        sorts.emplace_back([this, ranking, &global]() {
+            sort(global.begin(), global.end(), [this, ranking](int id1, int id2) {
+                int key1 = getKey(id1, ranking), key2 = getKey(id2, ranking);
+                return key1 != key2 ? key1 > key2 : id1 < id2;
+            });
+        });
+        sorts.emplace_back([this, ranking, &byCountry, &airports]() {
+            sort(byCountry.begin(), byCountry.end(), [this, ranking, &airports](int id1, int id2) {
+                int country1 = airports[id1]->country, country2 = airports[id2]->country;
+                if (country1 != country2) return country1 < country2;
+                int key1 = getKey(id1, ranking), key2 = getKey(id2, ranking);
+                return key1 != key2 ? key1 > key2 : id1 < id2;
+            });
+        });
+    }
+
+    Scheduler::global().parallelFor(0, sorts.size(), 1, [&sorts](int first, int last) {
+        for (int i = first; i < last; i++)
+            sorts[i]();
+    });
+}
+
+const Statistics::AirportStatistics &Statistics::getAirport(int id) const {
+    return airports[id];
+}
+
+const Statistics::CountryStatistics &Statistics::getCountry(int country) const {
+    static const CountryStatistics noCountry{};
+    return country < 0 || country >= (int) countries.size() ? noCountry : countries[country];
+}
+
+Statistics::RankingSlice Statistics::getTop(Ranking ranking, int k) const {
+    const vector<int> &ranked = rankings[ranking];
+    size_t size = min<size_t>(max(k, 0), ranked.size());
+    return {ranked.data(), ranked.data() + size};
+}
+
+Statistics::RankingSlice Statistics::getTop(Ranking ranking, int country, int k) const {
+    const CountryStatistics &statistics = getCountry(country);
+    const int *first = countryRankings[ranking].data() + statistics.firstAirport;
+    return {first, first + min(max(k, 0), statistics.airports)};
+}
+
+int Statistics::getNumAirports() const {
+    return airports.size();
+}
+
+int Statistics::getNumFlights() const {
+    return numFlights;
+}
+
+int Statistics::getNumAirlines() const {
+    return numAirlines;
+}
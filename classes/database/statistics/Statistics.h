@@ -0,0 +1,197 @@
+/** @file Statistics.h
+ *  @brief Contains the Statistics class declaration.
+ *  @author -
+ *  @bug No known bugs.
+ */
+
+#ifndef AED_FEUP_PROJ_2_22_23_STATISTICS_H
+#define AED_FEUP_PROJ_2_22_23_STATISTICS_H
+
+#include <vector>
+#include "../../Graph/FlightMap.h"
+
+using namespace std;
+
+/** @brief Statistics class to represent the counts of the network, computed once after loading.
+ *
+ *  Holds, for each airport, the number of its flights, of the airlines flying from it
+ *  and of the cities and countries it flies to; and for each country, the number
+ *  of its airports, of the flights leaving them and of the airlines flying from them.
+ *  Every count is then answered in constant time.
+ *  The airports are also ranked by each of their counts, globally and within their country,
+ *  so the top airports are a slice of a sorted index.
+ */
+class Statistics {
+
+public:
+
+    //! @brief Defines the counts the airports can be ranked by.
+    enum Ranking {
+        OUT_DEGREE, IN_DEGREE, DESTINATIONS, AIRLINES, NUM_RANKINGS
+    };
+
+    //! @brief Represents the counts of an airport.
+    struct AirportStatistics {
+
+        //! @brief Holds the number of flights leaving the airport.
+        int flights = 0;
+
+        //! @brief Holds the number of flights arriving at the airport.
+        int arrivals = 0;
+
+        //! @brief Holds the number of distinct airports the airport has flights to.
+        int destinations = 0;
+
+        //! @brief Holds the number of distinct airlines flying from the airport.
+        int airlines = 0;
+
+        //! @brief Holds the number of distinct cities the airport has flights to.
+        int cities = 0;
+
+        //! @brief Holds the number of distinct countries the airport has flights to.
+        int countries = 0;
+    };
+
+    //! @brief Represents the counts of a country.
+    struct CountryStatistics {
+
+        //! @brief Holds the number of airports in the country.
+        int airports = 0;
+
+        //! @brief Holds the number of flights leaving the airports of the country.
+        int flights = 0;
+
+        //! @brief Holds the number of distinct airlines flying from the airports of the country.
+        int airlines = 0;
+
+        //! @brief Holds the position of the first airport of the country in the country rankings.
+        int firstAirport = 0;
+    };
+
+    //! @brief Represents a slice of a ranking, as airport ids from the best one down.
+    struct RankingSlice {
+        const int *first = nullptr;
+        const int *last = nullptr;
+
+        const int *begin() const { return first; }
+
+        const int *end() const { return last; }
+
+        size_t size() const { return last - first; }
+
+        bool empty() const { return first == last; }
+    };
+
+private:
+
+    //! @brief Holds the counts of each airport, indexed by its id.
+    vector<AirportStatistics> airports;
+
+    //! @brief Holds the counts of each country, indexed by the id of its name in the global string pool.
+    vector<CountryStatistics> countries;
+
+    //! @brief Holds the total number of flights.
+    int numFlights = 0;
+
+    //! @brief Holds the total number of airlines.
+    int numAirlines = 0;
+
+    //! @brief Holds, for each ranking, every airport id from the best one down.
+    vector<int> rankings[NUM_RANKINGS];
+
+    //! @brief Holds, for each ranking, every airport id grouped by country and from the best one down in each country.
+    vector<int> countryRankings[NUM_RANKINGS];
+
+    /** @brief Returns the count an airport is ranked by.
+     *
+     * @param id Of int type.
+     * @param ranking Of Ranking type.
+     * @return int.
+     */
+    int getKey(int id, Ranking ranking) const;
+
+    /** @brief Sorts the global and the country rankings, running the sorts on the scheduler.
+     *
+     * @param airports Of const vector<AirportPTR> type, by reference, indexed by id.
+     * @return Void.
+     */
+    void sortRankings(const vector<AirportPTR> &airports);
+
+public:
+
+    /** Create a new, empty Statistics.
+     *
+     * Does nothing.
+     */
+    Statistics();
+
+    /** @brief Computes every count.
+     *
+     * Temporal Complexity: O(V log(V) + E log(E)), V being the number of airports and E the number of flights.
+     *
+     * @param airports Of const vector<AirportPTR> type, by reference, indexed by id.
+     * @param numAirlines Of int type.
+     * @return Void.
+     */
+    void build(const vector<AirportPTR> &airports, int numAirlines);
+
+    /** @brief Returns the counts of an airport.
+     *
+     * Temporal Complexity: O(1).
+     *
+     * @param id Of int type.
+     * @return read-only reference to the AirportStatistics.
+     */
+    const AirportStatistics &getAirport(int id) const;
+
+    /** @brief Returns the counts of a country.
+     *
+     * Temporal Complexity: O(1).
+     *
+     * @param country Of int type, id of the name of the country in the global string pool.
+     * @return read-only reference to the CountryStatistics, all zero for an unknown country.
+     */
+    const CountryStatistics &getCountry(int country) const;
+
+    /** @brief Returns the best airports of a ranking.
+     *
+     * Ties are broken by the order of the airports in the input file.
+     * Temporal Complexity: O(1).
+     *
+     * @param ranking Of Ranking type.
+     * @param k Of int type, the maximum number of airports.
+     * @return RankingSlice with at most k airport ids.
+     */
+    RankingSlice getTop(Ranking ranking, int k) const;
+
+    /** @brief Returns the best airports of a country in a ranking.
+     *
+     * Temporal Complexity: O(1).
+     *
+     * @param ranking Of Ranking type.
+     * @param country Of int type, id of the name of the country in the global string pool.
+     * @param k Of int type, the maximum number of airports.
+     * @return RankingSlice with at most k airport ids, empty for an unknown country.
+     */
+    RankingSlice getTop(Ranking ranking, int country, int k) const;
+
+    /** @brief Returns the total number of airports.
+     *
+     * @return int.
+     */
+    int getNumAirports() const;
+
+    /** @brief Returns the total number of flights.
+     *
+     * @return int.
+     */
+    int getNumFlights() const;
+
+    /** @brief Returns the total number of airlines.
+     *
+     * @return int.
+     */
+    int getNumAirlines() const;
+};
+
+#endif //AED_FEUP_PROJ_2_22_23_STATISTICS_H
@@ -0,0 +1,29 @@
+/** @file Deadline.cpp
+ *  @brief Contains the Deadline class implementation.
+ *  @author -
+ *  @bug No known bugs.
+ */
+
+#include "Deadline.h"
+
+DeadlineExceeded::DeadlineExceeded() : runtime_error("deadline exceeded") {}
+
+Deadline::Deadline() : time(chrono::steady_clock::time_point::max()) {}
+
+Deadline::Deadline(chrono::steady_clock::time_point time) : time(time) {}
+
+bool Deadline::isSet() const {
+    return time != chrono::steady_clock::time_point::max();
+}
+
+chrono::steady_clock::time_point Deadline::getTime() const {
+    return time;
+}
+
+bool Deadline::passed() const {
+    return isSet() && chrono::steady_clock::now() > time;
+}
+
+void Deadline::check() const {
+    if (passed()) throw DeadlineExceeded();
+}
@@ -0,0 +1,78 @@
+/** @file Deadline.h
+ *  @brief Contains the Deadline class and the DeadlineExceeded exception declaration.
+ *  @author -
+ *  @bug No known bugs.
+ */
+
+#ifndef AED_FEUP_PROJ_2_22_23_DEADLINE_H
+#define AED_FEUP_PROJ_2_22_23_DEADLINE_H
+
+#include <chrono>
+#include <stdexcept>
+
+using namespace std;
+
+/** @brief DeadlineExceeded exception thrown by a search that gave up because its deadline passed.
+ *
+ */
+class DeadlineExceeded : public runtime_error {
+
+public:
+
+    /** Create a new DeadlineExceeded, with the message "deadline exceeded".
+     *
+     */
+    DeadlineExceeded();
+};
+
+/** @brief Deadline class to tell a long search when its result is no longer wanted.
+ *
+ *  The searches check it between steps, such as the rounds of a search or the sources of the analytics,
+ *  and stop by throwing DeadlineExceeded once it passed. A deadline made with no time never passes.
+ */
+class Deadline {
+
+private:
+
+    //! @brief Holds the time after which the result is no longer wanted, the latest time if there is none.
+    chrono::steady_clock::time_point time;
+
+public:
+
+    /** Create a new Deadline that never passes.
+     *
+     */
+    Deadline();
+
+    /** Create a new Deadline that passes at a time.
+     *
+     * @param time of chrono::steady_clock::time_point type.
+     */
+    explicit Deadline(chrono::steady_clock::time_point time);
+
+    /** @brief Returns true if the deadline has a time.
+     *
+     * @return bool.
+     */
+    bool isSet() const;
+
+    /** @brief Returns the time of the deadline.
+     *
+     * @return chrono::steady_clock::time_point, the latest time if there is none.
+     */
+    chrono::steady_clock::time_point getTime() const;
+
+    /** @brief Returns true if the deadline passed.
+     *
+     * @return bool.
+     */
+    bool passed() const;
+
+    /** @brief Throws DeadlineExceeded if the deadline passed.
+     *
+     * @return Void.
+     */
+    void check() const;
+};
+
+#endif //AED_FEUP_PROJ_2_22_23_DEADLINE_H
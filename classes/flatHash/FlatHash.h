@@ -0,0 +1,674 @@
+/** @file FlatHash.h
+ *  @brief Contains the FlatGroup struct and the FlatTable, FlatSet and FlatMap class declarations.
+ *  @author -
+ *  @bug No known bugs.
+ */
+
+#ifndef AED_FEUP_PROJ_2_22_23_FLATHASH_H
+#define AED_FEUP_PROJ_2_22_23_FLATHASH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FLAT_HASH_SSE2
+#endif
+
+using namespace std;
+
+/** @brief flatGroup struct to represent the control bytes of a group of slots of a flat table.
+ *
+ *  Each slot has a control byte: EMPTY, DELETED, or the low 7 bits of the hash of its key.
+ *  The bytes of a group are compared all at once, with SSE2 where there is, or one by one otherwise,
+ *  giving a mask with a bit set for each slot that matches.
+ */
+struct FlatGroup {
+
+    //! @brief Defines the number of slots in a group.
+    static const size_t SIZE = 16;
+
+    //! @brief Defines the control byte of a slot that never held a key.
+    static const int8_t EMPTY = -128;
+
+    //! @brief Defines the control byte of a slot whose key was erased.
+    static const int8_t DELETED = -2;
+
+    /** @brief Returns the slots of a group whose control byte is a tag.
+     *
+     * @param control Of const int8_t type, by pointer, to the first control byte of the group.
+     * @param tag Of int8_t type.
+     * @return uint32_t with a bit for each slot.
+     */
+    static uint32_t match(const int8_t *control, int8_t tag) {
+#ifdef FLAT_HASH_SSE2
+        __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i *>(control));
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(tag)));
+#else
+        uint32_t mask = 0;
+        for (size_t slot = 0; slot < SIZE; slot++)
+            if (control[slot] == tag) mask |= 1u << slot;
+        return mask;
+#endif
+    }
+
+    /** @brief Returns the slots of a group that never held a key.
+     *
+     * @param control Of const int8_t type, by pointer, to the first control byte of the group.
+     * @return uint32_t with a bit for each slot.
+     */
+    static uint32_t matchEmpty(const int8_t *control) {
+        return match(control, EMPTY);
+    }
+
+    /** @brief Returns the slots of a group that hold no key.
+     *
+     * @param control Of const int8_t type, by pointer, to the first control byte of the group.
+     * @return uint32_t with a bit for each slot.
+     */
+    static uint32_t matchFree(const int8_t *control) {
+#ifdef FLAT_HASH_SSE2
+        __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i *>(control));
+        return _mm_movemask_epi8(group);
+#else
+        uint32_t mask = 0;
+        for (size_t slot = 0; slot < SIZE; slot++)
+            if (control[slot] < 0) mask |= 1u << slot;
+        return mask;
+#endif
+    }
+
+    /** @brief Returns the position of the lowest bit set in a mask.
+     *
+     * @param mask Of uint32_t type, not 0.
+     * @return size_t.
+     */
+    static size_t lowest(uint32_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctz(mask);
+#else
+        size_t position = 0;
+        while (!(mask & 1)) {
+            mask >>= 1;
+            position++;
+        }
+        return position;
+#endif
+    }
+};
+
+/** @brief flatSetKey struct to return the key of a slot of a FlatSet, which is the key itself.
+ *
+ */
+struct FlatSetKey {
+    template<typename Key>
+    const Key &operator()(const Key &key) const {
+        return key;
+    }
+};
+
+/** @brief flatMapKey struct to return the key of a slot of a FlatMap, the first of its pair.
+ *
+ */
+struct FlatMapKey {
+    template<typename Slot>
+    const typename Slot::first_type &operator()(const Slot &slot) const {
+        return slot.first;
+    }
+};
+
+/** @brief FlatTable class to represent a hash table with open addressing, the base of FlatSet and FlatMap.
+ *
+ *  The slots are kept in one array and their control bytes in another, in groups of FlatGroup::SIZE.
+ *  A key is looked for in the group given by the high bits of its hash, comparing the tag in its low 7 bits
+ *  with the whole group at once, and then in further groups by triangular probing until a group has an empty slot.
+ *  Only the slots whose tag matches are compared with the key, so most lookups read one group and one slot.
+ *  The table grows to double the slots when 7/8 of them are used.
+ *  A table with fewer slots than a group still has a whole group of control bytes, the rest of them EMPTY,
+ *  so the many small sets of the city index take a few slots each.
+ *  The hash of the key is mixed first, so a hash that is the identity, such as of an int, still spreads.
+ *
+ * @tparam Key the type of the keys.
+ * @tparam Slot the type held in each slot, the key or a pair of the key and a value.
+ * @tparam KeyOf a functor returning the key of a slot.
+ * @tparam Hash a functor hashing a key.
+ * @tparam Equal a functor comparing two keys.
+ * @tparam Mutable true if the slots may be changed through an iterator.
+ */
+template<typename Key, typename Slot, typename KeyOf, typename Hash, typename Equal, bool Mutable>
+class FlatTable {
+
+public:
+
+    /** @brief iterator class to go through the slots that hold a key, in the order of the array.
+     *
+     * @tparam Const true if the slots are read-only.
+     */
+    template<bool Const>
+    class Iterator {
+
+        friend class FlatTable;
+
+    private:
+
+        //! @brief Holds the table.
+        const FlatTable *table = nullptr;
+
+        //! @brief Holds the index of the slot.
+        size_t index = 0;
+
+        /** @brief Moves to the first slot holding a key from the current one, or the end.
+         *
+         * Reads the control bytes a group at a time.
+         *
+         * @return Void.
+         */
+        void skip() {
+            while (index < table->capacity) {
+                size_t group = index - index % FlatGroup::SIZE;
+                uint32_t full = ~FlatGroup::matchFree(table->control + group) & (0xFFFFu << (index - group)) & 0xFFFFu;
+                if (full) {
+                    index = group + FlatGroup::lowest(full);
+                    return;
+                }
+                index = group + FlatGroup::SIZE;
+            }
+            index = table->capacity;
+        }
+
+    public:
+
+        typedef forward_iterator_tag iterator_category;
+        typedef Slot value_type;
+        typedef ptrdiff_t difference_type;
+        typedef typename conditional<Const, const Slot *, Slot *>::type pointer;
+        typedef typename conditional<Const, const Slot &, Slot &>::type reference;
+
+        Iterator() = default;
+
+        Iterator(const FlatTable *table, size_t index) : table(table), index(index) {}
+
+        template<bool OtherConst, typename = typename enable_if<Const && !OtherConst>::type>
+        Iterator(const Iterator<OtherConst> &other) : table(other.table), index(other.index) {}
+
+        reference operator*() const {
+            return table->slots[index];
+        }
+
+        pointer operator->() const {
+            return &table->slots[index];
+        }
+
+        Iterator &operator++() {
+            index++;
+            skip();
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        bool operator==(const Iterator &other) const {
+            return index == other.index;
+        }
+
+        bool operator!=(const Iterator &other) const {
+            return index != other.index;
+        }
+
+        template<bool> friend class Iterator;
+    };
+
+    typedef Iterator<!Mutable> iterator;
+
+    typedef Iterator<true> const_iterator;
+
+protected:
+
+    //! @brief Holds the control byte of each slot, and EMPTY ones up to a whole group if there are fewer slots.
+    int8_t *control = nullptr;
+
+    //! @brief Holds the slots, constructed only where the control byte is a tag.
+    Slot *slots = nullptr;
+
+    //! @brief Holds the number of slots, a power of 2, or 0.
+    size_t capacity = 0;
+
+    //! @brief Holds the number of keys.
+    size_t numKeys = 0;
+
+    //! @brief Holds the number of empty slots that may still be used before growing.
+    size_t growthLeft = 0;
+
+    //! @brief Holds the hash function.
+    Hash hasher;
+
+    //! @brief Holds the comparison of keys.
+    Equal equal;
+
+    /** @brief Returns the number of keys a number of slots may hold before growing.
+     *
+     * @param slots Of size_t type.
+     * @return size_t.
+     */
+    static size_t maxLoad(size_t slots) {
+        return slots - slots / 8;
+    }
+
+    /** @brief Returns the number of control bytes of a number of slots, at least a whole group.
+     *
+     * @param slots Of size_t type.
+     * @return size_t.
+     */
+    static size_t controlBytes(size_t slots) {
+        return slots < FlatGroup::SIZE ? FlatGroup::SIZE : slots;
+    }
+
+    /** @brief Returns the mask of the last group, all the groups but the first being whole.
+     *
+     * @return size_t.
+     */
+    size_t groupMask() const {
+        return capacity <= FlatGroup::SIZE ? 0 : capacity / FlatGroup::SIZE - 1;
+    }
+
+    /** @brief Returns the mixed hash of a key.
+     *
+     * @param key Of const Key type, by reference.
+     * @return size_t.
+     */
+    size_t hashOf(const Key &key) const {
+        uint64_t hash = (uint64_t) hasher(key) * 0x9E3779B97F4A7C15ULL;
+        return (size_t) (hash ^ (hash >> 32));
+    }
+
+    /** @brief Returns the index of the slot holding a key.
+     *
+     * @param key Of const Key type, by reference.
+     * @param hash Of size_t type, the mixed hash of the key.
+     * @return size_t, capacity if no slot holds it.
+     */
+    size_t locate(const Key &key, size_t hash) const {
+        if (!capacity) return 0;
+        size_t groupMask = this->groupMask();
+        size_t group = (hash >> 7) & groupMask;
+        int8_t tag = hash & 0x7F;
+        for (size_t step = 1;; step++) {
+            const int8_t *groupControl = control + group * FlatGroup::SIZE;
+            for (uint32_t mask = FlatGroup::match(groupControl, tag); mask; mask &= mask - 1) {
+                size_t index = group * FlatGroup::SIZE + FlatGroup::lowest(mask);
+                if (equal(KeyOf()(slots[index]), key)) return index;
+            }
+            if (FlatGroup::matchEmpty(groupControl)) return capacity;
+            group = (group + step) & groupMask;
+        }
+    }
+
+    /** @brief Returns the index of the first slot holding no key on the way of a hash.
+     *
+     * The table must have a free slot.
+     *
+     * @param hash Of size_t type.
+     * @return size_t.
+     */
+    size_t freeSlot(size_t hash) const {
+        size_t groupMask = this->groupMask();
+        size_t group = (hash >> 7) & groupMask;
+        uint32_t slotMask = capacity < FlatGroup::SIZE ? (1u << capacity) - 1 : 0xFFFFu;
+        for (size_t step = 1;; step++) {
+            uint32_t mask = FlatGroup::matchFree(control + group * FlatGroup::SIZE) & slotMask;
+            if (mask) return group * FlatGroup::SIZE + FlatGroup::lowest(mask);
+            group = (group + step) & groupMask;
+        }
+    }
+
+    /** @brief Moves every key to a new array of slots.
+     *
+     * @param newCapacity Of size_t type, a power of 2, enough for every key.
+     * @return Void.
+     */
+    void rehash(size_t newCapacity) {
+        int8_t *oldControl = control;
+        Slot *oldSlots = slots;
+        size_t oldCapacity = capacity;
+
+        control = static_cast<int8_t *>(::operator new(controlBytes(newCapacity)));
+        memset(control, FlatGroup::EMPTY, controlBytes(newCapacity));
+        slots = static_cast<Slot *>(::operator new(newCapacity * sizeof(Slot)));
+        capacity = newCapacity;
+        growthLeft = maxLoad(newCapacity) - numKeys;
+
+        for (size_t index = 0; index < oldCapacity; index++) {
+            if (oldControl[index] < 0) continue;
+            size_t hash = hashOf(KeyOf()(oldSlots[index]));
+            size_t newIndex = freeSlot(hash);
+            new(&slots[newIndex]) Slot(move(oldSlots[index]));
+            control[newIndex] = hash & 0x7F;
+            oldSlots[index].~Slot();
+        }
+        ::operator delete(oldControl);
+        ::operator delete(oldSlots);
+    }
+
+    /** @brief Returns the number of slots needed to hold a number of keys.
+     *
+     * @param keys Of size_t type.
+     * @return size_t.
+     */
+    static size_t capacityFor(size_t keys) {
+        size_t newCapacity = 2;
+        while (maxLoad(newCapacity) < keys) newCapacity *= 2;
+        return newCapacity;
+    }
+
+    /** @brief Returns the slot holding a key, constructing it from the arguments first if there is none.
+     *
+     * @param key Of const Key type, by reference.
+     * @param args Of Args type, the arguments of the constructor of the slot.
+     * @return pair<size_t, bool> with the index of the slot and true if it was constructed.
+     */
+    template<typename... Args>
+    pair<size_t, bool> place(const Key &key, Args &&... args) {
+        size_t hash = hashOf(key);
+        size_t index = locate(key, hash);
+        if (index != capacity) return {index, false};
+
+        if (!growthLeft)
+            rehash(numKeys < maxLoad(capacity) / 2 ? capacity : capacityFor(numKeys + 1));
+        index = freeSlot(hash);
+        new(&slots[index]) Slot(forward<Args>(args)...);
+        if (control[index] == FlatGroup::EMPTY) growthLeft--;
+        control[index] = hash & 0x7F;
+        numKeys++;
+        return {index, true};
+    }
+
+    /** @brief Destroys every key, keeping the slots.
+     *
+     * @return Void.
+     */
+    void destroy() {
+        for (size_t index = 0; index < capacity; index++)
+            if (control[index] >= 0) slots[index].~Slot();
+    }
+
+public:
+
+    FlatTable() = default;
+
+    FlatTable(const FlatTable &other) : hasher(other.hasher), equal(other.equal) {
+        if (!other.numKeys) return;
+        reserve(other.numKeys);
+        for (size_t index = 0; index < other.capacity; index++)
+            if (other.control[index] >= 0)
+                place(KeyOf()(other.slots[index]), other.slots[index]);
+    }
+
+    FlatTable(FlatTable &&other) noexcept: control(other.control), slots(other.slots), capacity(other.capacity),
+                                           numKeys(other.numKeys), growthLeft(other.growthLeft),
+                                           hasher(move(other.hasher)), equal(move(other.equal)) {
+        other.control = nullptr;
+        other.slots = nullptr;
+        other.capacity = other.numKeys = other.growthLeft = 0;
+    }
+
+    FlatTable &operator=(FlatTable other) noexcept {
+        swap(other);
+        return *this;
+    }
+
+    ~FlatTable() {
+        destroy();
+        ::operator delete(control);
+        ::operator delete(slots);
+    }
+
+    /** @brief Exchanges the keys of two tables.
+     *
+     * @param other Of FlatTable type, by reference.
+     * @return Void.
+     */
+    void swap(FlatTable &other) noexcept {
+        std::swap(control, other.control);
+        std::swap(slots, other.slots);
+        std::swap(capacity, other.capacity);
+        std::swap(numKeys, other.numKeys);
+        std::swap(growthLeft, other.growthLeft);
+        std::swap(hasher, other.hasher);
+        std::swap(equal, other.equal);
+    }
+
+    iterator begin() {
+        iterator first(this, 0);
+        first.skip();
+        return first;
+    }
+
+    iterator end() {
+        return iterator(this, capacity);
+    }
+
+    const_iterator begin() const {
+        const_iterator first(this, 0);
+        first.skip();
+        return first;
+    }
+
+    const_iterator end() const {
+        return const_iterator(this, capacity);
+    }
+
+    /** @brief Returns the number of keys.
+     *
+     * @return size_t.
+     */
+    size_t size() const {
+        return numKeys;
+    }
+
+    /** @brief Returns true if there are no keys.
+     *
+     * @return bool.
+     */
+    bool empty() const {
+        return !numKeys;
+    }
+
+    /** @brief Returns the number of bytes the slots and their control bytes take.
+     *
+     * @return size_t.
+     */
+    size_t bytes() const {
+        return capacity ? capacity * sizeof(Slot) + controlBytes(capacity) : 0;
+    }
+
+    /** @brief Makes room for a number of keys, so inserting them does not move the others.
+     *
+     * @param keys Of size_t type.
+     * @return Void.
+     */
+    void reserve(size_t keys) {
+        size_t newCapacity = capacityFor(max(keys, numKeys));
+        if (newCapacity > capacity) rehash(newCapacity);
+    }
+
+    /** @brief Returns the slot holding a key.
+     *
+     * @param key Of const Key type, by reference.
+     * @return iterator, end() if no slot holds it.
+     */
+    iterator find(const Key &key) {
+        return iterator(this, locate(key, hashOf(key)));
+    }
+
+    /** @brief Returns the slot holding a key.
+     *
+     * @param key Of const Key type, by reference.
+     * @return const_iterator, end() if no slot holds it.
+     */
+    const_iterator find(const Key &key) const {
+        return const_iterator(this, locate(key, hashOf(key)));
+    }
+
+    /** @brief Returns the number of slots holding a key.
+     *
+     * @param key Of const Key type, by reference.
+     * @return size_t, 1 or 0.
+     */
+    size_t count(const Key &key) const {
+        return locate(key, hashOf(key)) != capacity;
+    }
+
+    /** @brief Removes a key, marking its slot as deleted.
+     *
+     * @param key Of const Key type, by reference.
+     * @return size_t, the number of keys removed, 1 or 0.
+     */
+    size_t erase(const Key &key) {
+        size_t index = locate(key, hashOf(key));
+        if (index == capacity) return 0;
+        slots[index].~Slot();
+        control[index] = FlatGroup::DELETED;
+        numKeys--;
+        return 1;
+    }
+
+    /** @brief Removes every key, keeping the slots for new ones.
+     *
+     * @return Void.
+     */
+    void clear() {
+        destroy();
+        if (capacity) memset(control, FlatGroup::EMPTY, capacity);
+        numKeys = 0;
+        growthLeft = maxLoad(capacity);
+    }
+};
+
+/** @brief FlatSet class to represent a set of keys in a flat table.
+ *
+ *  Iterating goes through the array of slots, so the order depends only on the hashes and the insertions.
+ *
+ * @tparam Key the type of the keys.
+ * @tparam Hash a functor hashing a key, std::hash by default.
+ * @tparam Equal a functor comparing two keys, std::equal_to by default.
+ */
+template<typename Key, typename Hash = hash<Key>, typename Equal = equal_to<Key>>
+class FlatSet : public FlatTable<Key, Key, FlatSetKey, Hash, Equal, false> {
+
+    typedef FlatTable<Key, Key, FlatSetKey, Hash, Equal, false> Table;
+
+public:
+
+    typedef typename Table::iterator iterator;
+
+    typedef typename Table::const_iterator const_iterator;
+
+    FlatSet() = default;
+
+    FlatSet(initializer_list<Key> keys) {
+        this->reserve(keys.size());
+        for (const Key &key: keys) insert(key);
+    }
+
+    /** @brief Inserts a key, if it is not there yet.
+     *
+     * @param key Of const Key type, by reference.
+     * @return pair<iterator, bool> with the slot holding the key and true if it was inserted.
+     */
+    pair<iterator, bool> insert(const Key &key) {
+        pair<size_t, bool> placed = this->place(key, key);
+        return {iterator(this, placed.first), placed.second};
+    }
+
+    /** @brief Inserts the keys of a range, if they are not there yet.
+     *
+     * @param first Of Iterator type.
+     * @param last Of Iterator type.
+     * @return Void.
+     */
+    template<typename Iterator>
+    void insert(Iterator first, Iterator last) {
+        for (; first != last; ++first) insert(*first);
+    }
+};
+
+/** @brief FlatMap class to represent a map from keys to values in a flat table.
+ *
+ *  The slots are pairs of a key and a value, as in unordered_map, so the values move when the table grows.
+ *
+ * @tparam Key the type of the keys.
+ * @tparam Value the type of the values.
+ * @tparam Hash a functor hashing a key, std::hash by default.
+ * @tparam Equal a functor comparing two keys, std::equal_to by default.
+ */
+template<typename Key, typename Value, typename Hash = hash<Key>, typename Equal = equal_to<Key>>
+class FlatMap : public FlatTable<Key, pair<const Key, Value>, FlatMapKey, Hash, Equal, true> {
+
+    typedef FlatTable<Key, pair<const Key, Value>, FlatMapKey, Hash, Equal, true> Table;
+
+public:
+
+    typedef pair<const Key, Value> value_type;
+
+    typedef typename Table::iterator iterator;
+
+    typedef typename Table::const_iterator const_iterator;
+
+    /** @brief Inserts a key and its value, if the key is not there yet.
+     *
+     * @param slot Of const value_type type, by reference.
+     * @return pair<iterator, bool> with the slot holding the key and true if it was inserted.
+     */
+    pair<iterator, bool> insert(const value_type &slot) {
+        pair<size_t, bool> placed = this->place(slot.first, slot);
+        return {iterator(this, placed.first), placed.second};
+    }
+
+    /** @brief Inserts a key and a value built from the arguments, if the key is not there yet.
+     *
+     * @param key Of const Key type, by reference.
+     * @param args Of Args type, the arguments of the constructor of the value.
+     * @return pair<iterator, bool> with the slot holding the key and true if it was inserted.
+     */
+    template<typename... Args>
+    pair<iterator, bool> emplace(const Key &key, Args &&... args) {
+        pair<size_t, bool> placed = this->place(key, piecewise_construct, forward_as_tuple(key),
+                                                forward_as_tuple(forward<Args>(args)...));
+        return {iterator(this, placed.first), placed.second};
+    }
+
+    /** @brief Returns the value of a key, inserting a default one if the key is not there yet.
+     *
+     * @param key Of const Key type, by reference.
+     * @return Value, by reference.
+     */
+    Value &operator[](const Key &key) {
+        return emplace(key).first->second;
+    }
+
+    /** @brief Returns the value of a key.
+     *
+     * @param key Of const Key type, by reference.
+     * @return read-only reference to the Value.
+     * @throws out_of_range if the key is not there.
+     */
+    const Value &at(const Key &key) const {
+        const_iterator found = this->find(key);
+        if (found == this->end()) throw out_of_range("FlatMap::at");
+        return found->second;
+    }
+};
+
+#endif //AED_FEUP_PROJ_2_22_23_FLATHASH_H
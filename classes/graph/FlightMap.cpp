@@ -6,58 +6,124 @@
 
 #include "FlightMap.h"
 #include <algorithm>
+#include <climits>
 #include <stack>
 #include <string>
+#include "Constraints/Constraints.h"
+#include "../Scheduler/Scheduler.h"
+#include "../Instrumentation/Instrumentation.h"
+
+//! @brief Defines how many airports a task of the diameter searches from.
+static const int DIAMETER_GRAIN = 8;
+
+/** @brief Calls a function with each flight leaving an airport that a plan looks at, in the order of the airport's flights.
+ *
+ * @param airport Of const AirportPTR type, by reference.
+ * @param plan Of const FlightPlan type, by reference.
+ * @param airlines Of const AirlineFilter type, by reference, tested when the plan looks at every flight.
+ * @param traversal Of Traversal type, by reference, that counts the flights looked at.
+ * @param function Of Function type, called with each flight, returning false to stop.
+ * @return bool false if the function stopped.
+ */
+template<typename Function>
+static bool forEachFlight(const AirportPTR &airport, const FlightPlan &plan, const AirlineFilter &airlines,
+                          Traversal &traversal, Function function) {
+    if (!plan.useSubgraphs) {
+        traversal.relax(airport->flights);
+        for (const Flight &flight: airport->flights)
+            if (airlines[flight.airline] && !function(flight))
+                return false;
+        return true;
+    }
+
+    // The subgraphs point into the flights of the airport, in their order, so the next flight is the lowest pointer.
+    const Flight *const *next[FlightPlan::MAX_SUBGRAPHS];
+    const Flight *const *last[FlightPlan::MAX_SUBGRAPHS];
+    int numSubgraphs = plan.subgraphs.size();
+    for (int i = 0; i < numSubgraphs; i++) {
+        next[i] = plan.subgraphs[i]->flightsBegin(airport->id);
+        last[i] = plan.subgraphs[i]->flightsEnd(airport->id);
+        traversal.relax(last[i] - next[i]);
+    }
+    while (true) {
+        int lowest = -1;
+        for (int i = 0; i < numSubgraphs; i++)
+            if (next[i] != last[i] && (lowest == -1 || *next[i] < *next[lowest]))
+                lowest = i;
+        if (lowest == -1) return true;
+        if (!function(**next[lowest]++)) return false;
+    }
+}
 
 FlightMap::FlightMap() {}
 
-void FlightMap::setAirports(const unordered_map<string, AirportPTR> airports) {
+void FlightMap::setAirports(const vector<AirportPTR> &airports, const vector<int> &inputOrder) {
     this->airports = airports;
+    this->inputOrder = inputOrder;
+    if (inputOrder.empty())
+        for (const AirportPTR &airport: airports)
+            this->inputOrder.push_back(airport->id);
+    for (const AirportPTR &airport: airports)
+        airportIds.set(airport->code, airport->id);
+    routeGraph.build(airports);
 }
 
-unordered_map<string, AirportPTR> FlightMap::getAirports() {
+const vector<AirportPTR> &FlightMap::getAirports() const {
     return airports;
 }
 
-void FlightMap::setAirportsPerCity(AirportsPerCity_Set airportsPerCity) {
+const RouteGraph &FlightMap::getRouteGraph() const {
+    return routeGraph;
+}
+
+AirportPTR FlightMap::getAirport(const string &code) const {
+    int id = airportIds.get(code);
+    return id == -1 ? nullptr : airports[id];
+}
+
+void FlightMap::setAirportsPerCity(const AirportsPerCity_Set &airportsPerCity) {
     this->airportsPerCity = airportsPerCity;
 }
 
-AirportsPerCity_Set FlightMap::getAirportsPerCity() {
+const AirportsPerCity_Set &FlightMap::getAirportsPerCity() const {
     return airportsPerCity;
 }
 
-int
-FlightMap::minimumDistance(AirportPTR airportDepart, AirportPTR airportDestination, unordered_set<string> airlines) {
-    for (auto pair: airports) {
-        AirportPTR airport = pair.second;
-        airport->visited = false;
-        airport->dist = 0;
-    }
+int FlightMap::minimumDistance(AirportPTR airportDepart, AirportPTR airportDestination,
+                               const AirlineFilter &airlines, Traversal &traversal, const FlightPlan &plan) const {
+    traversal.reset();
 
-    queue<AirportPTR> unvisitedAirports;
-    unvisitedAirports.push(airportDepart);
-    airportDepart->visited = true;
+    queue<int> unvisitedAirports;
+    unvisitedAirports.push(airportDepart->id);
+    traversal.visit(airportDepart->id);
 
     while (!unvisitedAirports.empty()) {
-        AirportPTR previousAirport = unvisitedAirports.front();
+        int previousAirport = unvisitedAirports.front();
         unvisitedAirports.pop();
 
-        for (auto flight: previousAirport->flights) {
+        if (plan.useSubgraphs) {
+            bool found = !forEachFlight(airports[previousAirport], plan, airlines, traversal, [&](const Flight &flight) {
+                if (traversal.isVisited(flight.destination)) return true;
+                traversal.visit(flight.destination, previousAirport);
+                unvisitedAirports.push(flight.destination);
+                return flight.destination != airportDestination->id;
+            });
+            if (found) return traversal.dist[airportDestination->id];
+            continue;
+        }
 
-            AirportPTR destination = airports[flight.destinationCode];
+        RouteSpan routes = routeGraph.getRoutes(previousAirport);
+        traversal.relax(routes);
+        for (const Route &route: routes) {
 
-            if (airlines.find(flight.airlineCode) == airlines.end())
+            if (traversal.isVisited(route.destination) || !routeGraph.allows(route, airlines))
                 continue;
 
-            if (!destination->visited) {
-                destination->dist = previousAirport->dist + 1;
-                unvisitedAirports.push(destination);
-                destination->visited = true;
+            traversal.visit(route.destination, previousAirport);
+            unvisitedAirports.push(route.destination);
 
-                if (flight.destinationCode == airportDestination->code)
-                    return destination->dist;
-            }
+            if (route.destination == airportDestination->id)
+                return traversal.dist[route.destination];
         }
     }
     return -1;
@@ -65,272 +131,384 @@ FlightMap::minimumDistance(AirportPTR airportDepart, AirportPTR airportDestinati
 
 list<list<Flight>> FlightMap::getTrajectories(AirportPTR airportDepart,
                                               AirportPTR airportDestination,
-                                              unordered_set<string> airlines,
-                                              int minimumFlights) {
+                                              const AirlineFilter &airlines,
+                                              int minimumFlights, Traversal &traversal,
+                                              const FlightPlan &plan) const {
 
     list<list<Flight>> paths;
+    traversal.reset();
 
-    for (auto pair: airports) {
-        AirportPTR airport = pair.second;
-        airport->visited = false;
-        airport->path = {};
-        airport->dist = 0;
-    }
-
-    queue<AirportPTR> unvisitedAirports;
-    unvisitedAirports.push(airportDepart);
-    airportDepart->visited = true;
-    airportDepart->dist = 0;
+    queue<int> unvisitedAirports;
+    unvisitedAirports.push(airportDepart->id);
+    traversal.visit(airportDepart->id);
 
     while (!unvisitedAirports.empty()) {
-        AirportPTR previousAirport = unvisitedAirports.front();
+        int previousAirport = unvisitedAirports.front();
         unvisitedAirports.pop();
 
-        for (auto flight: previousAirport->flights) {
-            AirportPTR destination = airports[flight.destinationCode];
-
-            if (airlines.find(flight.airlineCode) == airlines.end())
-                continue;
+        forEachFlight(airports[previousAirport], plan, airlines, traversal, [&](const Flight &flight) {
 
-            if (flight.destinationCode == airportDestination->code) {
-                destination->path = previousAirport->path;
-                destination->path.push_back(flight);
-                paths.push_back(destination->path);
+            if (flight.destination == airportDestination->id) {
+                list<Flight> path = traversal.getPath(previousAirport);
+                path.push_back(flight);
+                paths.push_back(path);
             }
 
-            if (!destination->visited) {
-
-                destination->visited = true;
-                if (previousAirport->dist + 1 >= minimumFlights)
-                    continue;
+            if (!traversal.isVisited(flight.destination)) {
 
-                unvisitedAirports.push(destination);
-                destination->dist = previousAirport->dist + 1;
-                destination->path = previousAirport->path;
-                destination->path.push_back(flight);
+                traversal.visit(flight.destination, previousAirport, flight);
+                if (traversal.dist[flight.destination] < minimumFlights)
+                    unvisitedAirports.push(flight.destination);
             }
-
-        }
+            return true;
+        });
     }
     return paths;
 }
 
 list<pair<AirportPTR, list<Flight>>> FlightMap::getFlights(LocalPTR origin,
                                                            LocalPTR destination,
-                                                           unordered_set<string> airlines) {
+                                                           const AirlineFilter &airlines,
+                                                           const FlightPlan &plan) const {
+    INSTRUMENT_SCOPE("query/getFlights");
 
     list<pair<AirportPTR, list<Flight>>> trajectoriesPairs;
-    int minimum;
+    vector<pair<AirportPTR, AirportPTR>> pairs;
+    {
+        INSTRUMENT_SCOPE("query/getFlights/getAirports");
+        const list<AirportPTR> originAirports = origin->getAirports(this);
+        const list<AirportPTR> destinationAirports = destination->getAirports(this);
+
+        for (const AirportPTR &originAirport: originAirports)
+            for (const AirportPTR &destAirport: destinationAirports)
+                pairs.emplace_back(originAirport, destAirport);
+
+        // Results are cached by the sets of airports, so the pairs go in an order that does not depend on the locals.
+        sort(pairs.begin(), pairs.end(), [](const auto &a, const auto &b) {
+            return make_pair(a.first->id, a.second->id) < make_pair(b.first->id, b.second->id);
+        });
+    }
 
-    for (const AirportPTR &originAirport: origin->getAirports(this))
-        for (const AirportPTR &destAirport: destination->getAirports(this)) {
-            int foundMinimum = minimumDistance(originAirport, destAirport, airlines);
+    Scheduler &scheduler = Scheduler::global();
+    vector<int> minimums(pairs.size());
+    {
+        INSTRUMENT_SCOPE("query/getFlights/minimumDistance");
+        scheduler.parallelFor(0, pairs.size(), 1, [&](int first, int last) {
+            Traversal traversal(airports.size());
+            for (int i = first; i < last; i++)
+                minimums[i] = minimumDistance(pairs[i].first, pairs[i].second, airlines, traversal, plan);
+        });
+    }
 
-            if (foundMinimum < minimum && foundMinimum != -1)
-                minimum = foundMinimum;
-        }
+    int minimum = INT_MAX;
+    for (int foundMinimum: minimums)
+        if (foundMinimum < minimum && foundMinimum != -1)
+            minimum = foundMinimum;
+
+    vector<list<list<Flight>>> trajectories(pairs.size());
+    {
+        INSTRUMENT_SCOPE("query/getFlights/getTrajectories");
+        scheduler.parallelFor(0, pairs.size(), 1, [&](int first, int last) {
+            Traversal traversal(airports.size());
+            for (int i = first; i < last; i++)
+                trajectories[i] = getTrajectories(pairs[i].first, pairs[i].second, airlines, minimum, traversal,
+                                                  plan);
+        });
+    }
 
-    for (const AirportPTR &originAirport: origin->getAirports(this))
-        for (const AirportPTR &destAirport: destination->getAirports(this)) {
-            auto trajectories = getTrajectories(originAirport,
-                                                destAirport, airlines, minimum);
-            for (const auto &trajectory: trajectories)
-                trajectoriesPairs.push_back(make_pair(originAirport, trajectory));
-        }
+    for (size_t i = 0; i < pairs.size(); i++)
+        for (const auto &trajectory: trajectories[i])
+            trajectoriesPairs.push_back(make_pair(pairs[i].first, trajectory));
 
     return trajectoriesPairs;
 }
 
-unordered_set<AirportPTR> FlightMap::reachableAirports(AirportPTR airportPtr, int y) {
+list<list<Flight>> FlightMap::getConstrainedTrajectories(AirportPTR airportDepart,
+                                                         AirportPTR airportDestination,
+                                                         const Constraints &constraints,
+                                                         Traversal &traversal, const FlightPlan &plan) const {
+    list<list<Flight>> paths;
+    traversal.reset();
+    if (!constraints.allows(airportDepart->id) || !constraints.allows(airportDestination->id))
+        return paths;
+
+    // A state is an airport, the flights taken up to the minimum and, if there is a via airport, whether it was seen.
+    int numAirports = airports.size(), via = constraints.getVia(), viaPhases = via == -1 ? 1 : 2;
+    int minimumFlights = constraints.getMinimumFlights(), maximumFlights = constraints.getMaximumFlights();
+    auto stateOf = [&](int airport, int flights, bool seen) {
+        return (min(flights, minimumFlights) * viaPhases + seen) * numAirports + airport;
+    };
+
+    queue<int> unvisitedStates;
+    int start = stateOf(airportDepart->id, 0, airportDepart->id == via);
+    unvisitedStates.push(start);
+    traversal.visit(start);
+
+    int found = INT_MAX;
+    while (!unvisitedStates.empty()) {
+        int previousState = unvisitedStates.front();
+        unvisitedStates.pop();
+
+        int previousAirport = previousState % numAirports, flights = traversal.dist[previousState] + 1;
+        bool seen = via == -1 || previousState / numAirports % viaPhases;
+        if (flights > maximumFlights || flights > found)
+            break;
+
+        forEachFlight(airports[previousAirport], plan, constraints.getAirlines(), traversal, [&](const Flight &flight) {
+
+            if (!constraints.allows(flight.destination))
+                return true;
+
+            bool reached = seen || flight.destination == via;
+            if (flight.destination == airportDestination->id && reached && flights >= minimumFlights) {
+                list<Flight> path = traversal.getPath(previousState);
+                path.push_back(flight);
+                paths.push_back(path);
+                found = flights;
+            }
 
-    for (auto pair: airports) {
-        AirportPTR airport = pair.second;
-        airport->visited = false;
-        airport->dist = 0;
+            int state = stateOf(flight.destination, flights, via != -1 && reached);
+            if (!traversal.isVisited(state)) {
+                traversal.visit(state, previousState, flight);
+                unvisitedStates.push(state);
+            }
+            return true;
+        });
     }
+    return paths;
+}
+
+list<pair<AirportPTR, list<Flight>>> FlightMap::getConstrainedFlights(LocalPTR origin,
+                                                                      LocalPTR destination,
+                                                                      const Constraints &constraints,
+                                                                      const FlightPlan &plan) const {
+    INSTRUMENT_SCOPE("query/getConstrainedFlights");
+
+    vector<pair<AirportPTR, AirportPTR>> pairs;
+    for (const AirportPTR &originAirport: origin->getAirports(this))
+        for (const AirportPTR &destAirport: destination->getAirports(this))
+            pairs.emplace_back(originAirport, destAirport);
+
+    vector<list<list<Flight>>> trajectories(pairs.size());
+    Scheduler::global().parallelFor(0, pairs.size(), 1, [&](int first, int last) {
+        Traversal traversal(airports.size() * constraints.getPhases());
+        for (int i = first; i < last; i++)
+            trajectories[i] = getConstrainedTrajectories(pairs[i].first, pairs[i].second, constraints, traversal,
+                                                         plan);
+    });
+
+    int minimum = INT_MAX;
+    for (const list<list<Flight>> &paths: trajectories)
+        if (!paths.empty() && (int) paths.front().size() < minimum)
+            minimum = paths.front().size();
+
+    list<pair<AirportPTR, list<Flight>>> trajectoriesPairs;
+    for (size_t i = 0; i < pairs.size(); i++)
+        for (const auto &trajectory: trajectories[i])
+            if ((int) trajectory.size() == minimum)
+                trajectoriesPairs.push_back(make_pair(pairs[i].first, trajectory));
+
+    return trajectoriesPairs;
+}
 
-    queue<AirportPTR> airportsToVisit;
-    unordered_set<AirportPTR> reachableAirports;
-    airportsToVisit.push(airportPtr);
-    airportPtr->visited = true;
+Airports_Set FlightMap::reachableAirports(AirportPTR airportPtr, int y, Traversal &traversal) const {
+    traversal.reset();
+
+    queue<int> airportsToVisit;
+    Airports_Set reachableAirports;
+    airportsToVisit.push(airportPtr->id);
+    traversal.visit(airportPtr->id);
 
     while (!airportsToVisit.empty()) {
-        auto previousAirport = airportsToVisit.front();
+        int previousAirport = airportsToVisit.front();
         airportsToVisit.pop();
 
-        for (auto flight: previousAirport->flights) {
-            auto destination = airports[flight.destinationCode];
+        RouteSpan routes = routeGraph.getRoutes(previousAirport);
+        traversal.relax(routes);
+        for (const Route &route: routes) {
 
-            if (destination->visited)
+            if (traversal.isVisited(route.destination))
                 continue;
 
-            destination->dist = previousAirport->dist + 1;
-
-            if (destination->dist > y)
+            if (traversal.dist[previousAirport] + 1 > y)
                 return reachableAirports;
 
-            airportsToVisit.push(destination);
-            reachableAirports.insert(destination);
-            destination->visited = true;
+            traversal.visit(route.destination, previousAirport);
+            airportsToVisit.push(route.destination);
+            reachableAirports.insert(airports[route.destination]);
         }
     }
     return reachableAirports;
 }
 
-unordered_set<AirportPTR> FlightMap::airportsWithMaxYFlights(LocalPTR origin, int y) {
+vector<Airports_Set> FlightMap::reachableFromEach(const list<AirportPTR> &origins, int y) const {
+    INSTRUMENT_SCOPE("query/reachableFromEach");
+    vector<AirportPTR> originAirports(origins.begin(), origins.end());
+    vector<Airports_Set> reachable(originAirports.size());
+
+    Scheduler::global().parallelFor(0, originAirports.size(), 1, [&](int first, int last) {
+        Traversal traversal(airports.size());
+        for (int i = first; i < last; i++)
+            reachable[i] = reachableAirports(originAirports[i], y, traversal);
+    });
+    return reachable;
+}
+
+Airports_Set FlightMap::airportsWithMaxYFlights(LocalPTR origin, int y) const {
+    INSTRUMENT_SCOPE("query/airportsWithMaxYFlights");
 
-    unordered_set<AirportPTR> airports;
+    vector<Airports_Set> reachableSets = reachableFromEach(origin->getAirports(this), y);
+    if (reachableSets.size() == 1) return move(reachableSets.front());
 
-    for (AirportPTR airport: origin->getAirports(this)) {
+    size_t bound = 0;
+    for (const auto &reachable: reachableSets)
+        bound += reachable.size();
+    Airports_Set airports;
+    airports.reserve(bound);
 
-        for (AirportPTR destination: reachableAirports(airport, y)) {
+    for (const auto &reachable: reachableSets) {
+
+        for (const AirportPTR &destination: reachable) {
             airports.insert(destination);
         }
     }
     return airports;
 }
 
-unordered_set<City, City::hashFunction> FlightMap::citiesWithMaxYFlights(LocalPTR origin, int y){
-    unordered_set<City, City::hashFunction> cities;
+Cities_Set FlightMap::citiesWithMaxYFlights(LocalPTR origin, int y) const {
+    INSTRUMENT_SCOPE("query/citiesWithMaxYFlights");
+    Cities_Set cities;
 
-    for (AirportPTR airport: origin->getAirports(this)) {
-        for (AirportPTR destination: reachableAirports(airport, y)) {
-            City city = {destination->city, destination->country};
-            cities.insert(city);
+    for (const auto &reachable: reachableFromEach(origin->getAirports(this), y)) {
+        for (const AirportPTR &destination: reachable) {
+            cities.insert(City(destination->city, destination->country));
         }
     }
     return cities;
 }
 
-unordered_set<string> FlightMap::countriesWithMaxYFlights(LocalPTR origin, int y){
-    unordered_set<string> countriesNames;
+FlatSet<int> FlightMap::countriesWithMaxYFlights(LocalPTR origin, int y) const {
+    INSTRUMENT_SCOPE("query/countriesWithMaxYFlights");
+    FlatSet<int> countries;
 
-    for (AirportPTR airport: origin->getAirports(this)) {
-        auto airports = reachableAirports(airport, y);
-        for (AirportPTR destination: airports) {
-            string country = destination->country;
-            countriesNames.insert(country);
+    for (const auto &reachable: reachableFromEach(origin->getAirports(this), y)) {
+        for (const AirportPTR &destination: reachable) {
+            countries.insert(destination->country);
         }
     }
-    return countriesNames;
+    return countries;
 }
 
-void FlightMap::dfsArticulationPoints(AirportPTR airport, int &index,
-                                      stack<AirportPTR> &stack, list<AirportPTR> &answer) {
-    airport->visited = true;
-    airport->num = airport->low = index++;
+void FlightMap::dfsArticulationPoints(int airport, int &index, stack<int> &stack,
+                                      list<AirportPTR> &answer, Traversal &traversal) const {
+    traversal.visit(airport);
+    traversal.num[airport] = traversal.low[airport] = index++;
     stack.push(airport);
-    airport->inStack = true;
+    traversal.inStack[airport] = true;
 
     int children = 0;
     bool articulation = false;
 
-    for (Flight e: airport->flights) {
-        string w = e.destinationCode;
-        AirportPTR destination = airports[w];
-        if (destination->visited == false) {
+    RouteSpan routes = routeGraph.getRoutes(airport);
+    traversal.relax(routes);
+    for (const Route &route: routes) {
+        int destination = route.destination;
+        if (!traversal.isVisited(destination)) {
             children++;
-            dfsArticulationPoints(destination, index, stack, answer);
-            airport->low = min(airport->low, destination->low);
-            if (destination->low >= airport->num) articulation = true;
-        } else if (airports[w]->inStack) {
-            airport->low = min(airport->low, destination->num);
+            dfsArticulationPoints(destination, index, stack, answer, traversal);
+            traversal.low[airport] = min(traversal.low[airport], traversal.low[destination]);
+            if (traversal.low[destination] >= traversal.num[airport]) articulation = true;
+        } else if (traversal.inStack[destination]) {
+            traversal.low[airport] = min(traversal.low[airport], traversal.num[destination]);
         }
     }
-    if ((airport->num == 1 && children > 1) || (airport->num > 1 && articulation)) {
-        AirportPTR w;
+    if ((traversal.num[airport] == 1 && children > 1) || (traversal.num[airport] > 1 && articulation)) {
+        int w;
         do {
             w = stack.top();
             stack.pop();
-            airport->inStack = false;
+            traversal.inStack[airport] = false;
         } while (w != airport);
-        answer.push_front(w);
+        answer.push_front(airports[w]);
     }
 }
 
-list<AirportPTR> FlightMap::articulationPoints() {
+list<AirportPTR> FlightMap::articulationPoints() const {
+    INSTRUMENT_SCOPE("query/articulationPoints");
     list<AirportPTR> answer;
-    for (auto pair: airports) {
-        AirportPTR airport = pair.second;
-        airport->visited = false;
-        airport->low = 0;
-        airport->num = 0;
-        airport->inStack = false;
-    }
+    Traversal traversal(airports.size());
 
     int index = 1;
-    stack<AirportPTR> stack;
-    for (auto pair: airports) {
-        AirportPTR airport = pair.second;
-        if (airport->visited == false) {
-            dfsArticulationPoints(airport, index, stack, answer);
+    stack<int> stack;
+    for (int airport: inputOrder) {
+        if (!traversal.isVisited(airport)) {
+            dfsArticulationPoints(airport, index, stack, answer, traversal);
         }
     }
     return answer;
 }
 
-void FlightMap::diameterBFS(AirportPTR airportDepart, int &diameter) {
-    for (auto pair: airports) {
-        AirportPTR airport = pair.second;
-        airport->visited = false;
-        airport->dist = 0;
-    }
+void FlightMap::diameterBFS(AirportPTR airportDepart, int &diameter, Traversal &traversal) const {
+    traversal.reset();
 
-    queue<AirportPTR> unvisitedAirports;
-    unvisitedAirports.push(airportDepart);
-    airportDepart->visited = true;
+    queue<int> unvisitedAirports;
+    unvisitedAirports.push(airportDepart->id);
+    traversal.visit(airportDepart->id);
 
     while (!unvisitedAirports.empty()) {
-        AirportPTR previousAirport = unvisitedAirports.front();
+        int previousAirport = unvisitedAirports.front();
         unvisitedAirports.pop();
 
-        for (auto flight: previousAirport->flights) {
+        RouteSpan routes = routeGraph.getRoutes(previousAirport);
+        traversal.relax(routes);
+        for (const Route &route: routes) {
 
-            AirportPTR destination = airports[flight.destinationCode];
-
-            if (!destination->visited) {
-                destination->dist = previousAirport->dist + 1;
-                if (destination->dist > diameter) {
-                    diameter = destination->dist;
+            if (!traversal.isVisited(route.destination)) {
+                traversal.visit(route.destination, previousAirport);
+                if (traversal.dist[route.destination] > diameter) {
+                    diameter = traversal.dist[route.destination];
                 }
-                unvisitedAirports.push(destination);
-                destination->visited = true;
+                unvisitedAirports.push(route.destination);
             }
         }
     }
 }
 
-int FlightMap::diameter() {
-    int diameter = INT_MIN;
-
-    AirportPTR startAirport = airports.begin()->second;
-    AirportPTR furthestAirport;
-
-    for (auto pair: airports) {
-        AirportPTR airport = pair.second;
-        diameterBFS(airport, diameter);
-    }
-    return diameter;
+int FlightMap::diameter() const {
+    INSTRUMENT_SCOPE("query/diameter");
+    int numAirports = airports.size();
+    vector<int> diameters((numAirports + DIAMETER_GRAIN - 1) / DIAMETER_GRAIN, INT_MIN);
+
+    // Each chunk of airports keeps its own maximum, so the searches share nothing while they run.
+    Scheduler::global().parallelFor(0, diameters.size(), 1, [&](int first, int last) {
+        Traversal traversal(airports.size());
+        for (int chunk = first; chunk < last; chunk++)
+            for (int id = chunk * DIAMETER_GRAIN; id < min(numAirports, (chunk + 1) * DIAMETER_GRAIN); id++) {
+                diameterBFS(airports[id], diameters[chunk], traversal);
+            }
+    });
+    return diameters.empty() ? INT_MIN : *max_element(diameters.begin(), diameters.end());
 }
 
-void FlightMap::dfs(AirportPTR airport) {
-    airport->visited = true;
-    for (Flight flight: airport->flights) {
-        AirportPTR destination = airports[flight.destinationCode];
-        if (!destination->visited)
-            dfs(destination);
+void FlightMap::dfs(int airport, Traversal &traversal) const {
+    traversal.visit(airport);
+    RouteSpan routes = routeGraph.getRoutes(airport);
+    traversal.relax(routes);
+    for (const Route &route: routes) {
+        if (!traversal.isVisited(route.destination))
+            dfs(route.destination, traversal);
     }
 }
 
-int FlightMap::connectedComponents() {
+int FlightMap::connectedComponents() const {
+    INSTRUMENT_SCOPE("query/connectedComponents");
     int counter = 0;
-    for (auto pair: airports)
-        pair.second->visited = false;
+    Traversal traversal(airports.size());
 
-    for (auto pair: airports)
-        if (!pair.second->visited) {
+    for (int airport: inputOrder)
+        if (!traversal.isVisited(airport)) {
             counter++;
-            dfs(pair.second);
+            dfs(airport, traversal);
         }
     return counter;
-}
\ No newline at end of file
+}
@@ -16,23 +16,50 @@
 #include "Airport/Airport.h"
 #include "Locals/Local.h"
 #include "City/City.h"
+#include "Code/Code.h"
+#include "Traversal/Traversal.h"
+#include "RouteGraph/RouteGraph.h"
+#include "AirlineSubgraph/AirlineSubgraph.h"
+#include "../FlatHash/FlatHash.h"
 
 using namespace std;
 
+//! @brief Redefinition of the name for ease of use: a set of airports, hashed by id so it is iterated in the same order every run.
+typedef FlatSet<AirportPTR, Airport::hashFunction> Airports_Set;
+
+//! @brief Redefinition of the name for ease of use.
+typedef FlatSet<City, City::hashFunction> Cities_Set;
+
 //! @brief Redefinition of the name for ease of use.
-typedef unordered_map<City,  unordered_set<AirportPTR, Airport::hashFunction>, City::hashFunction> AirportsPerCity_Set;
+typedef FlatMap<City, Airports_Set, City::hashFunction> AirportsPerCity_Set;
+
+//! @brief Redefinition of the name for ease of use: the airlines allowed in a search, indexed by airline id.
+typedef vector<bool> AirlineFilter;
+
+class Constraints;
 
 /** @brief FlightMap class to represent a flight map and all implementations that uses a graph directly.
  *
+ *  Once set up, a flight map is only read: the searches keep their state in a Traversal,
+ *  so they can run on several threads at once.
  */
 class FlightMap {
 
-    //! @brief Holds all airports.
-    unordered_map<string,  AirportPTR> airports;
+    //! @brief Holds all airports, indexed by their id.
+    vector<AirportPTR> airports;
+
+    //! @brief Holds the id of each airport, indexed by its code.
+    CodeTable<int> airportIds{-1};
+
+    //! @brief Holds the ids of the airports in the order of the input file.
+    vector<int> inputOrder;
 
     //! @brief Holds the airports per city.
     AirportsPerCity_Set airportsPerCity;
 
+    //! @brief Holds the flights collapsed into one route per pair of airports, for the searches that need no airline.
+    RouteGraph routeGraph;
+
 public:
 
     /** Create a new FlightMap.
@@ -43,42 +70,64 @@ public:
 
     /** @brief Sets the airports to the given argument.
      *
-     * @param airports of const unordered_map<string,  AirportPTR> type.
+     * The searches that start from every airport in turn start from them in the order of the input file,
+     * so the components and articulation points found do not depend on the order the airports were given ids in.
+     * The route graph is built from the flights of the airports.
+     *
+     * @param airports of const vector<AirportPTR> type, by reference, indexed by id.
+     * @param inputOrder of const vector<int> type, by reference, the ids in the order of the input file, ascending if empty.
      * @return Void.
      */
-    void setAirports(const unordered_map<string,  AirportPTR> airports);
+    void setAirports(const vector<AirportPTR> &airports, const vector<int> &inputOrder = {});
 
     /** @brief Returns the airports.
      *
-     * @return unordered_map<string,  AirportPTR> of airports.
+     * @return read-only reference to the vector<AirportPTR> of airports, indexed by id.
+     */
+    const vector<AirportPTR> &getAirports() const;
+
+    /** @brief Returns the route graph.
+     *
+     * @return read-only reference to the RouteGraph, one route per pair of airports with flights between them.
+     */
+    const RouteGraph &getRouteGraph() const;
+
+    /** @brief Returns the airport with the given code.
+     *
+     * @param code of const string type, by reference.
+     * @return AirportPTR, null if there is no such airport.
      */
-    unordered_map<string,  AirportPTR> getAirports();
+    AirportPTR getAirport(const string &code) const;
 
     /** @brief Returns the airports per city.
      *
-     * @return AirportsPerCity_Set of airports.
+     * @return read-only reference to the AirportsPerCity_Set of airports.
      */
-    AirportsPerCity_Set getAirportsPerCity();
+    const AirportsPerCity_Set &getAirportsPerCity() const;
 
     /** @brief Sets the airportsPerCity to the given argument.
      *
-     * @param airportsPerCity of AirportsPerCity_Set type.
+     * @param airportsPerCity of const AirportsPerCity_Set type, by reference.
      * @return Void.
      */
-    void setAirportsPerCity(AirportsPerCity_Set airportsPerCity);
+    void setAirportsPerCity(const AirportsPerCity_Set &airportsPerCity);
 
     /** @brief Returns the shortest number of flights from a certain airport to another.
      *
-     * It uses BFS algorithm.
-     * Temporal Complexity : O(|A| + |F|), A represents the number
-     * of airports and F represents the number of flights.
+     * It uses BFS algorithm over the routes, a route being taken if any of its airlines is allowed,
+     * or over the flights of the subgraphs of the plan, if it has them.
+     * Temporal Complexity : O(|A| + |R|), A represents the number
+     * of airports and R represents the number of routes.
      *
      * @param airportDepart of AirportPTR type.
      * @param airportDestination of AirportPTR type.
-     * @param airlines of unordered_set<string> type.
+     * @param airlines of const AirlineFilter type, by reference.
+     * @param traversal of Traversal type, by reference.
+     * @param plan of const FlightPlan type, by reference, the flights to look at, every flight if not given.
      * @return One or more lists with the minors airport paths.
      */
-    int minimumDistance(AirportPTR airportDepart, AirportPTR airportDestination, unordered_set<string> airlines);
+    int minimumDistance(AirportPTR airportDepart, AirportPTR airportDestination, const AirlineFilter &airlines,
+                        Traversal &traversal, const FlightPlan &plan = FlightPlan()) const;
 
     /** @brief Returns list with the shortest trajectories.
      *
@@ -88,36 +137,87 @@ public:
      *
      * @param airportDepart of AirportPTR type.
      * @param airportDestination of AirportPTR type.
-     * @param airlines of unordered_set<string> type.
+     * @param airlines of const AirlineFilter type, by reference.
      * @param minimumFlights of int type.
+     * @param traversal of Traversal type, by reference.
+     * @param plan of const FlightPlan type, by reference, the flights to look at, every flight if not given.
      * @return One or more lists with the minors airport paths.
      */
     list<list<Flight>> getTrajectories(AirportPTR airportDepart, AirportPTR airportDestination,
-                                       unordered_set<string> airlines, int minimumFlights);
+                                       const AirlineFilter &airlines, int minimumFlights,
+                                       Traversal &traversal, const FlightPlan &plan = FlightPlan()) const;
 
     /** @brief Represents the minor flights using an specific local.
      *
      * The local can be an airport, a city or a pair of coordinates.
+     * The pairs of origin and destination airports are searched in parallel, and listed by airport ids.
      *
      * @param origin of LocalPTR type.
      * @param destination of LocalPTR type.
-     * @param airlines of unordered_set<string> type.
+     * @param airlines of const AirlineFilter type, by reference.
+     * @param plan of const FlightPlan type, by reference, the flights to look at, every flight if not given.
      * @return list<list<flight>> of flights.
      */
     list<pair<AirportPTR, list<Flight>>> getFlights(LocalPTR origin, LocalPTR destination,
-                                                    unordered_set<string> airlines);
+                                                    const AirlineFilter &airlines,
+                                                    const FlightPlan &plan = FlightPlan()) const;
+
+    /** @brief Returns the trajectories with the fewest flights that respect some constraints.
+     *
+     * It uses BFS algorithm, over states that pair an airport with the number of flights taken,
+     * while under the minimum, and with whether the via airport was passed through.
+     * With a minimum above the fewest flights, a trajectory may pass through an airport twice.
+     * Temporal Complexity : O(P(|A| + |F|)), P represents the number of phases of the constraints,
+     * A represents the number of airports and F represents the number of flights.
+     *
+     * @param airportDepart of AirportPTR type.
+     * @param airportDestination of AirportPTR type.
+     * @param constraints of const Constraints type, by reference.
+     * @param traversal of Traversal type, by reference, with room for the phases of every airport.
+     * @param plan of const FlightPlan type, by reference, the flights to look at, every flight if not given.
+     * @return One or more lists with the minors airport paths.
+     */
+    list<list<Flight>> getConstrainedTrajectories(AirportPTR airportDepart, AirportPTR airportDestination,
+                                                  const Constraints &constraints, Traversal &traversal,
+                                                  const FlightPlan &plan = FlightPlan()) const;
+
+    /** @brief Represents the minor flights using an specific local that respect some constraints.
+     *
+     * The pairs of origin and destination airports are searched in parallel,
+     * and only the trajectories with the fewest flights among all of them are kept.
+     *
+     * @param origin of LocalPTR type.
+     * @param destination of LocalPTR type.
+     * @param constraints of const Constraints type, by reference.
+     * @param plan of const FlightPlan type, by reference, the flights to look at, every flight if not given.
+     * @return list<list<flight>> of flights.
+     */
+    list<pair<AirportPTR, list<Flight>>> getConstrainedFlights(LocalPTR origin, LocalPTR destination,
+                                                               const Constraints &constraints,
+                                                               const FlightPlan &plan = FlightPlan()) const;
 
     /** @brief Represents all airports that can be reachable from another specific one.
      *
      * It uses the BFS algorithm.
-     * Temporal Complexity : O(|A| + |F|), A represents the number
-     * of airports and F represents the number of flights.
+     * Temporal Complexity : O(|A| + |R|), A represents the number
+     * of airports and R represents the number of routes.
      *
      * @param airportPtr of AirportPTR type.
      * @param y of int type.
-     * @return unordered_set<AirportPTR> of airports.
+     * @param traversal of Traversal type, by reference.
+     * @return Airports_Set of airports.
      */
-    unordered_set<AirportPTR> reachableAirports(AirportPTR airportPtr, int y);
+    Airports_Set reachableAirports(AirportPTR airportPtr, int y, Traversal &traversal) const;
+
+    /** @brief Determines the reachable airports from each of the given airports, searching from them in parallel.
+     *
+     * It uses the "reachableAirports" method.
+     *
+     * @param origins of const list<AirportPTR> type, by reference.
+     * @param y of int type.
+     * @return vector<Airports_Set> with the reachable airports of each origin, in the same order.
+     */
+    vector<Airports_Set> reachableFromEach(const list<AirportPTR> &origins, int y) const;
 
     /** @brief Determines the reachable airports, parting from a given local and using a maximum number of flights.
      *
@@ -125,9 +225,9 @@ public:
      *
      * @param origin of LocalPTR type.
      * @param y of int type.
-     * @return set of reachable airports, of type unordered_set<AirportPTR>
+     * @return set of reachable airports, of type Airports_Set
      */
-    unordered_set<AirportPTR> airportsWithMaxYFlights(LocalPTR origin, int y);
+    Airports_Set airportsWithMaxYFlights(LocalPTR origin, int y) const;
 
     /** @brief Determines the reachable cities, parting from a given local and using a maximum number of flights.
      *
@@ -135,9 +235,9 @@ public:
      *
      * @param origin of LocalPTR type.
      * @param y of int type.
-     * @return set of reachable cities, of type unordered_set<city, city::hashFunction>
+     * @return set of reachable cities, of type Cities_Set
      */
-    unordered_set<City, City::hashFunction> citiesWithMaxYFlights(LocalPTR origin, int y);
+    Cities_Set citiesWithMaxYFlights(LocalPTR origin, int y) const;
 
     /** @brief Determines the reachable countries, parting from a given local and using a maximum number of flights.
      *
@@ -145,73 +245,78 @@ public:
      *
      * @param origin of LocalPTR type.
      * @param y of int type.
-     * @return set of reachable countries, of type unordered_set<string>
+     * @return set of ids of the reachable countries in the global string pool, of type FlatSet<int>
      */
-    unordered_set<string> countriesWithMaxYFlights(LocalPTR origin, int y);
+    FlatSet<int> countriesWithMaxYFlights(LocalPTR origin, int y) const;
 
     /** @brief Represents the auxiliary code to calculate articulation points.
      *
      * It uses the DFS implementation.
-     * Temporal Complexity : O(|A| + |F|), A represents the number
-     * of airports and F represents the number of flights.
+     * Temporal Complexity : O(|A| + |R|), A represents the number
+     * of airports and R represents the number of routes.
      *
-     * @param airport of AirportPTR type.
+     * @param airport of int type, the id of the airport.
      * @param index of int type, by reference.
-     * @param stack of stack<AirportPTR> type, by reference.
+     * @param stack of stack<int> type, by reference.
      * @param answer of list<AirportPTR> type, by reference.
+     * @param traversal of Traversal type, by reference.
      * @return Void.
      */
-    void dfsArticulationPoints(AirportPTR airport, int &index, stack<AirportPTR> &stack, list<AirportPTR> &answer);
+    void dfsArticulationPoints(int airport, int &index, stack<int> &stack, list<AirportPTR> &answer,
+                               Traversal &traversal) const;
 
     /** @brief Represents the articulation points.
      *
      * It uses the "dfsArticulationPoints" method.
-     * Temporal Complexity : O(|A| + |F|), A represents the number
-     * of airports and F represents the number of flights.
+     * Temporal Complexity : O(|A| + |R|), A represents the number
+     * of airports and R represents the number of routes.
      *
      * @return List of airports.
      */
-    list<AirportPTR> articulationPoints();
+    list<AirportPTR> articulationPoints() const;
 
     /** @brief Updates the maximum diameter.
      *
-     * Temporal Complexity : O(|A| + |F|), A represents the number
-     * of airports and F represents the number of flights.
+     * Temporal Complexity : O(|A| + |R|), A represents the number
+     * of airports and R represents the number of routes.
      *
      * @param airportDepart Of AirportPTR type.
      * @param diameter Of int type, by reference.
+     * @param traversal Of Traversal type, by reference.
      * @return Void.
      */
-    void diameterBFS(AirportPTR airportDepart, int &diameter);
+    void diameterBFS(AirportPTR airportDepart, int &diameter, Traversal &traversal) const;
 
     /** @brief Represents the diameter of the graph.
      *
-     * Temporal Complexity : O(|A|(|A|+|F|)), A represents the number
-     * of airports and F represents the number of flights.
+     * The searches from each airport run in parallel.
+     * Temporal Complexity : O(|A|(|A|+|R|)), A represents the number
+     * of airports and R represents the number of routes.
      *
      * @return diameter of int type.
      */
-    int diameter();
+    int diameter() const;
 
     /** @brief Visits all airports through depth first search(BFS).
      *
-     * Temporal Complexity : O(|A| + |F|), A represents the number
-     * of airports and F represents the number of flights.
+     * Temporal Complexity : O(|A| + |R|), A represents the number
+     * of airports and R represents the number of routes.
      *
-     * @param airport Of AirportPTR type.
+     * @param airport Of int type, the id of the airport.
+     * @param traversal Of Traversal type, by reference.
      * @return void.
      */
-    void dfs(AirportPTR airport);
+    void dfs(int airport, Traversal &traversal) const;
 
     /** @brief Represents the number of connected components.
      *
      * It uses the DFS implementation.
-     * Temporal Complexity : O(|A| + |F|), A represents the number
-     * of airports and F represents the number of flights.
+     * Temporal Complexity : O(|A| + |R|), A represents the number
+     * of airports and R represents the number of routes.
      *
      * @return int number.
      */
-    int connectedComponents();
+    int connectedComponents() const;
 };
 
 #endif
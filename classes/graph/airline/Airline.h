@@ -16,6 +16,9 @@ using namespace std;
  */
 struct Airline{
 
+    //! @brief Holds the dense identifier of the airline, given by its order in the input file.
+    int id;
+
     //! @brief Holds the airline code.
     string code;
 
@@ -0,0 +1,29 @@
+/** @file AirlineSubgraph.cpp
+ *  @brief Contains the AirlineSubgraph class implementation.
+ *  @author -
+ *  @bug No known bugs.
+ */
+
+#include "AirlineSubgraph.h"
+
+const int FlightPlan::MAX_SUBGRAPHS;
+
+AirlineSubgraph::AirlineSubgraph(const vector<AirportPTR> &airports, int airline) {
+    firstFlights.reserve(airports.size() + 1);
+    firstFlights.push_back(0);
+    for (const AirportPTR &airport: airports) {
+        for (const Flight &flight: airport->flights)
+            if (flight.airline == airline)
+                flights.push_back(&flight);
+        firstFlights.push_back(flights.size());
+    }
+    flights.shrink_to_fit();
+}
+
+size_t AirlineSubgraph::getNumFlights() const {
+    return flights.size();
+}
+
+size_t AirlineSubgraph::bytes() const {
+    return sizeof(AirlineSubgraph) + firstFlights.capacity() * sizeof(int) + flights.capacity() * sizeof(const Flight *);
+}
@@ -0,0 +1,76 @@
+/** @file AirlineSubgraph.h
+ *  @brief Contains the AirlineSubgraph class and the FlightPlan struct declaration.
+ *  @author -
+ *  @bug No known bugs.
+ */
+
+#ifndef AED_FEUP_PROJ_2_22_23_AIRLINESUBGRAPH_H
+#define AED_FEUP_PROJ_2_22_23_AIRLINESUBGRAPH_H
+
+#include <memory>
+#include <vector>
+#include "../Airport/Airport.h"
+
+using namespace std;
+
+/** @brief AirlineSubgraph class to represent the flights of a single airline.
+ *
+ *  The flights are grouped by source airport as pointers to the flights of the airports,
+ *  so each airport's flights keep their order, and the subgraphs of several airlines
+ *  can be merged back into that order by comparing the pointers.
+ */
+class AirlineSubgraph {
+
+private:
+
+    //! @brief Holds the position of the first flight of each airport, and the number of flights at the end.
+    vector<int> firstFlights;
+
+    //! @brief Holds the flights of the airline, grouped by source airport.
+    vector<const Flight *> flights;
+
+public:
+
+    /** Create the subgraph of an airline.
+     *
+     * Temporal Complexity: O(|A| + |F|), A represents the number of airports and F the number of flights.
+     *
+     * @param airports Of const vector<AirportPTR> type, by reference, indexed by id.
+     * @param airline Of int type, the id of the airline.
+     */
+    AirlineSubgraph(const vector<AirportPTR> &airports, int airline);
+
+    //! @brief Returns the first flight of the airline leaving the airport with the given id.
+    const Flight *const *flightsBegin(int airport) const {
+        return flights.data() + firstFlights[airport];
+    }
+
+    //! @brief Returns one past the last flight of the airline leaving the airport with the given id.
+    const Flight *const *flightsEnd(int airport) const {
+        return flights.data() + firstFlights[airport + 1];
+    }
+
+    //! @brief Returns the number of flights of the airline.
+    size_t getNumFlights() const;
+
+    //! @brief Returns the number of bytes the subgraph takes.
+    size_t bytes() const;
+};
+
+/** @brief flightPlan struct to represent which flights a search with an airline filter looks at.
+ *
+ *  Either the subgraphs of the few airlines allowed, or every flight, each tested against the filter.
+ */
+struct FlightPlan {
+
+    //! @brief Defines the most subgraphs a plan merges; more airlines are searched over every flight.
+    static const int MAX_SUBGRAPHS = 4;
+
+    //! @brief Holds true if the search looks at the subgraphs, false if it looks at every flight.
+    bool useSubgraphs = false;
+
+    //! @brief Holds the subgraphs of the airlines allowed, at most MAX_SUBGRAPHS.
+    vector<shared_ptr<const AirlineSubgraph>> subgraphs;
+};
+
+#endif //AED_FEUP_PROJ_2_22_23_AIRLINESUBGRAPH_H
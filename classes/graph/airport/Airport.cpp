@@ -9,26 +9,28 @@
 
 
 Airport::Airport(string code, string name, string city, string country, float latitude, float longitude) :
+        code(code), name(StringPool::global().intern(name)), city(StringPool::global().intern(city)),
+        country(StringPool::global().intern(country)), latitude(latitude), longitude(longitude) {}
+
+Airport::Airport(string code, int name, int city, int country, float latitude, float longitude) :
         code(code), name(name), city(city), country(country), latitude(latitude), longitude(longitude) {}
 
 Airport::Airport(const Airport &airport) {
+    this->id = airport.id;
     this->code = airport.code;
     this->name = airport.name;
     this->city = airport.city;
     this->country = airport.country;
     this->latitude = airport.latitude;
     this->longitude = airport.longitude;
+    this->flights = airport.flights;
 }
 
 Airport::Airport() {}
 
-bool operator==(const AirportPTR &airport1, const AirportPTR &airport2) {
-    return airport1->code == airport2->code;
-}
-
 size_t Airport::hashFunction::operator()(const AirportPTR &airport) const {
 
-    return hash<string>()(airport->code);
+    return hash<int>()(airport->id);
 }
 
 double Airport::distanceTo(float latitude, float longitude) const {
@@ -48,15 +50,28 @@ double Airport::distanceTo(float latitude, float longitude) const {
     return earthRadius * b;
 }
 
-void Airport::addFlight(Flight flight) {
-    flights.push_back(flight);
+void Airport::setFlights(const Flight *first, const Flight *last) {
+    flights.first = first;
+    flights.last = last;
+}
+
+const string &Airport::getName() const {
+    return StringPool::global().get(name);
+}
+
+const string &Airport::getCity() const {
+    return StringPool::global().get(city);
+}
+
+const string &Airport::getCountry() const {
+    return StringPool::global().get(country);
 }
 
-int Airport::getnumFlights() {
+int Airport::getnumFlights() const {
     return flights.size();
 }
 
-list<Flight> Airport::getFlights() {
+FlightSpan Airport::getFlights() const {
     return flights;
 }
 
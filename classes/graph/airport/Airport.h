@@ -13,6 +13,7 @@
 #include <cmath>
 #include "../../../Pointers.h"
 #include "../Flight/Flight.h"
+#include "../Pool/StringPool.h"
 
 using namespace std;
 
@@ -23,17 +24,20 @@ class Airport {
 
 public:
 
+    //! @brief Holds the dense identifier of the airport, given by its order in the input file.
+    int id;
+
     //! @brief Holds the airport code.
     string code;
 
-    //! @brief Holds the airport name.
-    string name;
+    //! @brief Holds the id of the airport name in the global string pool.
+    int name;
 
-    //! @brief Holds the city that the airport belongs to.
-    string city;
+    //! @brief Holds the id of the name of the city that the airport belongs to in the global string pool.
+    int city;
 
-    //! @brief Holds the country that the airport belongs to.
-    string country;
+    //! @brief Holds the id of the name of the country that the airport belongs to in the global string pool.
+    int country;
 
     //! @brief Holds the airport latitude.
     float latitude;
@@ -41,37 +45,34 @@ public:
     //! @brief Holds the airport longitude.
     float longitude;
 
-    //! @brief Holds the distance from the source airport.
-    int dist;
-
     //! @brief Holds the flight that depart from the airport.
-    list<Flight> flights;
-
-    //! @brief Holds the airport has already visited or not.
-    bool visited;
-
-    //! @brief Holds all paths from the airport.
-    list<Flight> path;
-
-    //! @brief Holds the num from the airport.
-    int num;
-
-    //! @brief Holds the low from the airport.
-    int low;
-
-    //! @brief Holds true if airport is in the stack or false if otherwise.
-    bool inStack;
+    FlightSpan flights;
 
     /** Create a new airport with a code, a name, a city, a country, a latitude and a longitude.
+     *
+     * The name, the city and the country are interned in the global string pool.
      *
      * @param code Of Type string.
      * @param name Of Type string.
+     * @param city Of Type string.
      * @param country Of Type string.
      * @param latitude Of Type string.
      * @param longitude Of Type string.
      */
     Airport(string code, string name, string city, string country, float latitude, float longitude);
 
+    /** Create a new airport with a code, the ids of a name, a city and a country in the global string pool,
+     * a latitude and a longitude.
+     *
+     * @param code Of Type string.
+     * @param name Of Type int.
+     * @param city Of Type int.
+     * @param country Of Type int.
+     * @param latitude Of Type float.
+     * @param longitude Of Type float.
+     */
+    Airport(string code, int name, int city, int country, float latitude, float longitude);
+
     /** Create a copy of a airport.
      *
      * @param airport Of Type const airport.
@@ -103,34 +104,43 @@ public:
      */
     double distanceTo(float longitude, float latitude) const;
 
-    /** @brief Add flights to the list of flights.
+    /** @brief Sets the flights that depart from the airport.
      *
-     * @param flight of flight type.
+     * @param first of const Flight* type, first flight.
+     * @param last of const Flight* type, one past the last flight.
      * @return Void.
      */
-    void addFlight(Flight flight);
+    void setFlights(const Flight *first, const Flight *last);
+
+    /** @brief Returns the airport name.
+     *
+     * @return read-only reference to the name.
+     */
+    const string &getName() const;
+
+    /** @brief Returns the name of the city that the airport belongs to.
+     *
+     * @return read-only reference to the city name.
+     */
+    const string &getCity() const;
+
+    /** @brief Returns the name of the country that the airport belongs to.
+     *
+     * @return read-only reference to the country name.
+     */
+    const string &getCountry() const;
 
     /** @brief Represents the number of flights.
      *
      * @return The number of flights.
      */
-    int getnumFlights();
+    int getnumFlights() const;
 
     /** @brief Represents all the flights.
      *
-     * @return A list of flights.
+     * @return A read-only view of the flights.
      */
-    list<Flight> getFlights();
+    FlightSpan getFlights() const;
 };
 
-/** @brief Operator overload.
- *
- * Compares if two airports have the same code.
- *
- * @param airport1 Of type const AirportPTR, by reference.
- * @param airport2 Of type const AirportPTR, by reference.
- * @return True if the codes are equals.
- */
-bool operator ==(const AirportPTR& airport1, const AirportPTR& airport2);
-
 #endif //AED_FEUP_PROJ_2_22_23_AIRPORT_H
@@ -6,4 +6,15 @@
 
 #include "City.h"
 
-City::City(string name, string country): name(name), country(country){};
\ No newline at end of file
+City::City(int name, int country): name(name), country(country){};
+
+City::City(const string &name, const string &country):
+        name(StringPool::global().find(name)), country(StringPool::global().find(country)){};
+
+const string &City::getName() const {
+    return StringPool::global().get(name);
+}
+
+const string &City::getCountry() const {
+    return StringPool::global().get(country);
+}
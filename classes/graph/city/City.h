@@ -8,26 +8,50 @@
 #define AED_FEUP_PROJ_2_22_23_CITY_H
 
 #include <string>
+#include "../Pool/StringPool.h"
 
 using namespace std;
 
 /** @brief city struct to represent a city.
  *
+ *  The name and the country are ids of the global string pool.
  */
 struct City {
 
-    //! @brief Holds the name of the city.
-    string name;
+    //! @brief Holds the id of the name of the city.
+    int name;
 
-    //! @brief Holds the name of the country that the city belongs to.
-    string country;
+    //! @brief Holds the id of the name of the country that the city belongs to.
+    int country;
+
+    /** Create a new city with the ids of a name and a country.
+     *
+     * @param name Of int type.
+     * @param country Of int type.
+     */
+    City(int name, int country);
 
     /** Create a new city with a name and a country.
      *
-     * @param name Of string type.
-     * @param country Of string type.
+     * The strings are looked up in the global string pool, but not added to it:
+     * a city whose name or country was never interned matches no airport.
+     *
+     * @param name Of const string type, by reference.
+     * @param country Of const string type, by reference.
      */
-    City(string name, string country);
+    City(const string &name, const string &country);
+
+    /** @brief Returns the name of the city.
+     *
+     * @return read-only reference to the name.
+     */
+    const string &getName() const;
+
+    /** @brief Returns the name of the country.
+     *
+     * @return read-only reference to the country.
+     */
+    const string &getCountry() const;
 
     /** @brief Operator overload.
      *
@@ -41,12 +65,23 @@ struct City {
         return name == city.name && country == city.country;
     }
 
+    /** @brief Operator overload.
+     *
+     * Orders cities by the ids of their country and name.
+     *
+     * @param city of type const city, by reference.
+     * @return True if this city comes first.
+     */
+    bool operator < (const City& city) const {
+        return country != city.country ? country < city.country : name < city.name;
+    }
+
     /** @brief Hash function implementation.
      *
      */
     struct hashFunction {
         size_t operator()(const City& city) const {
-            return hash<string>()(city.name + city.country);
+            return hash<unsigned long long>()((unsigned long long) (unsigned) city.name << 32 | (unsigned) city.country);
         }
     };
 };
@@ -0,0 +1,129 @@
+/** @file Code.h
+ *  @brief Contains the code encoding helpers and the CodeTable class declaration.
+ *  @author -
+ *  @bug No known bugs.
+ */
+
+#ifndef AED_FEUP_PROJ_2_22_23_CODE_H
+#define AED_FEUP_PROJ_2_22_23_CODE_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+using namespace std;
+
+//! @brief Defines the number of characters of an airport or airline code.
+constexpr int CODE_LENGTH = 3;
+
+//! @brief Defines the number of symbols a character of a code can be: the uppercase letters and the digits.
+constexpr int CODE_SYMBOLS = 36;
+
+//! @brief Defines the number of different codes, all of which fit in 16 bits.
+constexpr int NUM_CODES = CODE_SYMBOLS * CODE_SYMBOLS * CODE_SYMBOLS;
+
+//! @brief Defines the value of a string that is not a valid code.
+constexpr int INVALID_CODE = -1;
+
+/** @brief Encodes a character of a code.
+ *
+ * @param symbol Of char type.
+ * @return int between 0 and CODE_SYMBOLS - 1, or INVALID_CODE.
+ */
+constexpr int encodeSymbol(char symbol) {
+    return symbol >= 'A' && symbol <= 'Z' ? symbol - 'A'
+         : symbol >= '0' && symbol <= '9' ? 26 + symbol - '0'
+         : INVALID_CODE;
+}
+
+/** @brief Encodes an airport or airline code into a small integer.
+ *
+ * Each character is a digit of a base CODE_SYMBOLS number.
+ *
+ * @param code Of const char* type.
+ * @param length Of size_t type.
+ * @return int between 0 and NUM_CODES - 1, or INVALID_CODE.
+ */
+constexpr int encodeCode(const char *code, size_t length) {
+    if (length != CODE_LENGTH) return INVALID_CODE;
+
+    int value = 0;
+    for (size_t i = 0; i < length; i++) {
+        int symbol = encodeSymbol(code[i]);
+        if (symbol == INVALID_CODE) return INVALID_CODE;
+        value = value * CODE_SYMBOLS + symbol;
+    }
+    return value;
+}
+
+/** @brief Encodes an airport or airline code into a small integer.
+ *
+ * @param code Of const string type, by reference.
+ * @return int between 0 and NUM_CODES - 1, or INVALID_CODE.
+ */
+inline int encodeCode(const string &code) {
+    return encodeCode(code.data(), code.size());
+}
+
+static_assert(encodeCode("AAA", 3) == 0, "First code must be 0");
+static_assert(encodeCode("999", 3) == NUM_CODES - 1, "Last code must be NUM_CODES - 1");
+static_assert(NUM_CODES <= 1 << 16, "Codes must fit in 16 bits");
+
+/** @brief CodeTable class to represent a flat array indexed by airport or airline codes.
+ *
+ * Replaces a hash map from code strings: a lookup is an encoding and an array access.
+ */
+template<typename T>
+class CodeTable {
+
+private:
+
+    //! @brief Holds a value for each possible code.
+    vector<T> values;
+
+    //! @brief Holds the value of the codes that were never set.
+    T empty;
+
+public:
+
+    /** Create a new CodeTable with every code set to the empty value.
+     *
+     * @param empty Of T type.
+     */
+    explicit CodeTable(T empty = T()) : values(NUM_CODES, empty), empty(empty) {}
+
+    /** @brief Returns the value of a code.
+     *
+     * @param code Of const char* type.
+     * @param length Of size_t type.
+     * @return The value, or the empty value if the code is invalid or was never set.
+     */
+    const T &get(const char *code, size_t length) const {
+        int value = encodeCode(code, length);
+        return value == INVALID_CODE ? empty : values[value];
+    }
+
+    /** @brief Returns the value of a code.
+     *
+     * @param code Of const string type, by reference.
+     * @return The value, or the empty value if the code is invalid or was never set.
+     */
+    const T &get(const string &code) const {
+        return get(code.data(), code.size());
+    }
+
+    /** @brief Sets the value of a code.
+     *
+     * @param code Of const string type, by reference.
+     * @param value Of T type.
+     * @return False if the code is invalid.
+     */
+    bool set(const string &code, T value) {
+        int encoded = encodeCode(code);
+        if (encoded == INVALID_CODE) return false;
+        values[encoded] = value;
+        return true;
+    }
+};
+
+#endif //AED_FEUP_PROJ_2_22_23_CODE_H
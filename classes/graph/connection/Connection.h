@@ -0,0 +1,36 @@
+/** @file Connection.h
+ *  @brief Contains the connection struct declaration.
+ *  @author -
+ *  @bug No known bugs.
+ */
+#ifndef AED_FEUP_PROJ_2_22_23_CONNECTION_H
+#define AED_FEUP_PROJ_2_22_23_CONNECTION_H
+
+#include <vector>
+
+/** @brief connection struct to represent a scheduled departure of a flight.
+ *
+ *  Times are in minutes since midnight of the first day of the timetable.
+ */
+struct Connection {
+
+    //! @brief Holds the time the flight departs.
+    int departure;
+
+    //! @brief Holds the time the flight arrives, always after it departs.
+    int arrival;
+
+    //! @brief Holds the id of the origin airport.
+    int origin;
+
+    //! @brief Holds the id of the destination airport.
+    int destination;
+
+    //! @brief Holds the id of the airline.
+    int airline;
+};
+
+//! @brief Redefinition of the name for ease of use: the connections taken, in order, from an origin to a destination.
+typedef std::vector<Connection> Journey;
+
+#endif //AED_FEUP_PROJ_2_22_23_CONNECTION_H
@@ -0,0 +1,55 @@
+/** @file Constraints.cpp
+ *  @brief Contains the Constraints Class implementation.
+ *  @author -
+ *  @bug No known bugs.
+ */
+
+#include "Constraints.h"
+
+const int Constraints::UNLIMITED;
+
+Constraints::Constraints(size_t numAirports, const AirlineFilter &airlines) :
+        airports(numAirports, true), airlines(airlines) {}
+
+void Constraints::excludeAirport(int airport) {
+    airports[airport] = false;
+}
+
+void Constraints::excludeCountry(int country, const vector<AirportPTR> &airports) {
+    for (const AirportPTR &airport: airports)
+        if (airport->country == country)
+            this->airports[airport->id] = false;
+}
+
+void Constraints::excludeAirline(int airline) {
+    airlines[airline] = false;
+}
+
+void Constraints::setVia(int airport) {
+    via = airport;
+}
+
+void Constraints::setFlights(int minimum, int maximum) {
+    minimumFlights = minimum;
+    maximumFlights = maximum;
+}
+
+int Constraints::getVia() const {
+    return via;
+}
+
+int Constraints::getMinimumFlights() const {
+    return minimumFlights;
+}
+
+int Constraints::getMaximumFlights() const {
+    return maximumFlights;
+}
+
+int Constraints::getPhases() const {
+    return (minimumFlights + 1) * (via == -1 ? 1 : 2);
+}
+
+const AirlineFilter &Constraints::getAirlines() const {
+    return airlines;
+}
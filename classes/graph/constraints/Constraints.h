@@ -0,0 +1,142 @@
+/** @file Constraints.h
+ *  @brief Contains the Constraints class declaration.
+ *  @author -
+ *  @bug No known bugs.
+ */
+
+#ifndef AED_FEUP_PROJ_2_22_23_CONSTRAINTS_H
+#define AED_FEUP_PROJ_2_22_23_CONSTRAINTS_H
+
+#include <climits>
+#include <vector>
+#include "../FlightMap.h"
+
+using namespace std;
+
+/** @brief Constraints class to represent the restrictions a trajectory must respect.
+ *
+ *  The airports, countries and airlines to avoid are compiled once into masks indexed by id,
+ *  so a search tells if a flight can be taken with two lookups and no string comparisons.
+ *  A trajectory may also have to pass through an airport, and take a minimum and maximum number of flights.
+ */
+class Constraints {
+
+    //! @brief Holds true for the airports that can be used, indexed by id.
+    vector<bool> airports;
+
+    //! @brief Holds true for the airlines that can be used, indexed by id.
+    AirlineFilter airlines;
+
+    //! @brief Holds the id of the airport the trajectories must pass through, -1 if there is none.
+    int via = -1;
+
+    //! @brief Holds the minimum number of flights.
+    int minimumFlights = 1;
+
+    //! @brief Holds the maximum number of flights.
+    int maximumFlights = UNLIMITED;
+
+public:
+
+    //! @brief Defines the maximum number of flights when there is no limit.
+    static const int UNLIMITED = INT_MAX;
+
+    /** Create a new Constraints that allows every airport and the given airlines.
+     *
+     * @param numAirports Of size_t type.
+     * @param airlines Of const AirlineFilter type, by reference.
+     */
+    Constraints(size_t numAirports, const AirlineFilter &airlines);
+
+    /** @brief Forbids an airport.
+     *
+     * @param airport Of int type, the id of the airport.
+     * @return Void.
+     */
+    void excludeAirport(int airport);
+
+    /** @brief Forbids every airport of a country.
+     *
+     * Temporal Complexity: O(A), A being the number of airports.
+     *
+     * @param country Of int type, the id of the country in the global string pool.
+     * @param airports Of const vector<AirportPTR> type, by reference, indexed by id.
+     * @return Void.
+     */
+    void excludeCountry(int country, const vector<AirportPTR> &airports);
+
+    /** @brief Forbids an airline.
+     *
+     * @param airline Of int type, the id of the airline.
+     * @return Void.
+     */
+    void excludeAirline(int airline);
+
+    /** @brief Sets the airport the trajectories must pass through.
+     *
+     * @param airport Of int type, the id of the airport.
+     * @return Void.
+     */
+    void setVia(int airport);
+
+    /** @brief Sets the minimum and maximum number of flights.
+     *
+     * @param minimum Of int type, at least 1.
+     * @param maximum Of int type, at least the minimum, or UNLIMITED.
+     * @return Void.
+     */
+    void setFlights(int minimum, int maximum);
+
+    /** @brief Returns true if the airport can be used.
+     *
+     * @param airport Of int type, the id of the airport.
+     * @return bool.
+     */
+    bool allows(int airport) const {
+        return airports[airport];
+    }
+
+    /** @brief Returns true if the flight can be taken, by its airline and its destination.
+     *
+     * @param flight Of const Flight type, by reference.
+     * @return bool.
+     */
+    bool allows(const Flight &flight) const {
+        return airlines[flight.airline] && airports[flight.destination];
+    }
+
+    /** @brief Returns the id of the airport the trajectories must pass through.
+     *
+     * @return int, -1 if there is none.
+     */
+    int getVia() const;
+
+    /** @brief Returns the minimum number of flights.
+     *
+     * @return int.
+     */
+    int getMinimumFlights() const;
+
+    /** @brief Returns the maximum number of flights.
+     *
+     * @return int, UNLIMITED if there is no limit.
+     */
+    int getMaximumFlights() const;
+
+    /** @brief Returns how many states a search keeps for each airport.
+     *
+     * A search tells apart the number of flights taken while under the minimum,
+     * and whether the via airport was passed through.
+     *
+     * @return int.
+     */
+    int getPhases() const;
+
+    /** @brief Returns the airlines that can be used.
+     *
+     * @return read-only reference to the AirlineFilter, indexed by airline id.
+     */
+    const AirlineFilter &getAirlines() const;
+};
+
+#endif //AED_FEUP_PROJ_2_22_23_CONSTRAINTS_H
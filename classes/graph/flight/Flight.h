@@ -6,20 +6,43 @@
 #ifndef AED_FEUP_PROJ_2_22_23_FLIGHT_H
 #define AED_FEUP_PROJ_2_22_23_FLIGHT_H
 
-using namespace std;
-
-#include <string>
+#include <cstddef>
 
 /** @brief flight struct to represent a flight.
  *
  */
 struct Flight {
 
-    //! @brief Holds the destination code of the flight.
-    string destinationCode;
+    //! @brief Holds the id of the destination airport of the flight.
+    int destination;
+
+    //! @brief Holds the id of the airline that can be used to the flight.
+    int airline;
+};
+
+/** @brief flightSpan struct to represent the flights that depart from an airport.
+ *
+ *  A non-owning view over consecutive flights of the flights array held by the database.
+ */
+struct FlightSpan {
+
+    //! @brief Holds the first flight.
+    const Flight *first = nullptr;
+
+    //! @brief Holds one past the last flight.
+    const Flight *last = nullptr;
+
+    //! @brief Returns the first flight.
+    const Flight *begin() const { return first; }
+
+    //! @brief Returns one past the last flight.
+    const Flight *end() const { return last; }
+
+    //! @brief Returns the number of flights.
+    size_t size() const { return last - first; }
 
-    //! @brief Holds the airline that can be used to the flight.
-    string airlineCode;
+    //! @brief Returns true if there are no flights.
+    bool empty() const { return first == last; }
 };
 
 
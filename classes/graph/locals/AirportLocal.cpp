@@ -9,8 +9,8 @@
 
 AirportLocal::AirportLocal(std::string code): code(code){}
 
-list<AirportPTR> AirportLocal::getAirports(FlightMap*  flightMap) {
+list<AirportPTR> AirportLocal::getAirports(const FlightMap *flightMap) {
     list<AirportPTR> airports;
-    airports.push_back(flightMap->getAirports()[code]);
+    airports.push_back(flightMap->getAirport(code));
     return airports;
 }
\ No newline at end of file
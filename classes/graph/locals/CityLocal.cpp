@@ -9,11 +9,13 @@
 
 CityLocal::CityLocal(City city): city(city) {}
 
-list<AirportPTR> CityLocal::getAirports(FlightMap*  flightMap) {
+list<AirportPTR> CityLocal::getAirports(const FlightMap *flightMap) {
     list<AirportPTR> airports;
-    auto cityAirports = flightMap->getAirportsPerCity()[city];
+    const AirportsPerCity_Set &airportsPerCity = flightMap->getAirportsPerCity();
+    auto cityAirports = airportsPerCity.find(city);
 
-    for (AirportPTR airport: cityAirports)
-        airports.push_back(airport);
+    if (cityAirports != airportsPerCity.end())
+        for (const AirportPTR &airport: cityAirports->second)
+            airports.push_back(airport);
     return airports;
 }
\ No newline at end of file
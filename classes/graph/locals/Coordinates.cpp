@@ -10,12 +10,11 @@
 Coordinates::Coordinates(float latitude, float longitude, float radius):
     latitude(latitude), longitude(longitude), radius(radius){}
 
-list<AirportPTR> Coordinates::getAirports(FlightMap*  flightMap) {
+list<AirportPTR> Coordinates::getAirports(const FlightMap *flightMap) {
     list<AirportPTR> airports;
-    auto allAirports = flightMap->getAirports();
+    const vector<AirportPTR> &allAirports = flightMap->getAirports();
 
-    for (auto pair: allAirports) {
-        AirportPTR airport = pair.second;
+    for (const AirportPTR &airport: allAirports) {
         int distance = airport->distanceTo(latitude, longitude);
         
         if (distance < radius)
@@ -40,7 +40,7 @@ public:
      * @param flightMap of FlightMap type.
      * @return list<AirportPTR> of airports.
      */
-    list<AirportPTR> getAirports(FlightMap* flightMap) override;
+    list<AirportPTR> getAirports(const FlightMap *flightMap) override;
 };
 
 #endif //AED_FEUP_PROJ_2_22_23_COORDINATES_H
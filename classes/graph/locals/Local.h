@@ -20,7 +20,7 @@ public:
      * @param flightMap of FlightMapPtr type.
      * @return list<AirportPTR> of airports.
      */
-    virtual list<AirportPTR > getAirports(FlightMap *flightMap) = 0;
+    virtual list<AirportPTR > getAirports(const FlightMap *flightMap) = 0;
 };
 
 #endif //AED_FEUP_PROJ_2_22_23_LOCAL_H
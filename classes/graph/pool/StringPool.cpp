@@ -0,0 +1,36 @@
+/** @file StringPool.cpp
+ *  @brief Contains the StringPool Class implementation.
+ *  @author -
+ *  @bug No known bugs.
+ */
+
+#include "StringPool.h"
+
+const int StringPool::NOT_FOUND;
+
+StringPool::StringPool() = default;
+
+StringPool &StringPool::global() {
+    static StringPool pool;
+    return pool;
+}
+
+int StringPool::intern(const string &value) {
+    auto inserted = ids.insert({value, (int) strings.size()});
+    if (inserted.second)
+        strings.push_back(&inserted.first->first);
+    return inserted.first->second;
+}
+
+int StringPool::find(const string &value) const {
+    auto found = ids.find(value);
+    return found == ids.end() ? NOT_FOUND : found->second;
+}
+
+const string &StringPool::get(int id) const {
+    return *strings[id];
+}
+
+int StringPool::size() const {
+    return strings.size();
+}
@@ -0,0 +1,83 @@
+/** @file StringPool.h
+ *  @brief Contains the StringPool class declaration.
+ *  @author -
+ *  @bug No known bugs.
+ */
+
+#ifndef AED_FEUP_PROJ_2_22_23_STRINGPOOL_H
+#define AED_FEUP_PROJ_2_22_23_STRINGPOOL_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+/** @brief StringPool class to represent a table of interned strings.
+ *
+ *  Every distinct string is stored once and given a dense integer id,
+ *  so strings that repeat a lot, like cities and countries, can be compared and hashed as integers.
+ *  Interning is not thread safe, but lookups are once the database is loaded.
+ */
+class StringPool {
+
+private:
+
+    //! @brief Holds the id of every interned string.
+    unordered_map<string, int> ids;
+
+    //! @brief Holds the interned strings, indexed by id. They point to the keys of ids, which never move.
+    vector<const string *> strings;
+
+public:
+
+    //! @brief Defines the id returned for strings that were never interned.
+    static const int NOT_FOUND = -1;
+
+    /** Create a new, empty StringPool.
+     *
+     * Does nothing.
+     */
+    StringPool();
+
+    StringPool(const StringPool &) = delete;
+
+    StringPool &operator=(const StringPool &) = delete;
+
+    /** @brief Returns the pool shared by the whole program.
+     *
+     * @return StringPool, by reference.
+     */
+    static StringPool &global();
+
+    /** @brief Interns a string.
+     *
+     * Temporal Complexity: O(n), n being the length of the string.
+     *
+     * @param value Of const string type, by reference.
+     * @return int id of the string, the same for equal strings.
+     */
+    int intern(const string &value);
+
+    /** @brief Looks up a string without interning it.
+     *
+     * @param value Of const string type, by reference.
+     * @return int id of the string, or NOT_FOUND.
+     */
+    int find(const string &value) const;
+
+    /** @brief Returns an interned string.
+     *
+     * @param id Of int type.
+     * @return read-only reference to the string.
+     */
+    const string &get(int id) const;
+
+    /** @brief Returns the number of interned strings, which is one past the largest id.
+     *
+     * @return int.
+     */
+    int size() const;
+};
+
+#endif //AED_FEUP_PROJ_2_22_23_STRINGPOOL_H
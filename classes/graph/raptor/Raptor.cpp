@@ -0,0 +1,233 @@
+/** @file Raptor.cpp
+ *  @brief Contains the Raptor Class implementation.
+ *  @author -
+ *  @bug No known bugs.
+ */
+
+#include "Raptor.h"
+#include <algorithm>
+#include <climits>
+#include "../Timetable/Timetable.h"
+#include "../../Scheduler/Scheduler.h"
+#include "../../Instrumentation/Instrumentation.h"
+
+const int Raptor::MAXIMUM_LEGS;
+
+//! @brief Defines the arrival at an airport that cannot be reached.
+static const int NEVER = INT_MAX;
+
+Raptor::Raptor() = default;
+
+void Raptor::setConnections(const vector<Connection> &connections, size_t numAirports) {
+    this->numAirports = numAirports;
+
+    vector<Connection> sorted;
+    sorted.reserve(2 * connections.size());
+    for (int day = 0; day < 2; day++)
+        for (Connection connection: connections) {
+            connection.departure += day * Timetable::DAY;
+            connection.arrival += day * Timetable::DAY;
+            sorted.push_back(connection);
+        }
+    sort(sorted.begin(), sorted.end(), [](const Connection &first, const Connection &second) {
+        if (first.origin != second.origin) return first.origin < second.origin;
+        if (first.destination != second.destination) return first.destination < second.destination;
+        if (first.airline != second.airline) return first.airline < second.airline;
+        return first.departure < second.departure;
+    });
+
+    routes.clear();
+    trips.clear();
+    trips.reserve(sorted.size());
+    for (const Connection &connection: sorted) {
+        if (routes.empty() || routes.back().origin != connection.origin ||
+            routes.back().destination != connection.destination || routes.back().airline != connection.airline)
+            routes.push_back({connection.origin, connection.destination, connection.airline,
+                              (int) trips.size(), (int) trips.size()});
+        trips.push_back({connection.departure, connection.arrival, (int) trips.size()});
+        routes.back().lastTrip++;
+    }
+
+    // A later trip can arrive earlier than one before it, so each trip points to the best one from it on.
+    for (const Route &route: routes)
+        for (int trip = route.lastTrip - 2; trip >= route.firstTrip; trip--)
+            if (trips[trips[trip + 1].earliest].arrival <= trips[trip].arrival)
+                trips[trip].earliest = trips[trip + 1].earliest;
+
+    firstRoute.assign(numAirports + 1, 0);
+    for (const Route &route: routes)
+        firstRoute[route.origin + 1]++;
+    for (size_t airport = 0; airport < numAirports; airport++)
+        firstRoute[airport + 1] += firstRoute[airport];
+}
+
+bool Raptor::empty() const {
+    return routes.empty();
+}
+
+void Raptor::search(const vector<int> &origins, const vector<bool> &isDestination, int departure,
+                    int lastDeparture, const AirlineFilter &airlines, int minimumConnection, int maximumLegs,
+                    Labels &labels, vector<Journey> &journeys, const Deadline &deadline) const {
+    size_t size = (maximumLegs + 1) * numAirports;
+    if (labels.arrival.size() != size) {
+        labels.arrival.assign(size, NEVER);
+        labels.trip.assign(size, -1);
+        labels.best.assign(numAirports, NEVER);
+        labels.marked.assign(numAirports, false);
+        labels.touched.clear();
+    }
+    for (int index: labels.touched) {
+        labels.arrival[index] = NEVER;
+        labels.trip[index] = -1;
+        labels.best[index % numAirports] = NEVER;
+    }
+    labels.touched.clear();
+
+    vector<int> markedAirports;
+    for (int origin: origins) {
+        labels.arrival[origin] = labels.best[origin] = departure;
+        labels.touched.push_back(origin);
+        markedAirports.push_back(origin);
+    }
+
+    int bestTarget = NEVER;
+    long long scanned = 0;
+    for (int round = 1; round <= maximumLegs && !markedAirports.empty(); round++) {
+        deadline.check();
+        int *previous = &labels.arrival[(round - 1) * numAirports], *current = &labels.arrival[round * numAirports];
+        int *reachedBy = &labels.trip[round * numAirports];
+
+        vector<int> improved;
+        for (int airport: markedAirports) {
+            int ready = previous[airport] + (round == 1 ? 0 : minimumConnection);
+
+            for (int index = firstRoute[airport]; index < firstRoute[airport + 1]; index++) {
+                const Route &route = routes[index];
+                if (!airlines[route.airline]) continue;
+                scanned++;
+
+                auto first = trips.begin() + route.firstTrip, last = trips.begin() + route.lastTrip;
+                auto trip = partition_point(first, last, [ready](const Trip &trip) { return trip.departure < ready; });
+                if (trip == last) continue;
+
+                int taken = trip->earliest;
+                if (round == 1 && trips[taken].departure >= lastDeparture) {
+                    // The first flight must leave before the last departure, so the best trip is one of those that do.
+                    if (trip->departure >= lastDeparture) continue;
+                    taken = trip - trips.begin();
+                    for (auto later = trip + 1; later != last && later->departure < lastDeparture; ++later)
+                        if (later->arrival < trips[taken].arrival) taken = later - trips.begin();
+                }
+                int arrival = trips[taken].arrival;
+                if (arrival >= labels.best[route.destination] || arrival >= bestTarget) continue;
+
+                current[route.destination] = labels.best[route.destination] = arrival;
+                reachedBy[route.destination] = taken;
+                labels.touched.push_back(round * numAirports + route.destination);
+                if (!labels.marked[route.destination]) {
+                    labels.marked[route.destination] = true;
+                    improved.push_back(route.destination);
+                }
+            }
+        }
+
+        int target = -1;
+        for (int airport: improved) {
+            labels.marked[airport] = false;
+            if (isDestination[airport] && current[airport] < bestTarget) {
+                bestTarget = current[airport];
+                target = airport;
+            }
+        }
+
+        if (target != -1) {
+            Journey journey;
+            for (int back = round, airport = target; back >= 1; back--) {
+                int taken = labels.trip[back * numAirports + airport];
+                const Route &route = *(upper_bound(routes.begin(), routes.end(), taken,
+                                                   [](int trip, const Route &route) { return trip < route.firstTrip; }) - 1);
+                journey.push_back({trips[taken].departure, trips[taken].arrival, route.origin, route.destination,
+                                   route.airline});
+                airport = route.origin;
+            }
+            reverse(journey.begin(), journey.end());
+            journeys.push_back(journey);
+        }
+        markedAirports.swap(improved);
+    }
+    INSTRUMENT_COUNT("routes scanned", scanned);
+}
+
+vector<Journey> Raptor::paretoJourneys(const vector<int> &origins, const vector<int> &destinations, int departure,
+                                       const AirlineFilter &airlines, int minimumConnection,
+                                       int maximumLegs, const Deadline &deadline) const {
+    INSTRUMENT_SCOPE("query/raptor");
+
+    vector<bool> isDestination(numAirports, false);
+    for (int destination: destinations)
+        isDestination[destination] = find(origins.begin(), origins.end(), destination) == origins.end();
+
+    Labels labels;
+    vector<Journey> journeys;
+    search(origins, isDestination, departure, NEVER, airlines, minimumConnection, maximumLegs, labels, journeys,
+           deadline);
+    return journeys;
+}
+
+vector<Journey> Raptor::paretoJourneys(const vector<int> &origins, const vector<int> &destinations, int first,
+                                       int last, const AirlineFilter &airlines, int minimumConnection,
+                                       int maximumLegs, const Deadline &deadline) const {
+    INSTRUMENT_SCOPE("query/raptorRange");
+
+    vector<bool> isDestination(numAirports, false);
+    for (int destination: destinations)
+        isDestination[destination] = find(origins.begin(), origins.end(), destination) == origins.end();
+
+    // Only the times a flight leaves the origins can start a journey that is not dominated.
+    vector<int> departures;
+    for (int origin: origins)
+        for (int index = firstRoute[origin]; index < firstRoute[origin + 1]; index++)
+            if (airlines[routes[index].airline])
+                for (int trip = routes[index].firstTrip; trip < routes[index].lastTrip; trip++)
+                    if (trips[trip].departure >= first && trips[trip].departure < last)
+                        departures.push_back(trips[trip].departure);
+    sort(departures.begin(), departures.end());
+    departures.erase(unique(departures.begin(), departures.end()), departures.end());
+
+    vector<vector<Journey>> found(departures.size());
+    Scheduler::global().parallelFor(0, departures.size(), 1, [&](int begin, int end) {
+        Labels labels;
+        for (int i = begin; i < end; i++)
+            search(origins, isDestination, departures[i], last, airlines, minimumConnection, maximumLegs, labels,
+                   found[i], deadline);
+    });
+
+    vector<Journey> candidates;
+    for (vector<Journey> &journeys: found)
+        for (Journey &journey: journeys)
+            candidates.push_back(move(journey));
+    sort(candidates.begin(), candidates.end(), [](const Journey &first, const Journey &second) {
+        if (first.front().departure != second.front().departure)
+            return first.front().departure > second.front().departure;
+        if (first.size() != second.size()) return first.size() < second.size();
+        return first.back().arrival < second.back().arrival;
+    });
+
+    // Going from the latest departure, a journey is kept only if it arrives earlier than every one kept
+    // with as few flights.
+    vector<int> earliestWithLegs(maximumLegs + 1, NEVER);
+    vector<Journey> journeys;
+    for (Journey &journey: candidates) {
+        int arrival = journey.back().arrival, legs = journey.size();
+        if (*min_element(earliestWithLegs.begin(), earliestWithLegs.begin() + legs + 1) <= arrival) continue;
+        earliestWithLegs[legs] = arrival;
+        journeys.push_back(move(journey));
+    }
+
+    sort(journeys.begin(), journeys.end(), [](const Journey &first, const Journey &second) {
+        if (first.front().departure != second.front().departure)
+            return first.front().departure < second.front().departure;
+        return first.size() < second.size();
+    });
+    return journeys;
+}
@@ -0,0 +1,183 @@
+/** @file Raptor.h
+ *  @brief Contains the Raptor class declaration.
+ *  @author -
+ *  @bug No known bugs.
+ */
+
+#ifndef AED_FEUP_PROJ_2_22_23_RAPTOR_H
+#define AED_FEUP_PROJ_2_22_23_RAPTOR_H
+
+#include <vector>
+#include "../Connection/Connection.h"
+#include "../FlightMap.h"
+#include "../../Deadline/Deadline.h"
+
+using namespace std;
+
+/** @brief Raptor class to find the scheduled journeys that trade arrival time against the number of flights.
+ *
+ *  Each flight of the flights file, an origin, a destination and an airline, is a route,
+ *  whose trips are its scheduled departures over two days, as in the Timetable.
+ *  A search runs in rounds, as RAPTOR does: round k takes one more flight from the airports improved in round k - 1,
+ *  so after it every airport holds the earliest arrival with at most k flights.
+ *  The routes, their trips and the routes leaving each airport are kept in flat arrays.
+ */
+class Raptor {
+
+    /** @brief route struct to represent the scheduled departures of a flight.
+     *
+     */
+    struct Route {
+
+        //! @brief Holds the id of the origin airport.
+        int origin;
+
+        //! @brief Holds the id of the destination airport.
+        int destination;
+
+        //! @brief Holds the id of the airline.
+        int airline;
+
+        //! @brief Holds the index of the first trip.
+        int firstTrip;
+
+        //! @brief Holds one past the index of the last trip.
+        int lastTrip;
+    };
+
+    /** @brief trip struct to represent a scheduled departure of a route.
+     *
+     */
+    struct Trip {
+
+        //! @brief Holds the time the trip departs.
+        int departure;
+
+        //! @brief Holds the time the trip arrives.
+        int arrival;
+
+        //! @brief Holds the index of the trip, from this one to the last of the route, that arrives first.
+        int earliest;
+    };
+
+    /** @brief labels struct to represent the state of a search, reused from one search to the next.
+     *
+     */
+    struct Labels {
+
+        //! @brief Holds the arrival at each airport in each round, indexed by round * airports + airport.
+        vector<int> arrival;
+
+        //! @brief Holds the trip that reached each airport in each round, indexed like the arrivals.
+        vector<int> trip;
+
+        //! @brief Holds the earliest arrival at each airport in any round.
+        vector<int> best;
+
+        //! @brief Holds true if the airport was improved in the last round.
+        vector<bool> marked;
+
+        //! @brief Holds the indexes of the arrivals set, to be reset before the next search.
+        vector<int> touched;
+    };
+
+    //! @brief Holds the routes, grouped by origin airport.
+    vector<Route> routes;
+
+    //! @brief Holds the trips, grouped by route and sorted by departure within each.
+    vector<Trip> trips;
+
+    //! @brief Holds the index of the first route leaving each airport, and the number of routes at the end.
+    vector<int> firstRoute;
+
+    //! @brief Holds the number of airports.
+    size_t numAirports = 0;
+
+    /** @brief Searches from origins leaving at a time, appending the Pareto-optimal journeys found.
+     *
+     * Temporal Complexity: O(K(A + R log T)), K being the maximum number of flights, A the number of airports,
+     * R the number of routes and T the number of trips of a route.
+     *
+     * @param origins Of const vector<int> type, by reference.
+     * @param isDestination Of const vector<bool> type, by reference, indexed by airport id.
+     * @param departure Of int type.
+     * @param lastDeparture Of int type, one past the latest time the first flight can leave.
+     * @param airlines Of const AirlineFilter type, by reference.
+     * @param minimumConnection Of int type.
+     * @param maximumLegs Of int type.
+     * @param labels Of Labels type, by reference.
+     * @param journeys Of vector<Journey> type, by reference, with one journey for each number of flights
+     * that arrives earlier than with fewer.
+     * @param deadline Of const Deadline type, by reference, checked before each round.
+     * @return Void.
+     */
+    void search(const vector<int> &origins, const vector<bool> &isDestination, int departure, int lastDeparture,
+                const AirlineFilter &airlines, int minimumConnection, int maximumLegs, Labels &labels,
+                vector<Journey> &journeys, const Deadline &deadline) const;
+
+public:
+
+    //! @brief Defines the maximum number of flights of a journey used when none is given.
+    static const int MAXIMUM_LEGS = 4;
+
+    /** Create a new, empty, Raptor.
+     *
+     * Does nothing.
+     */
+    Raptor();
+
+    /** @brief Groups the connections of a day into routes, repeating them into the next day.
+     *
+     * Temporal Complexity: O(C log C), C being the number of connections.
+     *
+     * @param connections Of const vector<Connection> type, by reference, departing in [0, DAY).
+     * @param numAirports Of size_t type.
+     * @return Void.
+     */
+    void setConnections(const vector<Connection> &connections, size_t numAirports);
+
+    /** @brief Returns true if there are no routes.
+     *
+     * @return bool.
+     */
+    bool empty() const;
+
+    /** @brief Returns the journeys from any of the origins to any of the destinations, leaving at or after a time,
+     * that no other one both arrives earlier than and takes fewer flights than.
+     *
+     * @param origins Of const vector<int> type, by reference, the ids of the origin airports.
+     * @param destinations Of const vector<int> type, by reference, the ids of the destination airports.
+     * @param departure Of int type, in [0, DAY).
+     * @param airlines Of const AirlineFilter type, by reference.
+     * @param minimumConnection Of int type, in minutes.
+     * @param maximumLegs Of int type.
+     * @param deadline Of const Deadline type, by reference, none by default.
+     * @return vector<Journey>, by increasing number of flights and decreasing arrival.
+     * @throws DeadlineExceeded if the deadline passes during the search.
+     */
+    vector<Journey> paretoJourneys(const vector<int> &origins, const vector<int> &destinations, int departure,
+                                   const AirlineFilter &airlines, int minimumConnection,
+                                   int maximumLegs = MAXIMUM_LEGS, const Deadline &deadline = Deadline()) const;
+
+    /** @brief Returns the journeys leaving any of the origins in a range of times that no other one
+     * leaves later than, arrives earlier than and takes fewer flights than.
+     *
+     * Searches from every time a flight leaves the origins in the range, in parallel.
+     *
+     * @param origins Of const vector<int> type, by reference, the ids of the origin airports.
+     * @param destinations Of const vector<int> type, by reference, the ids of the destination airports.
+     * @param first Of int type, the earliest departure.
+     * @param last Of int type, one past the latest departure.
+     * @param airlines Of const AirlineFilter type, by reference.
+     * @param minimumConnection Of int type, in minutes.
+     * @param maximumLegs Of int type.
+     * @param deadline Of const Deadline type, by reference, none by default.
+     * @return vector<Journey>, by departure and then number of flights.
+     * @throws DeadlineExceeded if the deadline passes during the searches.
+     */
+    vector<Journey> paretoJourneys(const vector<int> &origins, const vector<int> &destinations, int first,
+                                   int last, const AirlineFilter &airlines, int minimumConnection,
+                                   int maximumLegs = MAXIMUM_LEGS, const Deadline &deadline = Deadline()) const;
+};
+
+#endif //AED_FEUP_PROJ_2_22_23_RAPTOR_H
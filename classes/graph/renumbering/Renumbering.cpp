@@ -0,0 +1,149 @@
+/** @file Renumbering.cpp
+ *  @brief Contains the Renumbering class implementation.
+ *  @author -
+ *  @bug No known bugs.
+ */
+
+#include "Renumbering.h"
+#include <algorithm>
+
+bool Renumbering::parseOrder(const string &name, Order &order) {
+    if (name == "input") order = INPUT;
+    else if (name == "bfs") order = BFS;
+    else if (name == "rcm") order = RCM;
+    else if (name == "hilbert") order = HILBERT;
+    else return false;
+    return true;
+}
+
+vector<vector<int>> Renumbering::neighboursOf(const vector<AirportPTR> &airports) {
+    vector<vector<int>> neighbours(airports.size());
+    for (const AirportPTR &airport: airports)
+        for (const Flight &flight: airport->flights)
+            if (flight.destination != airport->id) {
+                neighbours[airport->id].push_back(flight.destination);
+                neighbours[flight.destination].push_back(airport->id);
+            }
+    for (vector<int> &airportNeighbours: neighbours) {
+        sort(airportNeighbours.begin(), airportNeighbours.end());
+        airportNeighbours.erase(unique(airportNeighbours.begin(), airportNeighbours.end()), airportNeighbours.end());
+    }
+    return neighbours;
+}
+
+vector<int> Renumbering::bfsOrder(const vector<vector<int>> &neighbours) {
+    int numAirports = neighbours.size();
+    vector<int> sources(numAirports);
+    for (int airport = 0; airport < numAirports; airport++) sources[airport] = airport;
+    stable_sort(sources.begin(), sources.end(), [&neighbours](int first, int second) {
+        return neighbours[first].size() > neighbours[second].size();
+    });
+
+    vector<int> order;
+    order.reserve(numAirports);
+    vector<bool> visited(numAirports, false);
+    for (int source: sources) {
+        if (visited[source]) continue;
+        visited[source] = true;
+        order.push_back(source);
+        for (size_t next = order.size() - 1; next < order.size(); next++)
+            for (int neighbour: neighbours[order[next]])
+                if (!visited[neighbour]) {
+                    visited[neighbour] = true;
+                    order.push_back(neighbour);
+                }
+    }
+    return order;
+}
+
+vector<int> Renumbering::reverseCuthillMcKeeOrder(const vector<vector<int>> &neighbours) {
+    int numAirports = neighbours.size();
+    auto fewerNeighbours = [&neighbours](int first, int second) {
+        return neighbours[first].size() < neighbours[second].size();
+    };
+    vector<int> sources(numAirports);
+    for (int airport = 0; airport < numAirports; airport++) sources[airport] = airport;
+    stable_sort(sources.begin(), sources.end(), fewerNeighbours);
+
+    vector<int> order, visiting;
+    order.reserve(numAirports);
+    vector<bool> visited(numAirports, false);
+    for (int source: sources) {
+        if (visited[source]) continue;
+        visited[source] = true;
+        order.push_back(source);
+        for (size_t next = order.size() - 1; next < order.size(); next++) {
+            visiting.clear();
+            for (int neighbour: neighbours[order[next]])
+                if (!visited[neighbour]) {
+                    visited[neighbour] = true;
+                    visiting.push_back(neighbour);
+                }
+            stable_sort(visiting.begin(), visiting.end(), fewerNeighbours);
+            order.insert(order.end(), visiting.begin(), visiting.end());
+        }
+    }
+    reverse(order.begin(), order.end());
+    return order;
+}
+
+uint64_t Renumbering::hilbertIndex(int bits, uint32_t x, uint32_t y) {
+    uint64_t index = 0;
+    for (uint32_t side = 1u << (bits - 1); side > 0; side /= 2) {
+        uint32_t rx = (x & side) > 0, ry = (y & side) > 0;
+        index += (uint64_t) side * side * ((3 * rx) ^ ry);
+        if (!ry) {
+            if (rx) {
+                x = side - 1 - (x & (side - 1));
+                y = side - 1 - (y & (side - 1));
+            }
+            swap(x, y);
+        }
+        x &= side - 1;
+        y &= side - 1;
+    }
+    return index;
+}
+
+vector<int> Renumbering::hilbertOrder(const vector<AirportPTR> &airports) {
+    const int BITS = 16;
+    const double CELLS = (1u << BITS) - 1;
+    vector<pair<uint64_t, int>> positions;
+    positions.reserve(airports.size());
+    for (const AirportPTR &airport: airports) {
+        double latitude = min(90.0, max(-90.0, (double) airport->latitude));
+        double longitude = min(180.0, max(-180.0, (double) airport->longitude));
+        uint32_t x = (uint32_t) ((longitude + 180) / 360 * CELLS);
+        uint32_t y = (uint32_t) ((latitude + 90) / 180 * CELLS);
+        positions.emplace_back(hilbertIndex(BITS, x, y), airport->id);
+    }
+    sort(positions.begin(), positions.end());
+
+    vector<int> order;
+    order.reserve(positions.size());
+    for (const auto &position: positions) order.push_back(position.second);
+    return order;
+}
+
+vector<int> Renumbering::newIds(const vector<AirportPTR> &airports, Order order) {
+    vector<int> oldIds;
+    switch (order) {
+        case BFS:
+            oldIds = bfsOrder(neighboursOf(airports));
+            break;
+        case RCM:
+            oldIds = reverseCuthillMcKeeOrder(neighboursOf(airports));
+            break;
+        case HILBERT:
+            oldIds = hilbertOrder(airports);
+            break;
+        default:
+            for (int id = 0; id < (int) airports.size(); id++) oldIds.push_back(id);
+            break;
+    }
+
+    vector<int> ids(airports.size());
+    for (int position = 0; position < (int) oldIds.size(); position++)
+        ids[oldIds[position]] = position;
+    return ids;
+}
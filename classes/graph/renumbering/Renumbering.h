@@ -0,0 +1,93 @@
+/** @file Renumbering.h
+ *  @brief Contains the Renumbering class declaration.
+ *  @author -
+ *  @bug No known bugs.
+ */
+
+#ifndef AED_FEUP_PROJ_2_22_23_RENUMBERING_H
+#define AED_FEUP_PROJ_2_22_23_RENUMBERING_H
+
+#include <string>
+#include <vector>
+#include "../Airport/Airport.h"
+
+using namespace std;
+
+/** @brief Renumbering class to represent the orders the airports may be given ids in.
+ *
+ *  In the order of the input file, the airports a hub flies to are spread over the whole array,
+ *  so a search reads a different cache line for almost every airport it visits.
+ *  The other orders give close ids to airports that are close in the network, or on the map,
+ *  so the arrays indexed by id, and the flights of airports with close ids, are read together.
+ */
+class Renumbering {
+
+private:
+
+    /** @brief Returns the neighbours of every airport, in either direction, without repetitions.
+     *
+     * @param airports Of const vector<AirportPTR> type, by reference.
+     * @return vector<vector<int>> with the ids of the neighbours of each airport, ascending.
+     */
+    static vector<vector<int>> neighboursOf(const vector<AirportPTR> &airports);
+
+    /** @brief Orders the airports by a search from the airport with the most neighbours of each component.
+     *
+     * @param neighbours Of const vector<vector<int>> type, by reference.
+     * @return vector<int> with the old ids in their new order.
+     */
+    static vector<int> bfsOrder(const vector<vector<int>> &neighbours);
+
+    /** @brief Orders the airports by the reverse Cuthill-McKee algorithm.
+     *
+     * Each component is searched from an airport of the fewest neighbours,
+     * visiting the neighbours of each airport from the one with the fewest neighbours, and the order is reversed.
+     *
+     * @param neighbours Of const vector<vector<int>> type, by reference.
+     * @return vector<int> with the old ids in their new order.
+     */
+    static vector<int> reverseCuthillMcKeeOrder(const vector<vector<int>> &neighbours);
+
+    /** @brief Orders the airports along a Hilbert curve over their latitude and longitude.
+     *
+     * @param airports Of const vector<AirportPTR> type, by reference.
+     * @return vector<int> with the old ids in their new order.
+     */
+    static vector<int> hilbertOrder(const vector<AirportPTR> &airports);
+
+public:
+
+    //! @brief Defines the orders; the values are stored in the snapshot, so they must not change.
+    enum Order {
+        INPUT = 0, BFS = 1, RCM = 2, HILBERT = 3
+    };
+
+    /** @brief Reads the name of an order.
+     *
+     * @param name Of const string type, by reference, "input", "bfs", "rcm" or "hilbert".
+     * @param order Of Order type, by reference, set if the name is valid.
+     * @return True if the name is valid.
+     */
+    static bool parseOrder(const string &name, Order &order);
+
+    /** @brief Returns the position along a Hilbert curve of a point of a square grid.
+     *
+     * @param bits Of int type, the grid having 2^bits cells on each side.
+     * @param x Of uint32_t type.
+     * @param y Of uint32_t type.
+     * @return uint64_t.
+     */
+    static uint64_t hilbertIndex(int bits, uint32_t x, uint32_t y);
+
+    /** @brief Returns the new id of each airport in an order.
+     *
+     * Temporal Complexity: O(|A| log |A| + |F|), A represents the number of airports and F the number of flights.
+     *
+     * @param airports Of const vector<AirportPTR> type, by reference.
+     * @param order Of Order type.
+     * @return vector<int> with the new id of each airport, indexed by its old id.
+     */
+    static vector<int> newIds(const vector<AirportPTR> &airports, Order order);
+};
+
+#endif //AED_FEUP_PROJ_2_22_23_RENUMBERING_H
@@ -0,0 +1,55 @@
+/** @file Route.h
+ *  @brief Contains the route struct declaration.
+ *  @author -
+ *  @bug No known bugs.
+ */
+#ifndef AED_FEUP_PROJ_2_22_23_ROUTE_H
+#define AED_FEUP_PROJ_2_22_23_ROUTE_H
+
+#include <cstddef>
+
+/** @brief route struct to represent all the flights from an airport to another one.
+ *
+ */
+struct Route {
+
+    //! @brief Holds the id of the destination airport of the route.
+    int destination;
+
+    //! @brief Holds the position of the first airline of the route in the airlines of the route graph.
+    int firstAirline;
+
+    //! @brief Holds the number of different airlines that fly the route.
+    int numAirlines;
+
+    //! @brief Holds the number of flights of the route, one per line of the flights file.
+    int multiplicity;
+};
+
+/** @brief routeSpan struct to represent the routes that depart from an airport.
+ *
+ *  A non-owning view over consecutive routes of the routes array held by the route graph.
+ */
+struct RouteSpan {
+
+    //! @brief Holds the first route.
+    const Route *first = nullptr;
+
+    //! @brief Holds one past the last route.
+    const Route *last = nullptr;
+
+    //! @brief Returns the first route.
+    const Route *begin() const { return first; }
+
+    //! @brief Returns one past the last route.
+    const Route *end() const { return last; }
+
+    //! @brief Returns the number of routes.
+    size_t size() const { return last - first; }
+
+    //! @brief Returns true if there are no routes.
+    bool empty() const { return first == last; }
+};
+
+
+#endif //AED_FEUP_PROJ_2_22_23_ROUTE_H
@@ -0,0 +1,49 @@
+/** @file RouteGraph.cpp
+ *  @brief Contains the RouteGraph class implementation.
+ *  @author -
+ *  @bug No known bugs.
+ */
+
+#include "RouteGraph.h"
+#include <algorithm>
+
+void RouteGraph::build(const vector<AirportPTR> &airports) {
+    int numAirports = airports.size();
+    firstRoutes.assign(1, 0);
+    routes.clear();
+    airlines.clear();
+
+    // The route of each destination of the airport being read, valid while seenFrom holds that airport.
+    vector<int> routeTo(numAirports, -1), seenFrom(numAirports, -1);
+    vector<pair<int, int>> routeAirlines;
+    for (int airport = 0; airport < numAirports; airport++) {
+        routeAirlines.clear();
+        for (const Flight &flight: airports[airport]->flights) {
+            if (seenFrom[flight.destination] != airport) {
+                seenFrom[flight.destination] = airport;
+                routeTo[flight.destination] = routes.size();
+                routes.push_back({flight.destination, 0, 0, 0});
+            }
+            int route = routeTo[flight.destination];
+            routes[route].multiplicity++;
+            routeAirlines.emplace_back(route, flight.airline);
+        }
+
+        sort(routeAirlines.begin(), routeAirlines.end());
+        routeAirlines.erase(unique(routeAirlines.begin(), routeAirlines.end()), routeAirlines.end());
+        for (const pair<int, int> &routeAirline: routeAirlines) {
+            Route &route = routes[routeAirline.first];
+            if (route.numAirlines++ == 0) route.firstAirline = airlines.size();
+            airlines.push_back(routeAirline.second);
+        }
+        firstRoutes.push_back(routes.size());
+    }
+}
+
+size_t RouteGraph::getNumRoutes() const {
+    return routes.size();
+}
+
+size_t RouteGraph::bytes() const {
+    return firstRoutes.size() * sizeof(int) + routes.size() * sizeof(Route) + airlines.size() * sizeof(uint16_t);
+}
@@ -0,0 +1,95 @@
+/** @file RouteGraph.h
+ *  @brief Contains the RouteGraph class declaration.
+ *  @author -
+ *  @bug No known bugs.
+ */
+
+#ifndef AED_FEUP_PROJ_2_22_23_ROUTEGRAPH_H
+#define AED_FEUP_PROJ_2_22_23_ROUTEGRAPH_H
+
+#include <cstdint>
+#include <vector>
+#include "../Airport/Airport.h"
+#include "../Route/Route.h"
+
+using namespace std;
+
+/** @brief RouteGraph class to represent the flight map with one edge per pair of airports.
+ *
+ *  The flights file has a line per airline flying a route, so a busy route is many flights of its airport.
+ *  Here it is one route, with the airlines that fly it and the number of flights it stands for,
+ *  so the searches that do not care about airlines look at each pair of airports once.
+ *  The routes of an airport keep the order their first flight has among its flights,
+ *  so a search over the routes visits the airports in the same order as a search over the flights.
+ */
+class RouteGraph {
+
+private:
+
+    //! @brief Holds the position of the first route of each airport, and the number of routes at the end.
+    vector<int> firstRoutes;
+
+    //! @brief Holds the routes, grouped by source airport.
+    vector<Route> routes;
+
+    //! @brief Holds the ids of the airlines of each route, ascending, the routes one after the other.
+    vector<uint16_t> airlines;
+
+public:
+
+    /** @brief Builds the routes from the flights of the airports.
+     *
+     * Temporal Complexity: O(|A| + |F| log |F|), A represents the number of airports and F the number of flights.
+     *
+     * @param airports Of const vector<AirportPTR> type, by reference, indexed by id.
+     * @return Void.
+     */
+    void build(const vector<AirportPTR> &airports);
+
+    /** @brief Returns the routes that depart from an airport.
+     *
+     * @param airport Of int type, the id of the airport.
+     * @return RouteSpan.
+     */
+    RouteSpan getRoutes(int airport) const {
+        return {routes.data() + firstRoutes[airport], routes.data() + firstRoutes[airport + 1]};
+    }
+
+    /** @brief Returns true if any airline of a route is allowed.
+     *
+     * @param route Of const Route type, by reference.
+     * @param allowed Of const vector<bool> type, by reference, indexed by airline id.
+     * @return bool.
+     */
+    bool allows(const Route &route, const vector<bool> &allowed) const {
+        for (int i = route.firstAirline; i < route.firstAirline + route.numAirlines; i++)
+            if (allowed[airlines[i]]) return true;
+        return false;
+    }
+
+    /** @brief Returns the first airline of a route.
+     *
+     * @param route Of const Route type, by reference.
+     * @return const uint16_t* to the ids of the airlines, ascending.
+     */
+    const uint16_t *airlinesBegin(const Route &route) const {
+        return airlines.data() + route.firstAirline;
+    }
+
+    /** @brief Returns one past the last airline of a route.
+     *
+     * @param route Of const Route type, by reference.
+     * @return const uint16_t*.
+     */
+    const uint16_t *airlinesEnd(const Route &route) const {
+        return airlines.data() + route.firstAirline + route.numAirlines;
+    }
+
+    //! @brief Returns the number of routes.
+    size_t getNumRoutes() const;
+
+    //! @brief Returns the number of bytes the routes take.
+    size_t bytes() const;
+};
+
+#endif //AED_FEUP_PROJ_2_22_23_ROUTEGRAPH_H
@@ -0,0 +1,198 @@
+/** @file Timetable.cpp
+ *  @brief Contains the Timetable Class implementation.
+ *  @author -
+ *  @bug No known bugs.
+ */
+
+#include "Timetable.h"
+#include <algorithm>
+#include <climits>
+#include "../../Instrumentation/Instrumentation.h"
+
+const int Timetable::DAY;
+const int Timetable::MINIMUM_CONNECTION;
+
+//! @brief Defines the time of an airport that cannot be reached.
+static const int NEVER = INT_MAX;
+
+/** @brief profileEntry struct to represent a way to reach a destination from an airport.
+ *
+ */
+struct ProfileEntry {
+
+    //! @brief Holds the time the first flight departs.
+    int departure;
+
+    //! @brief Holds the time the destination is reached.
+    int arrival;
+
+    //! @brief Holds the index of the first connection.
+    int connection;
+};
+
+/** @brief Returns the earliest arrival at a destination leaving an airport at or after a time.
+ *
+ * The entries of an airport are added by decreasing departure, each arriving earlier than the one before,
+ * so the best one that leaves late enough is the last of those that do.
+ *
+ * @param entries Of const vector<ProfileEntry> type, by reference, the entries of an airport.
+ * @param time Of int type.
+ * @return const ProfileEntry*, null if none leaves late enough.
+ */
+static const ProfileEntry *earliestFrom(const vector<ProfileEntry> &entries, int time) {
+    auto late = partition_point(entries.begin(), entries.end(),
+                                [time](const ProfileEntry &entry) { return entry.departure >= time; });
+    return late == entries.begin() ? nullptr : &*(late - 1);
+}
+
+Timetable::Timetable() = default;
+
+void Timetable::setConnections(const vector<Connection> &connections, size_t numAirports) {
+    this->numAirports = numAirports;
+    this->connections.clear();
+    this->connections.reserve(2 * connections.size());
+
+    for (int day = 0; day < 2; day++)
+        for (Connection connection: connections) {
+            connection.departure += day * DAY;
+            connection.arrival += day * DAY;
+            this->connections.push_back(connection);
+        }
+
+    stable_sort(this->connections.begin(), this->connections.end(),
+                [](const Connection &first, const Connection &second) { return first.departure < second.departure; });
+}
+
+bool Timetable::empty() const {
+    return connections.empty();
+}
+
+size_t Timetable::size() const {
+    return connections.size() / 2;
+}
+
+Journey Timetable::earliestArrival(const vector<int> &origins, const vector<int> &destinations, int departure,
+                                   int minimumConnection) const {
+    INSTRUMENT_SCOPE("query/earliestArrival");
+
+    // The time each airport is reached, and the time a flight can be taken from it.
+    vector<int> arrival(numAirports, NEVER), ready(numAirports, NEVER), incoming(numAirports, -1);
+    vector<bool> isDestination(numAirports, false);
+    for (int origin: origins)
+        arrival[origin] = ready[origin] = departure;
+    for (int destination: destinations)
+        isDestination[destination] = arrival[destination] != departure;
+
+    int best = NEVER, target = -1;
+    auto first = partition_point(connections.begin(), connections.end(),
+                                 [departure](const Connection &connection) { return connection.departure < departure; });
+
+    auto connection = first;
+    for (; connection != connections.end() && connection->departure < best; ++connection) {
+        if (ready[connection->origin] > connection->departure || connection->arrival >= arrival[connection->destination])
+            continue;
+
+        arrival[connection->destination] = connection->arrival;
+        ready[connection->destination] = connection->arrival + minimumConnection;
+        incoming[connection->destination] = connection - connections.begin();
+        if (isDestination[connection->destination] && connection->arrival < best) {
+            best = connection->arrival;
+            target = connection->destination;
+        }
+    }
+    INSTRUMENT_COUNT("connections scanned", connection - first);
+
+    Journey journey;
+    for (int airport = target; airport != -1 && incoming[airport] != -1;
+         airport = connections[incoming[airport]].origin)
+        journey.push_back(connections[incoming[airport]]);
+    reverse(journey.begin(), journey.end());
+    return journey;
+}
+
+vector<Journey> Timetable::profile(const vector<int> &origins, const vector<int> &destinations,
+                                   int minimumConnection, const Deadline &deadline) const {
+    INSTRUMENT_SCOPE("query/profile");
+
+    vector<bool> isDestination(numAirports, false);
+    for (int destination: destinations)
+        isDestination[destination] = true;
+
+    vector<vector<ProfileEntry>> entries(numAirports);
+    for (int index = connections.size() - 1; index >= 0; index--) {
+        if (index % 4096 == 0) deadline.check();
+        const Connection &connection = connections[index];
+        if (isDestination[connection.origin]) continue;
+
+        int arrival = NEVER;
+        if (isDestination[connection.destination]) {
+            arrival = connection.arrival;
+        } else {
+            const ProfileEntry *next = earliestFrom(entries[connection.destination],
+                                                    connection.arrival + minimumConnection);
+            if (next) arrival = next->arrival;
+        }
+        if (arrival == NEVER) continue;
+
+        vector<ProfileEntry> &originEntries = entries[connection.origin];
+        if (!originEntries.empty() && arrival >= originEntries.back().arrival) continue;
+        if (!originEntries.empty() && originEntries.back().departure == connection.departure)
+            originEntries.back() = {connection.departure, arrival, index};
+        else
+            originEntries.push_back({connection.departure, arrival, index});
+    }
+    INSTRUMENT_COUNT("connections scanned", connections.size());
+
+    // The journeys of every origin leaving in the first day, without those another one dominates.
+    vector<ProfileEntry> starts;
+    for (int origin: origins)
+        if (!isDestination[origin])
+            for (const ProfileEntry &entry: entries[origin])
+                if (entry.departure < DAY) starts.push_back(entry);
+    sort(starts.begin(), starts.end(), [](const ProfileEntry &first, const ProfileEntry &second) {
+        return first.departure != second.departure ? first.departure > second.departure
+                                                   : first.arrival < second.arrival;
+    });
+
+    vector<Journey> journeys;
+    int bestArrival = NEVER;
+    for (const ProfileEntry &start: starts) {
+        if (start.arrival >= bestArrival) continue;
+        bestArrival = start.arrival;
+
+        Journey journey;
+        for (int index = start.connection;;) {
+            const Connection &connection = connections[index];
+            journey.push_back(connection);
+            if (isDestination[connection.destination]) break;
+            index = earliestFrom(entries[connection.destination], connection.arrival + minimumConnection)->connection;
+        }
+        journeys.push_back(journey);
+    }
+    reverse(journeys.begin(), journeys.end());
+    return journeys;
+}
+
+bool Timetable::parseTime(const string &text, int &minutes) {
+    size_t colon = text.find(':');
+    if (colon == string::npos || colon == 0 || colon > 2 || text.size() != colon + 3) return false;
+
+    int hours = 0, mins = 0;
+    for (size_t i = 0; i < text.size(); i++) {
+        if (i == colon) continue;
+        if (text[i] < '0' || text[i] > '9') return false;
+        if (i < colon) hours = hours * 10 + (text[i] - '0');
+        else mins = mins * 10 + (text[i] - '0');
+    }
+    if (hours >= 24 || mins >= 60) return false;
+
+    minutes = hours * 60 + mins;
+    return true;
+}
+
+string Timetable::formatTime(int minutes) {
+    int day = minutes / DAY, time = minutes % DAY;
+    string text = {char('0' + time / 600), char('0' + time / 60 % 10), ':',
+                   char('0' + time % 60 / 10), char('0' + time % 10)};
+    return day ? text + "+" + to_string(day) : text;
+}
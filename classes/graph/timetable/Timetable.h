@@ -0,0 +1,117 @@
+/** @file Timetable.h
+ *  @brief Contains the Timetable class declaration.
+ *  @author -
+ *  @bug No known bugs.
+ */
+
+#ifndef AED_FEUP_PROJ_2_22_23_TIMETABLE_H
+#define AED_FEUP_PROJ_2_22_23_TIMETABLE_H
+
+#include <string>
+#include <vector>
+#include "../Connection/Connection.h"
+#include "../../Deadline/Deadline.h"
+
+using namespace std;
+
+/** @brief Timetable class to find journeys that respect the departure and arrival times of the flights.
+ *
+ *  The schedule of a day repeats every day, so the connections of two days are kept,
+ *  letting journeys that leave late in the first day finish in the second.
+ *  They are held in a single array sorted by departure, which both searches read from one end to the other
+ *  with the Connection Scan Algorithm: a search is a linear pass over memory, with no priority queue.
+ *  Between two flights of a journey there must be at least a minimum connection time.
+ */
+class Timetable {
+
+    //! @brief Holds the connections of two days, sorted by departure.
+    vector<Connection> connections;
+
+    //! @brief Holds the number of airports.
+    size_t numAirports = 0;
+
+public:
+
+    //! @brief Defines the number of minutes in a day.
+    static const int DAY = 24 * 60;
+
+    //! @brief Defines the minimum connection time used when none is given, in minutes.
+    static const int MINIMUM_CONNECTION = 45;
+
+    /** Create a new, empty, Timetable.
+     *
+     * Does nothing.
+     */
+    Timetable();
+
+    /** @brief Sets the connections of a day, repeating them into the next.
+     *
+     * Temporal Complexity: O(C log C), C being the number of connections.
+     *
+     * @param connections Of const vector<Connection> type, by reference, departing in [0, DAY).
+     * @param numAirports Of size_t type.
+     * @return Void.
+     */
+    void setConnections(const vector<Connection> &connections, size_t numAirports);
+
+    /** @brief Returns true if there are no connections.
+     *
+     * @return bool.
+     */
+    bool empty() const;
+
+    /** @brief Returns the number of connections of a day.
+     *
+     * @return size_t.
+     */
+    size_t size() const;
+
+    /** @brief Returns the journey that arrives first at any of the destinations,
+     * leaving any of the origins at or after a time.
+     *
+     * Scans the connections from the departure time on, stopping once they leave after the best arrival found.
+     * Temporal Complexity: O(A + C), A being the number of airports and C the number of connections.
+     *
+     * @param origins Of const vector<int> type, by reference, the ids of the origin airports.
+     * @param destinations Of const vector<int> type, by reference, the ids of the destination airports.
+     * @param departure Of int type, in [0, DAY).
+     * @param minimumConnection Of int type, in minutes.
+     * @return Journey, empty if no destination can be reached.
+     */
+    Journey earliestArrival(const vector<int> &origins, const vector<int> &destinations, int departure,
+                            int minimumConnection) const;
+
+    /** @brief Returns, for departures across the first day, every journey no other one both leaves later
+     * and arrives earlier than.
+     *
+     * Scans the connections from the last to the first, keeping for each airport the Pareto-optimal pairs
+     * of departure and arrival at a destination.
+     * Temporal Complexity: O(A + C log C), A being the number of airports and C the number of connections.
+     *
+     * @param origins Of const vector<int> type, by reference, the ids of the origin airports.
+     * @param destinations Of const vector<int> type, by reference, the ids of the destination airports.
+     * @param minimumConnection Of int type, in minutes.
+     * @param deadline Of const Deadline type, by reference, checked every few thousand connections.
+     * @return vector<Journey>, sorted by departure.
+     * @throws DeadlineExceeded if the deadline passes during the scan.
+     */
+    vector<Journey> profile(const vector<int> &origins, const vector<int> &destinations,
+                            int minimumConnection, const Deadline &deadline = Deadline()) const;
+
+    /** @brief Reads a time written as "HH:MM".
+     *
+     * @param text Of const string type, by reference.
+     * @param minutes Of int type, by reference, set to the minutes since midnight if the time is valid.
+     * @return bool true if the time is valid.
+     */
+    static bool parseTime(const string &text, int &minutes);
+
+    /** @brief Writes a time as "HH:MM", followed by "+d" if it is d days after the first.
+     *
+     * @param minutes Of int type.
+     * @return string.
+     */
+    static string formatTime(int minutes);
+};
+
+#endif //AED_FEUP_PROJ_2_22_23_TIMETABLE_H
@@ -0,0 +1,39 @@
+/** @file Traversal.cpp
+ *  @brief Contains the Traversal Class implementation.
+ *  @author -
+ *  @bug No known bugs.
+ */
+
+#include "Traversal.h"
+#include <algorithm>
+
+Traversal::Traversal(size_t numAirports) :
+        stamps(numAirports, 0), epoch(1), dist(numAirports, 0), parent(numAirports, -1),
+        parentFlight(numAirports), num(numAirports, 0), low(numAirports, 0), inStack(numAirports, false) {}
+
+Traversal::~Traversal() {
+    count();
+}
+
+void Traversal::count() {
+#ifdef INSTRUMENTATION
+    INSTRUMENT_COUNT("airports visited", visited);
+    INSTRUMENT_COUNT("flights relaxed", relaxed);
+    visited = relaxed = 0;
+#endif
+}
+
+void Traversal::reset() {
+    count();
+    if (++epoch == 0) {
+        fill(stamps.begin(), stamps.end(), 0);
+        epoch = 1;
+    }
+}
+
+list<Flight> Traversal::getPath(int id) const {
+    list<Flight> path;
+    for (int airport = id; parent[airport] != -1; airport = parent[airport])
+        path.push_front(parentFlight[airport]);
+    return path;
+}
@@ -0,0 +1,198 @@
+/** @file Traversal.h
+ *  @brief Contains the Traversal class declaration.
+ *  @author -
+ *  @bug No known bugs.
+ */
+
+#ifndef AED_FEUP_PROJ_2_22_23_TRAVERSAL_H
+#define AED_FEUP_PROJ_2_22_23_TRAVERSAL_H
+
+#include <list>
+#include <vector>
+#include "../Flight/Flight.h"
+#include "../Route/Route.h"
+#include "../../Instrumentation/Instrumentation.h"
+
+using namespace std;
+
+/** @brief Traversal class to represent the state of a search over the flight map.
+ *
+ *  Holds, indexed by airport id, what a BFS or DFS writes while it runs,
+ *  so the airports and the flight map stay read-only and several searches can run at once,
+ *  each with its own Traversal.
+ *  Resetting only starts a new epoch: an airport counts as visited when it was stamped in the current one.
+ */
+class Traversal {
+
+private:
+
+    //! @brief Holds the epoch each airport was last visited in.
+    vector<unsigned> stamps;
+
+    //! @brief Holds the current epoch.
+    unsigned epoch = 0;
+
+#ifdef INSTRUMENTATION
+    //! @brief Holds the number of airports visited since the counts were last added to the instrumentation.
+    long long visited = 0;
+
+    //! @brief Holds the number of flights looked at since the counts were last added to the instrumentation.
+    long long relaxed = 0;
+#endif
+
+    /** @brief Adds the airports visited and the flights looked at to the instrumentation counters.
+     *
+     * @return Void.
+     */
+    void count();
+
+public:
+
+    //! @brief Holds the distance of each visited airport from the source airport.
+    vector<int> dist;
+
+    //! @brief Holds the airport each visited airport was reached from, -1 for the source airport.
+    vector<int> parent;
+
+    //! @brief Holds the flight each visited airport was reached by.
+    vector<Flight> parentFlight;
+
+    //! @brief Holds the num of each visited airport.
+    vector<int> num;
+
+    //! @brief Holds the low of each visited airport.
+    vector<int> low;
+
+    //! @brief Holds true if the airport is in the stack or false if otherwise.
+    vector<bool> inStack;
+
+    /** Create a new Traversal for a flight map with the given number of airports.
+     *
+     * @param numAirports Of size_t type.
+     */
+    explicit Traversal(size_t numAirports);
+
+    Traversal(const Traversal &) = delete;
+
+    Traversal &operator=(const Traversal &) = delete;
+
+    /** Adds what was not counted yet to the instrumentation.
+     */
+    ~Traversal();
+
+    /** @brief Marks every airport as not visited.
+     *
+     * Also adds what the last search did to the instrumentation.
+     * Temporal Complexity: O(1), except once every 2^32 resets.
+     *
+     * @return Void.
+     */
+    void reset();
+
+    /** @brief Returns true if the airport was visited since the last reset.
+     *
+     * @param id Of int type.
+     * @return bool.
+     */
+    bool isVisited(int id) const {
+        return stamps[id] == epoch;
+    }
+
+    /** @brief Marks an airport as visited, as the source of a search.
+     *
+     * @param id Of int type.
+     * @return Void.
+     */
+    void visit(int id) {
+#ifdef INSTRUMENTATION
+        visited++;
+#endif
+        stamps[id] = epoch;
+        dist[id] = 0;
+        parent[id] = -1;
+    }
+
+    /** @brief Marks an airport as visited, reached from another one by a flight.
+     *
+     * @param id Of int type.
+     * @param previous Of int type, the id of the airport it was reached from.
+     * @param flight Of const Flight type, by reference.
+     * @return Void.
+     */
+    void visit(int id, int previous, const Flight &flight) {
+#ifdef INSTRUMENTATION
+        visited++;
+#endif
+        stamps[id] = epoch;
+        dist[id] = dist[previous] + 1;
+        parent[id] = previous;
+        parentFlight[id] = flight;
+    }
+
+    /** @brief Marks an airport as visited, reached from another one by a route.
+     *
+     * The flight it was reached by is not kept, so its path can not be asked for.
+     *
+     * @param id Of int type.
+     * @param previous Of int type, the id of the airport it was reached from.
+     * @return Void.
+     */
+    void visit(int id, int previous) {
+#ifdef INSTRUMENTATION
+        visited++;
+#endif
+        stamps[id] = epoch;
+        dist[id] = dist[previous] + 1;
+        parent[id] = previous;
+    }
+
+    /** @brief Counts the flights of an airport, about to be looked at.
+     *
+     * @param flights Of const FlightSpan type, by reference.
+     * @return Void.
+     */
+    void relax(const FlightSpan &flights) {
+#ifdef INSTRUMENTATION
+        relaxed += flights.size();
+#else
+        (void) flights;
+#endif
+    }
+
+    /** @brief Counts some flights of an airport, about to be looked at.
+     *
+     * @param flights Of size_t type, the number of flights.
+     * @return Void.
+     */
+    void relax(size_t flights) {
+#ifdef INSTRUMENTATION
+        relaxed += flights;
+#else
+        (void) flights;
+#endif
+    }
+
+    /** @brief Counts the routes of an airport, about to be looked at, as flights.
+     *
+     * @param routes Of const RouteSpan type, by reference.
+     * @return Void.
+     */
+    void relax(const RouteSpan &routes) {
+#ifdef INSTRUMENTATION
+        relaxed += routes.size();
+#else
+        (void) routes;
+#endif
+    }
+
+    /** @brief Returns the flights taken from the source airport to a visited airport.
+     *
+     * Temporal Complexity: O(d), d being the distance of the airport.
+     *
+     * @param id Of int type.
+     * @return list<Flight> of flights, in order.
+     */
+    list<Flight> getPath(int id) const;
+};
+
+#endif //AED_FEUP_PROJ_2_22_23_TRAVERSAL_H
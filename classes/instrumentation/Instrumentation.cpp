@@ -0,0 +1,135 @@
+/** @file Instrumentation.cpp
+ *  @brief Contains the Instrumentation Class implementation.
+ *  @author -
+ *  @bug No known bugs.
+ */
+
+#include "Instrumentation.h"
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+
+const int Instrumentation::Histogram::SUB_BUCKET_BITS;
+const int Instrumentation::Histogram::SUB_BUCKETS;
+const int Instrumentation::Histogram::BUCKETS;
+
+Instrumentation::Histogram::Histogram() {
+    for (atomic<uint64_t> &count: counts)
+        count.store(0, memory_order_relaxed);
+}
+
+int Instrumentation::Histogram::bucketOf(uint64_t value) {
+    if (value < (uint64_t) SUB_BUCKETS) return (int) value;
+
+    int highest = 0;
+    for (int shift = 32; shift; shift /= 2)
+        if (value >> (highest + shift)) highest += shift;
+
+    int subBucket = (int) (value >> (highest - SUB_BUCKET_BITS)) - SUB_BUCKETS;
+    return (highest - SUB_BUCKET_BITS + 1) * SUB_BUCKETS + subBucket;
+}
+
+uint64_t Instrumentation::Histogram::lowestOf(int bucket) {
+    if (bucket < SUB_BUCKETS) return bucket;
+    int highest = bucket / SUB_BUCKETS + SUB_BUCKET_BITS - 1;
+    return (uint64_t) (SUB_BUCKETS + bucket % SUB_BUCKETS) << (highest - SUB_BUCKET_BITS);
+}
+
+void Instrumentation::Histogram::record(uint64_t value) {
+    counts[bucketOf(value)].fetch_add(1, memory_order_relaxed);
+    total.fetch_add(1, memory_order_relaxed);
+    sum.fetch_add(value, memory_order_relaxed);
+
+    uint64_t largest = maximum.load(memory_order_relaxed);
+    while (value > largest && !maximum.compare_exchange_weak(largest, value, memory_order_relaxed));
+}
+
+uint64_t Instrumentation::Histogram::getCount() const {
+    return total.load(memory_order_relaxed);
+}
+
+double Instrumentation::Histogram::getMean() const {
+    uint64_t count = getCount();
+    return count ? (double) sum.load(memory_order_relaxed) / count : 0;
+}
+
+uint64_t Instrumentation::Histogram::getMaximum() const {
+    return maximum.load(memory_order_relaxed);
+}
+
+uint64_t Instrumentation::Histogram::getPercentile(double share) const {
+    uint64_t count = getCount();
+    if (!count) return 0;
+
+    uint64_t target = max<uint64_t>(1, (uint64_t) ceil(share * count)), seen = 0;
+    for (int bucket = 0; bucket < BUCKETS; bucket++) {
+        seen += counts[bucket].load(memory_order_relaxed);
+        if (seen >= target) {
+            // The middle of the bucket, but never above the largest value recorded.
+            uint64_t lowest = lowestOf(bucket), width = bucket + 1 < BUCKETS ? lowestOf(bucket + 1) - lowest : 0;
+            return min(lowest + width / 2, getMaximum());
+        }
+    }
+    return getMaximum();
+}
+
+Instrumentation &Instrumentation::global() {
+    static Instrumentation instrumentation;
+    return instrumentation;
+}
+
+bool Instrumentation::isEnabled() {
+#ifdef INSTRUMENTATION
+    return true;
+#else
+    return false;
+#endif
+}
+
+Instrumentation::Histogram &Instrumentation::histogram(const string &name) {
+    lock_guard<mutex> guard(lock);
+    unique_ptr<Histogram> &histogram = histograms[name];
+    if (!histogram) histogram.reset(new Histogram());
+    return *histogram;
+}
+
+Instrumentation::Counter &Instrumentation::counter(const string &name) {
+    lock_guard<mutex> guard(lock);
+    unique_ptr<Counter> &counter = counters[name];
+    if (!counter) counter.reset(new Counter());
+    return *counter;
+}
+
+void Instrumentation::report(ostream &output) const {
+    if (!isEnabled()) {
+        output << "Instrumentation was not compiled in: configure with -DINSTRUMENTATION=ON." << endl;
+        return;
+    }
+
+    lock_guard<mutex> guard(lock);
+    char line[160];
+
+    output << "======= Timers (us) =======" << endl;
+    snprintf(line, sizeof(line), "%-40s %10s %12s %12s %12s %12s", "", "count", "mean", "p50", "p99", "max");
+    output << line << endl;
+    for (const auto &entry: histograms) {
+        const Histogram &histogram = *entry.second;
+        snprintf(line, sizeof(line), "%-40s %10llu %12.1f %12.1f %12.1f %12.1f", entry.first.c_str(),
+                 (unsigned long long) histogram.getCount(), histogram.getMean() / 1000,
+                 histogram.getPercentile(0.5) / 1000.0, histogram.getPercentile(0.99) / 1000.0,
+                 histogram.getMaximum() / 1000.0);
+        output << line << endl;
+    }
+
+    output << endl << "======= Counters =======" << endl;
+    for (const auto &entry: counters) {
+        snprintf(line, sizeof(line), "%-40s %14lld", entry.first.c_str(), entry.second->get());
+        output << line << endl;
+    }
+}
+
+bool Instrumentation::dump(const string &path) const {
+    ofstream file(path);
+    report(file);
+    return (bool) file;
+}
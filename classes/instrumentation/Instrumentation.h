@@ -0,0 +1,249 @@
+/** @file Instrumentation.h
+ *  @brief Contains the Instrumentation class declaration and the instrumentation macros.
+ *  @author -
+ *  @bug No known bugs.
+ */
+
+#ifndef AED_FEUP_PROJ_2_22_23_INSTRUMENTATION_H
+#define AED_FEUP_PROJ_2_22_23_INSTRUMENTATION_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+
+using namespace std;
+
+/** @brief Instrumentation class to time the phases of the startup and the queries, and count the work they do.
+ *
+ *  Holds, by name, latency histograms and counters, created the first time they are used and kept until exit.
+ *  They are meant to be used through the INSTRUMENT_SCOPE and INSTRUMENT_COUNT macros, which look a name up
+ *  once per call site and compile to nothing unless INSTRUMENTATION is defined.
+ *  Recording only takes relaxed atomic additions, so it can be done from any thread.
+ */
+class Instrumentation {
+
+public:
+
+    /** @brief Histogram class to record latencies with a bounded relative error.
+     *
+     *  Like an HDR histogram, each power of two is split into SUB_BUCKETS buckets of equal width,
+     *  so any latency, from nanoseconds to hours, is kept within about 6% with a fixed number of buckets.
+     */
+    class Histogram {
+
+        //! @brief Defines the number of bits of a value, after its highest one, that select its bucket.
+        static const int SUB_BUCKET_BITS = 4;
+
+        //! @brief Defines the number of buckets each power of two is split into.
+        static const int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+
+        //! @brief Defines the number of buckets, enough for any 64 bit value.
+        static const int BUCKETS = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+        //! @brief Holds the number of values recorded in each bucket.
+        atomic<uint64_t> counts[BUCKETS];
+
+        //! @brief Holds the number of values recorded.
+        atomic<uint64_t> total{0};
+
+        //! @brief Holds the sum of the values recorded.
+        atomic<uint64_t> sum{0};
+
+        //! @brief Holds the largest value recorded.
+        atomic<uint64_t> maximum{0};
+
+        /** @brief Returns the bucket of a value.
+         *
+         * @param value Of uint64_t type.
+         * @return int.
+         */
+        static int bucketOf(uint64_t value);
+
+        /** @brief Returns the smallest value of a bucket.
+         *
+         * @param bucket Of int type.
+         * @return uint64_t.
+         */
+        static uint64_t lowestOf(int bucket);
+
+    public:
+
+        /** Creates a new, empty, Histogram.
+         */
+        Histogram();
+
+        /** @brief Records a value.
+         *
+         * @param value Of uint64_t type, in nanoseconds for the timers.
+         * @return Void.
+         */
+        void record(uint64_t value);
+
+        /** @brief Returns the number of values recorded.
+         *
+         * @return uint64_t.
+         */
+        uint64_t getCount() const;
+
+        /** @brief Returns the mean of the values recorded.
+         *
+         * @return double, 0 if there are none.
+         */
+        double getMean() const;
+
+        /** @brief Returns the largest value recorded.
+         *
+         * @return uint64_t.
+         */
+        uint64_t getMaximum() const;
+
+        /** @brief Returns the value a share of the recorded values are at most, within the error of its bucket.
+         *
+         * @param share Of double type, between 0 and 1.
+         * @return uint64_t, 0 if there are no values.
+         */
+        uint64_t getPercentile(double share) const;
+    };
+
+    /** @brief Counter class to count the work done, like the airports visited.
+     */
+    class Counter {
+
+        //! @brief Holds the count.
+        atomic<long long> value{0};
+
+    public:
+
+        /** @brief Adds to the count.
+         *
+         * @param amount Of long long type.
+         * @return Void.
+         */
+        void add(long long amount) {
+            value.fetch_add(amount, memory_order_relaxed);
+        }
+
+        /** @brief Returns the count.
+         *
+         * @return long long.
+         */
+        long long get() const {
+            return value.load(memory_order_relaxed);
+        }
+    };
+
+    /** @brief ScopedTimer class to record, in a histogram, the time from its creation to the end of its scope.
+     */
+    class ScopedTimer {
+
+        //! @brief Holds the histogram the time is recorded in.
+        Histogram &histogram;
+
+        //! @brief Holds the time the timer was created.
+        chrono::steady_clock::time_point start;
+
+    public:
+
+        /** Creates a new ScopedTimer and starts it.
+         *
+         * @param histogram Of Histogram type, by reference.
+         */
+        explicit ScopedTimer(Histogram &histogram) : histogram(histogram), start(chrono::steady_clock::now()) {}
+
+        ScopedTimer(const ScopedTimer &) = delete;
+
+        ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+        /** Records the time since the timer was created.
+         */
+        ~ScopedTimer() {
+            histogram.record(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count());
+        }
+    };
+
+private:
+
+    //! @brief Holds the histograms by name, each kept at the same address until exit.
+    map<string, unique_ptr<Histogram>> histograms;
+
+    //! @brief Holds the counters by name, each kept at the same address until exit.
+    map<string, unique_ptr<Counter>> counters;
+
+    //! @brief Guards the histograms and the counters maps.
+    mutable mutex lock;
+
+public:
+
+    /** @brief Returns the instrumentation of the process.
+     *
+     * @return Instrumentation, by reference.
+     */
+    static Instrumentation &global();
+
+    /** @brief Returns true if the library was built with INSTRUMENTATION defined, so the macros record.
+     *
+     * @return bool.
+     */
+    static bool isEnabled();
+
+    /** @brief Returns the histogram with the given name, creating it if needed.
+     *
+     * @param name Of const string type, by reference.
+     * @return Histogram, by reference.
+     */
+    Histogram &histogram(const string &name);
+
+    /** @brief Returns the counter with the given name, creating it if needed.
+     *
+     * @param name Of const string type, by reference.
+     * @return Counter, by reference.
+     */
+    Counter &counter(const string &name);
+
+    /** @brief Writes a table of the histograms, in microseconds, and the counters.
+     *
+     * @param output Of ostream type, by reference.
+     * @return Void.
+     */
+    void report(ostream &output) const;
+
+    /** @brief Writes the report to a file.
+     *
+     * @param path Of const string type, by reference.
+     * @return bool true if the file was written.
+     */
+    bool dump(const string &path) const;
+};
+
+#define INSTRUMENTATION_CONCAT_(first, second) first##second
+#define INSTRUMENTATION_CONCAT(first, second) INSTRUMENTATION_CONCAT_(first, second)
+
+#ifdef INSTRUMENTATION
+
+//! @brief Times the rest of the enclosing scope into the histogram with the given name.
+#define INSTRUMENT_SCOPE(name)                                                                             \
+    static Instrumentation::Histogram &INSTRUMENTATION_CONCAT(instrumentationHistogram, __LINE__) =        \
+            Instrumentation::global().histogram(name);                                                     \
+    Instrumentation::ScopedTimer INSTRUMENTATION_CONCAT(instrumentationTimer, __LINE__)(                   \
+            INSTRUMENTATION_CONCAT(instrumentationHistogram, __LINE__))
+
+//! @brief Adds an amount to the counter with the given name.
+#define INSTRUMENT_COUNT(name, amount)                                                                     \
+    do {                                                                                                   \
+        static Instrumentation::Counter &instrumentationCounter = Instrumentation::global().counter(name); \
+        instrumentationCounter.add(amount);                                                                \
+    } while (false)
+
+#else
+
+#define INSTRUMENT_SCOPE(name) ((void) 0)
+#define INSTRUMENT_COUNT(name, amount) ((void) 0)
+
+#endif
+
+#endif //AED_FEUP_PROJ_2_22_23_INSTRUMENTATION_H
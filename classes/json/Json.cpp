@@ -0,0 +1,323 @@
+/** @file Json.cpp
+ *  @brief Contains the Json Class implementation.
+ *  @author -
+ *  @bug No known bugs.
+ */
+
+#include "Json.h"
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <sstream>
+#include <stdexcept>
+
+//! @brief Defines how deep arrays and objects can be nested, so the recursion stays bounded.
+static const int MAX_DEPTH = 64;
+
+/** @brief Moves past spaces, tabs and line breaks.
+ *
+ * @param input Of const string type, by reference.
+ * @param position Of size_t type, by reference.
+ * @return Void.
+ */
+static void skipSpaces(const string &input, size_t &position) {
+    while (position < input.size() &&
+           (input[position] == ' ' || input[position] == '\t' || input[position] == '\n' || input[position] == '\r'))
+        position++;
+}
+
+/** @brief Appends a code point to a string, encoded in UTF-8.
+ *
+ * @param output Of string type, by reference.
+ * @param codePoint Of unsigned type.
+ * @return Void.
+ */
+static void appendUtf8(string &output, unsigned codePoint) {
+    if (codePoint < 0x80) {
+        output += (char) codePoint;
+    } else if (codePoint < 0x800) {
+        output += (char) (0xC0 | codePoint >> 6);
+        output += (char) (0x80 | (codePoint & 0x3F));
+    } else if (codePoint < 0x10000) {
+        output += (char) (0xE0 | codePoint >> 12);
+        output += (char) (0x80 | (codePoint >> 6 & 0x3F));
+        output += (char) (0x80 | (codePoint & 0x3F));
+    } else {
+        output += (char) (0xF0 | codePoint >> 18);
+        output += (char) (0x80 | (codePoint >> 12 & 0x3F));
+        output += (char) (0x80 | (codePoint >> 6 & 0x3F));
+        output += (char) (0x80 | (codePoint & 0x3F));
+    }
+}
+
+/** @brief Reads the four hexadecimal digits of a \\u escape.
+ *
+ * @param input Of const string type, by reference.
+ * @param position Of size_t type, by reference, moved past the digits.
+ * @return unsigned value of the digits.
+ */
+static unsigned parseHex(const string &input, size_t &position) {
+    if (position + 4 > input.size()) throw invalid_argument("unterminated escape");
+
+    unsigned value = 0;
+    for (int i = 0; i < 4; i++) {
+        char digit = input[position++];
+        value <<= 4;
+        if (digit >= '0' && digit <= '9') value |= digit - '0';
+        else if (digit >= 'a' && digit <= 'f') value |= digit - 'a' + 10;
+        else if (digit >= 'A' && digit <= 'F') value |= digit - 'A' + 10;
+        else throw invalid_argument("bad escape");
+    }
+    return value;
+}
+
+Json::Json() = default;
+
+Json Json::parse(const string &input) {
+    size_t position = 0;
+    Json value = parseValue(input, position, 0);
+    skipSpaces(input, position);
+    if (position != input.size()) throw invalid_argument("unexpected text after the value");
+    return value;
+}
+
+string Json::parseString(const string &input, size_t &position) {
+    string value;
+    position++;
+
+    while (true) {
+        if (position >= input.size()) throw invalid_argument("unterminated string");
+        char c = input[position++];
+
+        if (c == '"') return value;
+        if ((unsigned char) c < 0x20) throw invalid_argument("control character in string");
+        if (c != '\\') {
+            value += c;
+            continue;
+        }
+
+        if (position >= input.size()) throw invalid_argument("unterminated string");
+        switch (input[position++]) {
+            case '"': value += '"'; break;
+            case '\\': value += '\\'; break;
+            case '/': value += '/'; break;
+            case 'b': value += '\b'; break;
+            case 'f': value += '\f'; break;
+            case 'n': value += '\n'; break;
+            case 'r': value += '\r'; break;
+            case 't': value += '\t'; break;
+            case 'u': {
+                unsigned codePoint = parseHex(input, position);
+                if (codePoint >= 0xD800 && codePoint < 0xDC00 && input.compare(position, 2, "\\u") == 0) {
+                    position += 2;
+                    unsigned low = parseHex(input, position);
+                    if (low < 0xDC00 || low >= 0xE000) throw invalid_argument("bad surrogate pair");
+                    codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                }
+                appendUtf8(value, codePoint);
+                break;
+            }
+            default:
+                throw invalid_argument("bad escape");
+        }
+    }
+}
+
+Json Json::parseValue(const string &input, size_t &position, int depth) {
+    if (depth > MAX_DEPTH) throw invalid_argument("too deeply nested");
+    skipSpaces(input, position);
+    if (position >= input.size()) throw invalid_argument("unexpected end of input");
+
+    Json value;
+    char c = input[position];
+
+    if (c == '{') {
+        value.type = OBJECT;
+        position++;
+        skipSpaces(input, position);
+        if (position < input.size() && input[position] == '}') {
+            position++;
+            return value;
+        }
+        while (true) {
+            skipSpaces(input, position);
+            if (position >= input.size() || input[position] != '"') throw invalid_argument("expected a member name");
+            string key = parseString(input, position);
+
+            skipSpaces(input, position);
+            if (position >= input.size() || input[position] != ':') throw invalid_argument("expected ':'");
+            position++;
+            value.members.emplace_back(key, parseValue(input, position, depth + 1));
+
+            skipSpaces(input, position);
+            if (position < input.size() && input[position] == ',') {
+                position++;
+                continue;
+            }
+            if (position < input.size() && input[position] == '}') {
+                position++;
+                return value;
+            }
+            throw invalid_argument("expected ',' or '}'");
+        }
+    }
+
+    if (c == '[') {
+        value.type = ARRAY;
+        position++;
+        skipSpaces(input, position);
+        if (position < input.size() && input[position] == ']') {
+            position++;
+            return value;
+        }
+        while (true) {
+            value.items.push_back(parseValue(input, position, depth + 1));
+
+            skipSpaces(input, position);
+            if (position < input.size() && input[position] == ',') {
+                position++;
+                continue;
+            }
+            if (position < input.size() && input[position] == ']') {
+                position++;
+                return value;
+            }
+            throw invalid_argument("expected ',' or ']'");
+        }
+    }
+
+    if (c == '"') {
+        value.type = STRING;
+        value.text = parseString(input, position);
+        return value;
+    }
+
+    if (input.compare(position, 4, "true") == 0 || input.compare(position, 5, "false") == 0) {
+        value.type = BOOLEAN;
+        value.boolean = c == 't';
+        position += value.boolean ? 4 : 5;
+        return value;
+    }
+
+    if (input.compare(position, 4, "null") == 0) {
+        position += 4;
+        return value;
+    }
+
+    if (c == '-' || (c >= '0' && c <= '9')) {
+        size_t end = position;
+        while (end < input.size() && (isdigit((unsigned char) input[end]) || input[end] == '-' ||
+                                      input[end] == '+' || input[end] == '.' || input[end] == 'e' || input[end] == 'E'))
+            end++;
+
+        string digits = input.substr(position, end - position);
+        char *parsed = nullptr;
+        value.number = strtod(digits.c_str(), &parsed);
+        if (parsed != digits.c_str() + digits.size()) throw invalid_argument("bad number");
+
+        value.type = NUMBER;
+        position = end;
+        return value;
+    }
+
+    throw invalid_argument("unexpected character");
+}
+
+string Json::quote(const string &value) {
+    string output = "\"";
+    for (char c: value) {
+        switch (c) {
+            case '"': output += "\\\""; break;
+            case '\\': output += "\\\\"; break;
+            case '\n': output += "\\n"; break;
+            case '\r': output += "\\r"; break;
+            case '\t': output += "\\t"; break;
+            default:
+                if ((unsigned char) c < 0x20) {
+                    const char *hex = "0123456789abcdef";
+                    output += "\\u00";
+                    output += hex[c >> 4];
+                    output += hex[c & 0xF];
+                } else {
+                    output += c;
+                }
+        }
+    }
+    return output + "\"";
+}
+
+string Json::dump() const {
+    switch (type) {
+        case BOOLEAN:
+            return boolean ? "true" : "false";
+        case NUMBER: {
+            ostringstream output;
+            if (number == floor(number) && fabs(number) < 1e15) {
+                output << (long long) number;
+            } else {
+                output.precision(17);
+                output << number;
+            }
+            return output.str();
+        }
+        case STRING:
+            return quote(text);
+        case ARRAY: {
+            string output = "[";
+            for (size_t i = 0; i < items.size(); i++)
+                output += (i ? "," : "") + items[i].dump();
+            return output + "]";
+        }
+        case OBJECT: {
+            string output = "{";
+            for (size_t i = 0; i < members.size(); i++)
+                output += (i ? "," : "") + quote(members[i].first) + ":" + members[i].second.dump();
+            return output + "}";
+        }
+        default:
+            return "null";
+    }
+}
+
+Json::Type Json::getType() const {
+    return type;
+}
+
+bool Json::has(const string &key) const {
+    for (const auto &member: members)
+        if (member.first == key) return true;
+    return false;
+}
+
+const Json &Json::operator[](const string &key) const {
+    static const Json null;
+    for (const auto &member: members)
+        if (member.first == key) return member.second;
+    return null;
+}
+
+const vector<Json> &Json::getItems() const {
+    if (type != ARRAY) throw invalid_argument("expected an array");
+    return items;
+}
+
+const string &Json::asString() const {
+    if (type != STRING) throw invalid_argument("expected a string");
+    return text;
+}
+
+double Json::asNumber() const {
+    if (type != NUMBER) throw invalid_argument("expected a number");
+    return number;
+}
+
+int Json::asInt() const {
+    double value = asNumber();
+    if (value != floor(value) || fabs(value) > 1e9) throw invalid_argument("expected an integer");
+    return (int) value;
+}
+
+bool Json::asBool() const {
+    if (type != BOOLEAN) throw invalid_argument("expected true or false");
+    return boolean;
+}
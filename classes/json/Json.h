@@ -0,0 +1,130 @@
+/** @file Json.h
+ *  @brief Contains the Json class declaration.
+ *  @author -
+ *  @bug No known bugs.
+ */
+
+#ifndef AED_FEUP_PROJ_2_22_23_JSON_H
+#define AED_FEUP_PROJ_2_22_23_JSON_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+/** @brief Json class to represent a JSON value.
+ *
+ *  A minimal reader and writer, enough for one query or one result per line:
+ *  no comments, and numbers are read as doubles.
+ *  Malformed input and accesses of the wrong type throw invalid_argument with a short explanation.
+ */
+class Json {
+
+public:
+
+    //! @brief Defines the types a value can have.
+    enum Type {
+        NUL, BOOLEAN, NUMBER, STRING, ARRAY, OBJECT
+    };
+
+private:
+
+    //! @brief Holds the type of the value.
+    Type type = NUL;
+
+    //! @brief Holds the value of a boolean.
+    bool boolean = false;
+
+    //! @brief Holds the value of a number.
+    double number = 0;
+
+    //! @brief Holds the value of a string.
+    string text;
+
+    //! @brief Holds the items of an array.
+    vector<Json> items;
+
+    //! @brief Holds the members of an object, in the order they were read.
+    vector<pair<string, Json>> members;
+
+    /** @brief Reads a value starting at the given position.
+     *
+     * @param input Of const string type, by reference.
+     * @param position Of size_t type, by reference, moved past the value.
+     * @param depth Of int type, the number of arrays and objects the value is nested in.
+     * @return Json value.
+     */
+    static Json parseValue(const string &input, size_t &position, int depth);
+
+    /** @brief Reads a string starting at the given position, which must be a quote.
+     *
+     * @param input Of const string type, by reference.
+     * @param position Of size_t type, by reference, moved past the closing quote.
+     * @return string without the quotes and with the escapes resolved.
+     */
+    static string parseString(const string &input, size_t &position);
+
+public:
+
+    /** Create a new null value.
+     *
+     * Does nothing.
+     */
+    Json();
+
+    /** @brief Reads a whole value.
+     *
+     * Temporal Complexity: O(n), n being the length of the input.
+     *
+     * @param input Of const string type, by reference.
+     * @return Json value.
+     */
+    static Json parse(const string &input);
+
+    /** @brief Writes a string as a JSON string, quoted and escaped.
+     *
+     * @param value Of const string type, by reference.
+     * @return string.
+     */
+    static string quote(const string &value);
+
+    /** @brief Writes the value back as JSON, in a single line.
+     *
+     * @return string.
+     */
+    string dump() const;
+
+    //! @brief Returns the type of the value.
+    Type getType() const;
+
+    //! @brief Returns true if the value is an object with the given member.
+    bool has(const string &key) const;
+
+    /** @brief Returns a member of an object.
+     *
+     * @param key Of const string type, by reference.
+     * @return read-only reference to the member, or to a null value if there is no such member.
+     */
+    const Json &operator[](const string &key) const;
+
+    /** @brief Returns the items of an array.
+     *
+     * @return read-only reference to the vector<Json> of items.
+     */
+    const vector<Json> &getItems() const;
+
+    //! @brief Returns the value of a string.
+    const string &asString() const;
+
+    //! @brief Returns the value of a number.
+    double asNumber() const;
+
+    //! @brief Returns the value of a number that must be an integer.
+    int asInt() const;
+
+    //! @brief Returns the value of a boolean.
+    bool asBool() const;
+};
+
+#endif //AED_FEUP_PROJ_2_22_23_JSON_H
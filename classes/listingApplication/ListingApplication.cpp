@@ -7,15 +7,34 @@
 #include <string>
 #include "ListingApplication.h"
 #include "../Database/Database.h"
+#include "../Instrumentation/Instrumentation.h"
 
 ListingApplication::ListingApplication(DatabasePTR database) : database(database) {}
 
-bool operator<(const AirportPTR &airport1, const AirportPTR &airport2) {
-    return airport1->getFlights().size() < airport2->getFlights().size();
+void ListingApplication::setFormat(ResultWriter::Format format) {
+    this->format = format;
+}
+
+/** @brief Names what the airports are ranked by, to be printed after "Airports with more".
+ *
+ * @param ranking Of Statistics::Ranking type.
+ * @return string.
+ */
+static string rankingName(Statistics::Ranking ranking) {
+    switch (ranking) {
+        case Statistics::IN_DEGREE:
+            return "arriving flights";
+        case Statistics::DESTINATIONS:
+            return "destinations";
+        case Statistics::AIRLINES:
+            return "airlines";
+        default:
+            return "flights";
+    }
 }
 
 void ListingApplication::showTrajectories(LocalPTR origin, LocalPTR destination, bool hasFilter,
-                                          unordered_set<string> airlines) {
+                                          const unordered_set<string> &airlines) {
 
     list<pair<AirportPTR, list<Flight>>> trajectories;
     if (hasFilter)
@@ -23,91 +42,109 @@ void ListingApplication::showTrajectories(LocalPTR origin, LocalPTR destination,
     else
         trajectories = database->getTrajectories(origin, destination);
 
+    INSTRUMENT_SCOPE("render/trajectories");
+    ResultWriter writer(cout, format);
     if (trajectories.empty()) {
-        std::cout << "No trajectories were found for the given criteria!";
+        writer.text("No trajectories were found for the given criteria!");
         return;
     }
 
-    for (auto trajectory: trajectories) {
-        cout << trajectory.first->name << "," << trajectory.first->city;
-
-        for (Flight flight: trajectory.second) {
-            AirportPTR destination = database->getAirport(flight.destinationCode);
-            Airline airline = database->getAirline(flight.airlineCode);
-
-            cout << " -> " << destination->name << ',' << destination->city;
+    if (format != ResultWriter::TEXT) {
+        writer.table({{"trajectory", ""}, {"leg", ""}, {"origin", ""}, {"destination", ""}, {"airline", ""}});
+        int number = 1;
+        for (const auto &trajectory: trajectories) {
+            int leg = 1;
+            const string *previous = &trajectory.first->code;
+            for (const Flight &flight: trajectory.second) {
+                const string &code = database->getAirport(flight.destination)->code;
+                writer << to_string(number) << to_string(leg++) << *previous << code
+                       << database->getAirline(flight.airline).code;
+                previous = &code;
+            }
+            number++;
         }
-        cout << endl << "(";
-
-        for (auto it = trajectory.second.begin(); it != trajectory.second.end(); it++) {
-
-            Flight flight = *it;
-            AirportPTR destination = database->getAirport(flight.destinationCode);
-            Airline airline = database->getAirline(flight.airlineCode);
-
-            cout << airline.name;
+        return;
+    }
 
-            if (it != --trajectory.second.end())
-                cout << " , ";
+    // The same airports come up in many trajectories, so each label is put together once.
+    vector<string> labels(database->getAirports().size());
+    auto label = [this, &labels](int id) -> const string & {
+        string &text = labels[id];
+        if (text.empty()) {
+            AirportPTR airport = database->getAirport(id);
+            text = airport->getName() + ',' + airport->getCity();
         }
-        cout << ")" << endl << endl;
+        return text;
+    };
+
+    for (const auto &trajectory: trajectories) {
+        writer.text(label(trajectory.first->id));
+        for (const Flight &flight: trajectory.second)
+            writer.text(" -> ").text(label(flight.destination));
+        writer.text("\n(");
+
+        bool first = true;
+        for (const Flight &flight: trajectory.second) {
+            if (!first) writer.text(" , ");
+            writer.text(database->getAirline(flight.airline).name);
+            first = false;
+        }
+        writer.text(")\n\n");
     }
 }
 
 void ListingApplication::listFlights(std::string airportCode) {
     AirportPTR airport = database->getAirport(airportCode);
 
-    string title = "======= " + airport->name + "'s flights =======\n";
-    std::cout << title;
-    std::cout << "airline | Destination\n";
-
-    for (Flight flight: airport->getFlights()) {
-        AirportPTR destination = database->getAirport(flight.destinationCode);
-        string airportName = destination->name;
-        string city = destination->city;
-        string country = destination->country;
+    ResultWriter writer(cout, format);
+    writer.text("======= " + airport->getName() + "'s flights =======\n");
+    writer.text("airline | Destination\n");
+    writer.table({{"airline", ""}, {"airport", " | "}, {"city", ","}, {"country", ","}});
 
-        string airline = database->getAirline(flight.airlineCode).name;
-
-        std::cout << airline << " | " << airportName << ',' << city << ',' << country << std::endl;
+    for (const Flight &flight: airport->getFlights()) {
+        const AirportPTR &destination = database->getAirport(flight.destination);
+        writer << database->getAirline(flight.airline).name << destination->getName() << destination->getCity()
+               << destination->getCountry();
     }
 }
 
 void ListingApplication::listAirlines(std::string airportCode) {
     AirportPTR airport = database->getAirport(airportCode);
 
-    string title = "======= " + airport->name + "'s available airlines =======\n";
-    std::cout << title;
-    std::cout << "Name, Call Sign, Country \n\n";
+    ResultWriter writer(cout, format);
+    writer.text("======= " + airport->getName() + "'s available airlines =======\n");
+    writer.text("Name, Call Sign, Country \n\n");
+    writer.table({{"name", ""}, {"callSign", ", "}, {"country", ", "}});
 
-    unordered_set<string> airlines;
+    FlatSet<int> airlines;
 
-    for (Flight flight: airport->getFlights()) {
-        airlines.insert(flight.airlineCode);
+    for (const Flight &flight: airport->getFlights()) {
+        airlines.insert(flight.airline);
     }
 
-    for (string airlineCode: airlines) {
-        Airline airline = database->getAirline(airlineCode);
-        std::cout << airline.name << ", " << airline.callSign << ", " << airline.country << endl;
+    for (int airlineId: airlines) {
+        const Airline &airline = database->getAirline(airlineId);
+        writer << airline.name << airline.callSign << airline.country;
     }
 }
 
 void ListingApplication::listCities(std::string airportCode) {
     AirportPTR airport = database->getAirport(airportCode);
 
-    string title = "======= " + airport->name + "'s reachable countries =======\n";
-    std::cout << title;
-    std::cout << "Name | Country \n\n";
+    ResultWriter writer(cout, format);
+    writer.text("======= " + airport->getName() + "'s reachable countries =======\n");
+    writer.text("Name | Country \n\n");
+    writer.table({{"city", ""}, {"country", ", "}});
 
-    unordered_set<City, City::hashFunction> cities;
+    Cities_Set cities;
 
-    for (Flight flight: airport->getFlights()) {
-        AirportPTR airport = database->getAirport(flight.destinationCode);
-        cities.insert({airport->city, airport->country});
+    for (const Flight &flight: airport->getFlights()) {
+        const AirportPTR &airport = database->getAirport(flight.destination);
+        cities.insert(City(airport->city, airport->country));
     }
 
-    for (City city: cities) {
-        std::cout << city.name << ", " << city.country << endl;
+    for (const City &city: cities) {
+        writer << city.getName() << city.getCountry();
     }
 }
 
@@ -115,157 +152,120 @@ void ListingApplication::listCountries(std::string code) {
     AirportPTR airport = database->getAirport(code);
 
 
-    unordered_set<string> countries;
+    FlatSet<int> countries;
 
-    for (Flight flight: airport->getFlights()) {
-        AirportPTR airport = database->getAirport(flight.destinationCode);
+    for (const Flight &flight: airport->getFlights()) {
+        const AirportPTR &airport = database->getAirport(flight.destination);
         countries.insert(airport->country);
     }
 
+    ResultWriter writer(cout, format);
     if (countries.empty()) {
-        std::cout << "No countries were found for the given airport!" << endl;
+        writer.text("No countries were found for the given airport!\n");
         return;
     }
 
-    string title = "======= " + airport->name + "'s reachable countries =======\n";
-    std::cout << title;
-    std::cout << "Name \n\n";
+    writer.text("======= " + airport->getName() + "'s reachable countries =======\n");
+    writer.text("Name \n\n");
+    writer.table({{"country", ""}});
 
-    for (string country: countries) {
-        std::cout << country << endl;
+    for (int country: countries) {
+        writer << StringPool::global().get(country);
     }
 }
 
 void ListingApplication::listAirportsByCity(City city) {
 
-    auto airports = database->getAirportsPerCity()[city];
+    const AirportsPerCity_Set &airportsPerCity = database->getAirportsPerCity();
+    auto cityAirports = airportsPerCity.find(city);
 
-    if (airports.empty()) {
-        std::cout << "No airports were found for the given city!" << endl;
+    ResultWriter writer(cout, format);
+    if (cityAirports == airportsPerCity.end() || cityAirports->second.empty()) {
+        writer.text("No airports were found for the given city!\n");
         return;
     }
-    std::cout << "======= " << city.name << "'s existing Airports =======";
-    std::cout << endl;
-    std::cout << "airport Name |  airport city & country \n";
+    writer.text("======= " + city.getName() + "'s existing Airports =======\n");
+    writer.text("airport Name |  airport city & country \n");
+    writer.table({{"airport", ""}, {"city", " | "}, {"country", ", "}});
 
 
-    for (auto airport: airports) {
+    for (const AirportPTR &airport: cityAirports->second) {
 
-        std::cout << airport->name << " | " << airport->city << ", "
-                  << airport->country
-                  << endl;
+        writer << airport->getName() << airport->getCity() << airport->getCountry();
     }
 }
 
-void ListingApplication::globalStatistic(int k) {
-    int numAirports = database->getAirports().size();
-    std::cout << "Number of airports:" << numAirports << std::endl;
+void ListingApplication::globalStatistic(int k, Statistics::Ranking ranking) {
+    const Statistics &statistics = database->getStatistics();
+    ResultWriter writer(cout, format);
+    writer.text("Number of airports:" + to_string(statistics.getNumAirports()) + "\n");
+    writer.text("Number of flights: " + to_string(statistics.getNumFlights()) + "\n");
+    writer.text("Number of airlines: " + to_string(statistics.getNumAirlines()) + "\n");
 
-    int numFlights = 0;
-    for (auto pair: database->getAirports()) {
-        AirportPTR airport = pair.second;
-        numFlights += airport->getFlights().size();
-    }
-    std::cout << "Number of flights: " << numFlights << std::endl;
-
-    int numAirlines = 0;
-    numAirlines = database->getAirlines().size();
-    std::cout << "Number of airlines: " << numAirlines << std::endl;
-
-    std::cout << endl << "Calculating Diameter..." << std::endl << endl;
+    writer.text("\nCalculating Diameter...\n\n");
+    writer.flush();
 
     int diameter;
     diameter = database->diameter();
-    std::cout << "Diameter: " << diameter << std::endl;
+    writer.text("Diameter: " + to_string(diameter) + "\n");
 
-    priority_queue<AirportPTR> pq;
-    for (auto pair: database->getAirports()) {
-        AirportPTR airport = pair.second;
-        pq.push(airport);
-    }
-    std::cout << "Airports with more flights - top" << k << ": " << std::endl;
-    for (int i = 0; i < k; i++) {
-        std::cout << pq.top()->name << std::endl;
-        pq.pop();
+    writer.text("Airports with more " + rankingName(ranking) + " - top" + to_string(k) + ": \n");
+    writer.table({{"airport", ""}});
+    for (int id: statistics.getTop(ranking, k)) {
+        writer << database->getAirport(id)->getName();
     }
 }
 
-void ListingApplication::statisticPerCountry(std::string country, int k) {
-    int count = 0;
-    for (auto pair: database->getAirports()) {
-        AirportPTR airport = pair.second;
-        if (airport->country == country) {
-            count++;
-        }
-    }
+void ListingApplication::statisticPerCountry(std::string country, int k, Statistics::Ranking ranking) {
+    int countryId = StringPool::global().find(country);
+    const Statistics::CountryStatistics &statistics = database->getStatistics().getCountry(countryId);
 
-    if (!count) {
-        std::cout << "No airports were found for the given country!" << endl;
+    ResultWriter writer(cout, format);
+    if (!statistics.airports) {
+        writer.text("No airports were found for the given country!\n");
         return;
     }
 
-    std::cout << "Number of airports: " << count << endl;
+    writer.text("Number of airports: " + to_string(statistics.airports) + "\n");
+    writer.text("Number of flights: " + to_string(statistics.flights) + "\n");
+    writer.text("Number of airlines: " + to_string(statistics.airlines) + "\n");
 
-    int numFlights = 0;
-    for (auto pair: database->getAirports()) {
-        AirportPTR airport = pair.second;
-        if (airport->country == country) {
-            numFlights += airport->getFlights().size();
-        }
-    }
-    std::cout << "Number of flights: " << numFlights << endl;
-
-    unordered_set<string> airlinesCode;
-    for (auto pair: database->getAirports()) {
-        AirportPTR airport = pair.second;
-        if (airport->country == country)
-            for (auto flight: airport->getFlights()) {
-                auto airlinecode = flight.airlineCode;
-                airlinesCode.insert(airlinecode);
-            }
-    }
-    std::cout << "Number of airlines: " << airlinesCode.size() << endl;
-
-    priority_queue<AirportPTR> pq;
-    for (auto pair: database->getAirports()) {
-        AirportPTR airport = pair.second;
-        if (airport->country == country) {
-            pq.push(airport);
-        }
-    }
-    std::cout << "Airports with more flights in " << country << "- top" << k << ":" << endl;
-    for (int i = 0; i < k; i++) {
-        std::cout << pq.top()->name << endl;
-        pq.pop();
+    writer.text("Airports with more " + rankingName(ranking) + " in " + country + "- top" + to_string(k) + ":\n");
+    writer.table({{"airport", ""}});
+    for (int id: database->getStatistics().getTop(ranking, countryId, k)) {
+        writer << database->getAirport(id)->getName();
     }
 }
 
 void ListingApplication::showReachableAirports(LocalPTR local, int y) {
     auto maxYF = database->airportsWithMaxYFlights(local, y);
 
+    INSTRUMENT_SCOPE("render/reachableAirports");
+    ResultWriter writer(cout, format);
     if (maxYF.empty()) {
-        std::cout << "No reachable airports were found for the given criteria!";
+        writer.text("No reachable airports were found for the given criteria!");
         return;
     }
 
-    string title = "=========== Reachable Airports ==========\n\n";
-    for (AirportPTR airport: maxYF) {
-        cout << airport->name + "," + airport->city + "," + airport->country << endl;
+    writer.table({{"airport", ""}, {"city", ","}, {"country", ","}});
+    for (const AirportPTR &airport: maxYF) {
+        writer << airport->getName() << airport->getCity() << airport->getCountry();
     }
 }
 
 void ListingApplication::showReachableCities(LocalPTR local, int y) {
     auto maxCities = database->citiesWithMaxYFlights(local, y);
 
+    INSTRUMENT_SCOPE("render/reachableCities");
+    ResultWriter writer(cout, format);
     if (maxCities.empty()) {
-        std::cout << "No reachable cities were found for the given criteria!";
+        writer.text("No reachable cities were found for the given criteria!");
         return;
     }
 
-    string title = "=========== Reachable Cities ==========\n\n";
-
-    for (City city: maxCities) {
-        cout << city.name + "," + city.country << endl;
+    writer.table({{"city", ""}, {"country", ","}});
+    for (const City &city: maxCities) {
+        writer << city.getName() << city.getCountry();
     }
 }
 
@@ -273,26 +273,29 @@ void ListingApplication::showReachableCountries(LocalPTR local, int y) {
 
     auto maxCountries = database->countriesWithMaxYFlights(local, y);
 
+    INSTRUMENT_SCOPE("render/reachableCountries");
+    ResultWriter writer(cout, format);
     if (maxCountries.empty()) {
-        std::cout << "No reachable countries were found for the given criteria!";
+        writer.text("No reachable countries were found for the given criteria!");
         return;
     }
 
-    string title = "=========== Reachable Countries ==========\n\n";
-
-    for (string country: maxCountries) {
-        cout << country << endl;
+    writer.table({{"country", ""}});
+    for (int country: maxCountries) {
+        writer << StringPool::global().get(country);
     }
-    cout << endl;
+    writer.text("\n");
 }
 
 void ListingApplication::listArticulationPoints() {
 
     auto articulationPoints = database->getArticulationPoints();
-    cout << "Airports that serve as articulation points:\n\n";
-    for (AirportPTR airport: articulationPoints) {
-        cout << airport->name << "," << airport->city << "," << airport->country << endl;
+    INSTRUMENT_SCOPE("render/articulationPoints");
+    ResultWriter writer(cout, format);
+    writer.text("Airports that serve as articulation points:\n\n");
+    writer.table({{"airport", ""}, {"city", ","}, {"country", ","}});
+    for (const AirportPTR &airport: articulationPoints) {
+        writer << airport->getName() << airport->getCity() << airport->getCountry();
     }
-    cout << endl << "Total of " << articulationPoints.size() << " articulation points.";
+    writer.text("\nTotal of " + to_string(articulationPoints.size()) + " articulation points.");
 }
-
@@ -12,15 +12,21 @@
 #include <unordered_set>
 #include "../../Pointers.h"
 #include "../Graph/City/City.h"
+#include "../Database/Statistics/Statistics.h"
+#include "../ResultWriter/ResultWriter.h"
 
 /** @brief listingApplication class represents the most interest/important listings.
  *
+ *  The listings are written through a ResultWriter, as text by default.
  */
 class ListingApplication {
 
     //! @brief Holds the database.
     DatabasePTR database;
 
+    //! @brief Holds the format the listings are written in.
+    ResultWriter::Format format = ResultWriter::TEXT;
+
 public:
 
     /** Creates a new listingApplication with a database.
@@ -29,6 +35,13 @@ public:
      */
     ListingApplication(DatabasePTR database);
 
+    /** @brief Sets the format the listings are written in.
+     *
+     * @param format of ResultWriter::Format type.
+     * @return Void.
+     */
+    void setFormat(ResultWriter::Format format);
+
     /** @brief Lists the best trajectory from one local to another.
      *
      * @param origin of LocalPTR type.
@@ -36,7 +49,7 @@ public:
      * @return Void.
      */
     void showTrajectories(LocalPTR origin, LocalPTR destination, bool hasFilter,
-                          unordered_set <string> airlines);
+                          const unordered_set <string> &airlines);
 
     /** @brief Lists the flights of an airport.
      *
@@ -76,17 +89,19 @@ public:
     /** @brief Lists the global statistic.
      *
      * @param k of int type.
+     * @param ranking of Statistics::Ranking type, what the top airports are ranked by.
      * @return Void.
      */
-    void globalStatistic(int k);
+    void globalStatistic(int k, Statistics::Ranking ranking);
 
     /** @brief Lists the statistic per country.
      *
      * @param country of string type.
      * @param k of int type.
+     * @param ranking of Statistics::Ranking type, what the top airports are ranked by.
      * @return Void.
      */
-    void statisticPerCountry(std::string country, int k);
+    void statisticPerCountry(std::string country, int k, Statistics::Ranking ranking);
 
     /** @brief Lists the reachable airports from a Local.
      *
@@ -38,6 +38,12 @@ const string Menu::GLOBAL_STATISTICS = "Check global statistics";
 const string Menu::STATISTICS_BY_COUNTRY = "Check statistics per country";
 const string Menu::ARTICULATION_POINTS = "Check articulation points in the flight map";
 const string Menu::CONNECTED_COMPONENTS = "Check number of connected components in the flight map";
+const string Menu::TIMINGS = "Check timings and counters of the startup and the queries";
+
+const string Menu::RANK_BY_OUT_DEGREE = "Rank by departing flights";
+const string Menu::RANK_BY_IN_DEGREE = "Rank by arriving flights";
+const string Menu::RANK_BY_DESTINATIONS = "Rank by different destinations";
+const string Menu::RANK_BY_AIRLINES = "Rank by different airlines";
 
 const string Menu::ALL_AIRLINES = "Check all airlines trajectories";
 const string Menu::FILTER_AIRLINES = "Check trajectories for the filtered airlines";
@@ -173,7 +179,19 @@ void Menu::displayStatisticsMenu() {
     cout << "2 - " << STATISTICS_BY_COUNTRY << endl;
     cout << "3 - " << ARTICULATION_POINTS << endl;
     cout << "4 - " << CONNECTED_COMPONENTS << endl;
+    cout << "5 - " << TIMINGS << endl;
     cout << "9 - " << GO_BACK << endl;
     cout << "Insert option number > ";
 }
 
+void Menu::displayRankingMenu() {
+    cout << endl;
+    cout << "=============================================" << endl;
+    cout << "            Ranking options" << endl;
+    cout << "=============================================" << endl;
+    cout << "1 - " << RANK_BY_OUT_DEGREE << endl;
+    cout << "2 - " << RANK_BY_IN_DEGREE << endl;
+    cout << "3 - " << RANK_BY_DESTINATIONS << endl;
+    cout << "4 - " << RANK_BY_AIRLINES << endl;
+    cout << "Insert option number > ";
+}
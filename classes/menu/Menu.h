@@ -122,6 +122,21 @@ public:
     //! @brief Defines the string to output in the menu, as an option to showcase connected components.
     static const string CONNECTED_COMPONENTS;
 
+    //! @brief Defines the string to output in the menu, as an option to showcase the instrumentation timings and counters.
+    static const string TIMINGS;
+
+    //! @brief Defines the string to output in the menu, as an option to rank airports by departing flights.
+    static const string RANK_BY_OUT_DEGREE;
+
+    //! @brief Defines the string to output in the menu, as an option to rank airports by arriving flights.
+    static const string RANK_BY_IN_DEGREE;
+
+    //! @brief Defines the string to output in the menu, as an option to rank airports by distinct destinations.
+    static const string RANK_BY_DESTINATIONS;
+
+    //! @brief Defines the string to output in the menu, as an option to rank airports by distinct airlines.
+    static const string RANK_BY_AIRLINES;
+
     //! @brief Does nothing.
     Menu();
 
@@ -197,6 +212,12 @@ public:
      * @return Void.
      */
     void displayStatisticsMenu();
+
+    /** @brief Displays the menu with the ranking options for the top airports.
+     *
+     * @return Void.
+     */
+    void displayRankingMenu();
 };
 
 #endif //AED_FEUP_PROJ_2_22_23_MENU_H
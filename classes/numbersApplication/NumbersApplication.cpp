@@ -12,45 +12,22 @@ NumbersApplication::NumbersApplication(DatabasePTR database) : database(database
 
 int NumbersApplication::numbersFlights(std::string code) {
     AirportPTR airport = database->getAirport(code);
-    return airport->getnumFlights();
+    return database->getStatistics().getAirport(airport->id).flights;
 }
 
 int NumbersApplication::numbersAirlines(std::string code) {
     AirportPTR airport = database->getAirport(code);
-    unordered_set<string> airlines;
-    for (Flight flight: airport->getFlights()) {
-        airlines.insert(flight.airlineCode);
-    }
-    for (string airlineCode: airlines) {
-        for (Flight flight: airport->getFlights()) {
-            airlines.insert(flight.airlineCode);
-        }
-    }
-    return airlines.size();
+    return database->getStatistics().getAirport(airport->id).airlines;
 }
 
 int NumbersApplication::numbersCities(std::string code) {
     AirportPTR airport = database->getAirport(code);
-    unordered_set<City, City::hashFunction> cities;
-    for (Flight flight: airport->getFlights()) {
-        for (Flight flight: airport->getFlights()) {
-            AirportPTR airport = database->getAirport(flight.destinationCode);
-            cities.insert({airport->city, airport->country});
-        }
-    }
-    return cities.size();
+    return database->getStatistics().getAirport(airport->id).cities;
 }
 
 int NumbersApplication::numbersCountries(std::string code) {
     AirportPTR airport = database->getAirport(code);
-    unordered_set<string> countries;
-    for (Flight flight: airport->getFlights()) {
-        for (Flight flight: airport->getFlights()) {
-            AirportPTR airport = database->getAirport(flight.destinationCode);
-            countries.insert(airport->country);
-        }
-    }
-    return countries.size();
+    return database->getStatistics().getAirport(airport->id).countries;
 }
 
 void NumbersApplication::numberReachableAirports(LocalPTR local, int y) {
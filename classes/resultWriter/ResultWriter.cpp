@@ -0,0 +1,110 @@
+/** @file ResultWriter.cpp
+ *  @brief Contains the ResultWriter Class implementation.
+ *  @author -
+ *  @bug No known bugs.
+ */
+
+#include "ResultWriter.h"
+#include "../Json/Json.h"
+
+const size_t ResultWriter::CAPACITY;
+
+ResultWriter::ResultWriter(ostream &output, Format format) : output(output), format(format) {
+    buffer.reserve(CAPACITY + CAPACITY / 4);
+}
+
+ResultWriter::~ResultWriter() {
+    flush();
+}
+
+bool ResultWriter::parseFormat(const string &name, Format &format) {
+    if (name == "text") format = TEXT;
+    else if (name == "csv") format = CSV;
+    else if (name == "jsonl") format = JSON_LINES;
+    else return false;
+    return true;
+}
+
+ResultWriter::Format ResultWriter::getFormat() const {
+    return format;
+}
+
+void ResultWriter::writeCsv(const string &value) {
+    if (value.find_first_of(",\"\r\n") == string::npos) {
+        buffer += value;
+        return;
+    }
+
+    buffer += '"';
+    for (char c: value) {
+        if (c == '"') buffer += '"';
+        buffer += c;
+    }
+    buffer += '"';
+}
+
+void ResultWriter::spill() {
+    if (buffer.size() < CAPACITY) return;
+    output.write(buffer.data(), buffer.size());
+    buffer.clear();
+}
+
+ResultWriter &ResultWriter::text(const string &text) {
+    if (format == TEXT) {
+        buffer += text;
+        spill();
+    }
+    return *this;
+}
+
+void ResultWriter::table(const vector<Column> &columns) {
+    this->columns = columns;
+    column = 0;
+
+    if (format == CSV) {
+        if (tables) buffer += '\n';
+        for (size_t i = 0; i < columns.size(); i++) {
+            if (i) buffer += ',';
+            writeCsv(columns[i].name);
+        }
+        buffer += '\n';
+    }
+    tables++;
+}
+
+ResultWriter &ResultWriter::operator<<(const string &value) {
+    bool first = column == 0, last = column + 1 == columns.size();
+
+    switch (format) {
+        case TEXT:
+            buffer += columns[column].separator;
+            buffer += value;
+            break;
+        case CSV:
+            if (!first) buffer += ',';
+            writeCsv(value);
+            break;
+        case JSON_LINES:
+            buffer += first ? '{' : ',';
+            buffer += Json::quote(columns[column].name);
+            buffer += ':';
+            buffer += Json::quote(value);
+            if (last) buffer += '}';
+            break;
+    }
+
+    if (last) {
+        buffer += '\n';
+        column = 0;
+        spill();
+    } else {
+        column++;
+    }
+    return *this;
+}
+
+void ResultWriter::flush() {
+    output.write(buffer.data(), buffer.size());
+    output.flush();
+    buffer.clear();
+}
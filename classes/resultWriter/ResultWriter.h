@@ -0,0 +1,138 @@
+/** @file ResultWriter.h
+ *  @brief Contains the ResultWriter class declaration.
+ *  @author -
+ *  @bug No known bugs.
+ */
+
+#ifndef AED_FEUP_PROJ_2_22_23_RESULTWRITER_H
+#define AED_FEUP_PROJ_2_22_23_RESULTWRITER_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/** @brief ResultWriter class to write listings as text, CSV or JSON lines.
+ *
+ *  Everything is written into a buffer that goes to the output stream only when it is full
+ *  and when the writer is destroyed, so long listings cost a few large writes instead of one flush per line.
+ *  A listing is made of tables, each a list of named columns, and rows with one value per column.
+ *  Titles and messages are written only in the text format.
+ */
+class ResultWriter {
+
+public:
+
+    //! @brief Defines the formats a listing can be written in.
+    enum Format {
+        TEXT, CSV, JSON_LINES
+    };
+
+    //! @brief Represents a column of a table.
+    struct Column {
+        //! @brief Holds the name, the header in CSV and the key in JSON lines.
+        string name;
+
+        //! @brief Holds what is written before the value in the text format.
+        string separator;
+    };
+
+private:
+
+    //! @brief Holds the size the buffer is written out at.
+    static const size_t CAPACITY = 1 << 16;
+
+    //! @brief Holds the stream the buffer is written to.
+    ostream &output;
+
+    //! @brief Holds the format.
+    Format format;
+
+    //! @brief Holds what was not written to the stream yet.
+    string buffer;
+
+    //! @brief Holds the columns of the current table.
+    vector<Column> columns;
+
+    //! @brief Holds the column the next value belongs to.
+    size_t column = 0;
+
+    //! @brief Holds the number of tables started.
+    int tables = 0;
+
+    /** @brief Writes a CSV value, quoting it if needed.
+     *
+     * @param value Of const string type, by reference.
+     * @return Void.
+     */
+    void writeCsv(const string &value);
+
+    /** @brief Writes the buffer to the stream once it is full.
+     *
+     * @return Void.
+     */
+    void spill();
+
+public:
+
+    /** Creates a new ResultWriter.
+     *
+     * @param output of ostream type, by reference.
+     * @param format of Format type.
+     */
+    ResultWriter(ostream &output, Format format);
+
+    ResultWriter(const ResultWriter &) = delete;
+
+    ResultWriter &operator=(const ResultWriter &) = delete;
+
+    /** Writes and flushes whatever is left in the buffer.
+     */
+    ~ResultWriter();
+
+    /** @brief Reads the name of a format: "text", "csv" or "jsonl".
+     *
+     * @param name Of const string type, by reference.
+     * @param format Of Format type, by reference, set if the name is known.
+     * @return bool true if the name is known.
+     */
+    static bool parseFormat(const string &name, Format &format);
+
+    /** @brief Returns the format.
+     *
+     * @return Format.
+     */
+    Format getFormat() const;
+
+    /** @brief Writes a title or a message, in the text format only.
+     *
+     * @param text Of const string type, by reference.
+     * @return ResultWriter, by reference.
+     */
+    ResultWriter &text(const string &text);
+
+    /** @brief Starts a table.
+     *
+     * In CSV, writes the header, after an empty line if it is not the first table.
+     *
+     * @param columns Of const vector<Column> type, by reference.
+     * @return Void.
+     */
+    void table(const vector<Column> &columns);
+
+    /** @brief Writes the value of the next column of the current row, ending the row after the last column.
+     *
+     * @param value Of const string type, by reference.
+     * @return ResultWriter, by reference.
+     */
+    ResultWriter &operator<<(const string &value);
+
+    /** @brief Writes the buffer to the stream and flushes it.
+     *
+     * @return Void.
+     */
+    void flush();
+};
+
+#endif //AED_FEUP_PROJ_2_22_23_RESULTWRITER_H
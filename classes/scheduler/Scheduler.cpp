@@ -0,0 +1,192 @@
+/** @file Scheduler.cpp
+ *  @brief Contains the Scheduler Class implementation.
+ *  @author -
+ *  @bug No known bugs.
+ */
+
+#include "Scheduler.h"
+#include <algorithm>
+
+unsigned Scheduler::configuredThreads = 0;
+
+//! @brief Holds the scheduler the calling thread works for, if it is a worker.
+static thread_local const Scheduler *currentScheduler = nullptr;
+
+//! @brief Holds the deque of the calling thread, if it is a worker.
+static thread_local unsigned currentIndex = 0;
+
+Scheduler::TaskGroup::TaskGroup(Scheduler &scheduler) : scheduler(scheduler) {}
+
+Scheduler::TaskGroup::~TaskGroup() {
+    waitUntil([this]() { return pending == 0; });
+}
+
+void Scheduler::TaskGroup::run(function<void()> task) {
+    pending++;
+    scheduler.push({move(task), this});
+}
+
+void Scheduler::TaskGroup::wait() {
+    waitUntil([this]() { return pending == 0; });
+
+    exception_ptr thrown;
+    {
+        lock_guard<mutex> lock(errorMutex);
+        swap(thrown, error);
+    }
+    if (thrown) rethrow_exception(thrown);
+}
+
+void Scheduler::TaskGroup::waitUntil(const function<bool()> &done) {
+    while (!done()) {
+        Task task;
+        if (scheduler.pop(task)) {
+            scheduler.execute(task);
+            continue;
+        }
+
+        unique_lock<mutex> lock(scheduler.sleepMutex);
+        scheduler.waiting++;
+        scheduler.changed.wait(lock, [this, &done]() { return scheduler.queued > 0 || done(); });
+        scheduler.waiting--;
+    }
+}
+
+Scheduler::Scheduler(unsigned threads) {
+    threads = max(1u, threads);
+    for (unsigned i = 0; i < threads; i++)
+        queues.emplace_back(new Queue());
+    for (unsigned i = 0; i + 1 < threads; i++)
+        workers.emplace_back(&Scheduler::work, this, i);
+}
+
+Scheduler::~Scheduler() {
+    {
+        lock_guard<mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wakeUp.notify_all();
+    for (thread &worker: workers)
+        worker.join();
+}
+
+void Scheduler::setThreads(unsigned threads) {
+    configuredThreads = threads;
+}
+
+Scheduler &Scheduler::global() {
+    static Scheduler scheduler(configuredThreads ? configuredThreads : thread::hardware_concurrency());
+    return scheduler;
+}
+
+unsigned Scheduler::getThreads() const {
+    return queues.size();
+}
+
+unsigned Scheduler::currentQueue() const {
+    return currentScheduler == this ? currentIndex : queues.size() - 1;
+}
+
+void Scheduler::push(Task task) {
+    Queue &queue = *queues[currentQueue()];
+    {
+        lock_guard<mutex> lock(queue.lock);
+        queue.tasks.push_back(move(task));
+    }
+    queued++;
+
+    lock_guard<mutex> lock(sleepMutex);
+    wakeUp.notify_one();
+    if (waiting > 0) changed.notify_all();
+}
+
+bool Scheduler::pop(Task &task) {
+    unsigned own = currentQueue();
+    {
+        Queue &queue = *queues[own];
+        lock_guard<mutex> lock(queue.lock);
+        if (!queue.tasks.empty()) {
+            // Workers take their newest task, so nested tasks finish first; the shared deque keeps its order.
+            if (currentScheduler == this) {
+                task = move(queue.tasks.back());
+                queue.tasks.pop_back();
+            } else {
+                task = move(queue.tasks.front());
+                queue.tasks.pop_front();
+            }
+            queued--;
+            return true;
+        }
+    }
+
+    for (unsigned i = 1; i < queues.size(); i++) {
+        Queue &queue = *queues[(own + i) % queues.size()];
+        lock_guard<mutex> lock(queue.lock);
+        if (!queue.tasks.empty()) {
+            task = move(queue.tasks.front());
+            queue.tasks.pop_front();
+            queued--;
+            return true;
+        }
+    }
+    return false;
+}
+
+void Scheduler::execute(Task &task) {
+    try {
+        task.work();
+    } catch (...) {
+        lock_guard<mutex> lock(task.group->errorMutex);
+        if (!task.group->error) task.group->error = current_exception();
+    }
+    task.work = nullptr;
+    task.group->pending--;
+
+    if (waiting > 0) {
+        lock_guard<mutex> lock(sleepMutex);
+        changed.notify_all();
+    }
+}
+
+void Scheduler::work(unsigned index) {
+    currentScheduler = this;
+    currentIndex = index;
+
+    while (true) {
+        Task task;
+        if (pop(task)) {
+            execute(task);
+            continue;
+        }
+
+        unique_lock<mutex> lock(sleepMutex);
+        wakeUp.wait(lock, [this]() { return stopping || queued > 0; });
+        if (stopping) return;
+    }
+}
+
+void Scheduler::parallelFor(int begin, int end, int grain, const function<void(int, int)> &body) {
+    grain = max(1, grain);
+    if (end - begin <= grain) {
+        if (begin < end) body(begin, end);
+        return;
+    }
+
+    TaskGroup group(*this);
+    function<void(int, int)> split = [&split, &group, grain, &body](int first, int last) {
+        while (last - first > grain) {
+            int middle = first + (last - first) / 2;
+            group.run([&split, middle, last]() { split(middle, last); });
+            last = middle;
+        }
+        body(first, last);
+    };
+
+    try {
+        split(begin, end);
+    } catch (...) {
+        group.waitUntil([&group]() { return group.pending == 0; });
+        throw;
+    }
+    group.wait();
+}
@@ -0,0 +1,222 @@
+/** @file Scheduler.h
+ *  @brief Contains the Scheduler class declaration.
+ *  @author -
+ *  @bug No known bugs.
+ */
+
+#ifndef AED_FEUP_PROJ_2_22_23_SCHEDULER_H
+#define AED_FEUP_PROJ_2_22_23_SCHEDULER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+/** @brief Scheduler class to run tasks on a fixed pool of threads, shared by the whole program.
+ *
+ *  Every worker has its own deque of tasks: it takes the newest task of its own deque
+ *  and, when that is empty, steals the oldest task of another deque.
+ *  Threads outside the pool share one more deque.
+ *  A thread waiting for a TaskGroup runs tasks in the meantime, so tasks can start and wait for tasks of their own.
+ */
+class Scheduler {
+
+public:
+
+    /** @brief TaskGroup class to run tasks on a scheduler and wait for all of them.
+     *
+     *  The first exception thrown by a task is thrown again by wait.
+     */
+    class TaskGroup {
+
+        friend class Scheduler;
+
+    private:
+
+        //! @brief Holds the scheduler the tasks run on.
+        Scheduler &scheduler;
+
+        //! @brief Holds the number of tasks that did not finish yet.
+        atomic<int> pending{0};
+
+        //! @brief Protects error.
+        mutex errorMutex;
+
+        //! @brief Holds the first exception thrown by a task.
+        exception_ptr error;
+
+    public:
+
+        /** Creates a new, empty TaskGroup.
+         *
+         * @param scheduler of Scheduler type, by reference.
+         */
+        explicit TaskGroup(Scheduler &scheduler = Scheduler::global());
+
+        TaskGroup(const TaskGroup &) = delete;
+
+        TaskGroup &operator=(const TaskGroup &) = delete;
+
+        /** Waits for the tasks that are still running, ignoring their exceptions.
+         */
+        ~TaskGroup();
+
+        /** @brief Adds a task.
+         *
+         * @param task Of function<void()> type.
+         * @return Void.
+         */
+        void run(function<void()> task);
+
+        /** @brief Runs tasks until every task of the group finished.
+         *
+         * @return Void.
+         */
+        void wait();
+
+        /** @brief Runs tasks until a condition holds.
+         *
+         * The condition is checked again each time a task finishes.
+         *
+         * @param done Of const function<bool()> type, by reference.
+         * @return Void.
+         */
+        void waitUntil(const function<bool()> &done);
+    };
+
+private:
+
+    //! @brief Represents a task waiting to run.
+    struct Task {
+        function<void()> work;
+        TaskGroup *group;
+    };
+
+    //! @brief Represents the deque of a worker.
+    struct Queue {
+        mutex lock;
+        deque<Task> tasks;
+    };
+
+    //! @brief Holds the number of threads asked for in the command line, 0 for one per hardware thread.
+    static unsigned configuredThreads;
+
+    //! @brief Holds the deques, one per worker and the last one for the threads outside the pool.
+    vector<unique_ptr<Queue>> queues;
+
+    //! @brief Holds the workers.
+    vector<thread> workers;
+
+    //! @brief Holds the number of tasks in the deques.
+    atomic<int> queued{0};
+
+    //! @brief Holds the number of threads waiting for a TaskGroup.
+    atomic<int> waiting{0};
+
+    //! @brief Protects the sleeping threads.
+    mutex sleepMutex;
+
+    //! @brief Wakes the workers when there are tasks.
+    condition_variable wakeUp;
+
+    //! @brief Wakes the threads waiting for a TaskGroup when there are tasks or a task finished.
+    condition_variable changed;
+
+    //! @brief Holds true once the workers should stop.
+    bool stopping = false;
+
+    /** @brief Returns the deque of the calling thread.
+     *
+     * @return unsigned index of the deque.
+     */
+    unsigned currentQueue() const;
+
+    /** @brief Adds a task to the deque of the calling thread.
+     *
+     * @param task Of Task type.
+     * @return Void.
+     */
+    void push(Task task);
+
+    /** @brief Takes a task, from the deque of the calling thread first and then from the others.
+     *
+     * @param task Of Task type, by reference, set to the task taken.
+     * @return bool true if a task was taken.
+     */
+    bool pop(Task &task);
+
+    /** @brief Runs a task and tells its group.
+     *
+     * @param task Of Task type, by reference.
+     * @return Void.
+     */
+    void execute(Task &task);
+
+    /** @brief Runs tasks until the scheduler stops.
+     *
+     * @param index Of unsigned type, the deque of the worker.
+     * @return Void.
+     */
+    void work(unsigned index);
+
+public:
+
+    /** Creates a new Scheduler and starts its workers.
+     *
+     * The calling threads take part in the work while they wait, so threads - 1 workers are started.
+     *
+     * @param threads of unsigned type, the number of threads running tasks, at least 1.
+     */
+    explicit Scheduler(unsigned threads);
+
+    Scheduler(const Scheduler &) = delete;
+
+    Scheduler &operator=(const Scheduler &) = delete;
+
+    /** Stops the workers.
+     */
+    ~Scheduler();
+
+    /** @brief Sets the number of threads of the global scheduler.
+     *
+     * Has no effect once the global scheduler was used.
+     *
+     * @param threads Of unsigned type, 0 for one per hardware thread.
+     * @return Void.
+     */
+    static void setThreads(unsigned threads);
+
+    /** @brief Returns the scheduler shared by the whole program, starting it on the first call.
+     *
+     * @return Scheduler, by reference.
+     */
+    static Scheduler &global();
+
+    /** @brief Returns the number of threads running tasks, the calling thread included.
+     *
+     * @return unsigned.
+     */
+    unsigned getThreads() const;
+
+    /** @brief Runs a body over a range of indexes, split in chunks that run in parallel.
+     *
+     * The range is halved until the chunks have at most grain indexes;
+     * a range of one chunk runs on the calling thread alone.
+     *
+     * @param begin Of int type.
+     * @param end Of int type, one past the last index.
+     * @param grain Of int type, the largest chunk.
+     * @param body Of const function<void(int, int)> type, by reference, called with the first and one past the last index of a chunk.
+     * @return Void.
+     */
+    void parallelFor(int begin, int end, int grain, const function<void(int, int)> &body);
+};
+
+#endif //AED_FEUP_PROJ_2_22_23_SCHEDULER_H
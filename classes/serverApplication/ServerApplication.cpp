@@ -0,0 +1,446 @@
+/** @file ServerApplication.cpp
+ *  @brief Contains the ServerApplication Class implementation.
+ *  @author -
+ *  @bug No known bugs.
+ */
+
+#include "ServerApplication.h"
+#include <algorithm>
+#include <iostream>
+
+#ifdef __linux__
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <thread>
+#include <unordered_map>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#endif
+
+const size_t ServerApplication::MAX_LATENCIES;
+const size_t ServerApplication::MAX_REQUEST;
+
+ServerApplication::ServerApplication(DatabasePTR database, unsigned threads, int deadline) :
+        batchApplication(database), threads(threads), deadline(deadline) {}
+
+void ServerApplication::record(long long latency, bool failed, bool timedOut) {
+    lock_guard<mutex> lock(statsMutex);
+    if (latencies.size() < MAX_LATENCIES) latencies.push_back(latency);
+    else latencies[requests % MAX_LATENCIES] = latency;
+
+    requests++;
+    errors += failed;
+    timeouts += timedOut;
+}
+
+string ServerApplication::stats(size_t queued, size_t connections) const {
+    vector<long long> sorted;
+    long long answered, failed, late;
+    {
+        lock_guard<mutex> lock(statsMutex);
+        sorted = latencies;
+        answered = requests;
+        failed = errors;
+        late = timeouts;
+    }
+
+    auto percentile = [&sorted](double fraction) -> long long {
+        if (sorted.empty()) return 0;
+        size_t index = min(sorted.size() - 1, (size_t) (fraction * sorted.size()));
+        nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+        return sorted[index];
+    };
+    long long p50 = percentile(0.50);
+    long long p99 = percentile(0.99);
+
+    return "{\"requests\":" + to_string(answered) + ",\"errors\":" + to_string(failed) +
+           ",\"timeouts\":" + to_string(late) + ",\"queued\":" + to_string(queued) +
+           ",\"connections\":" + to_string(connections) + ",\"p50_us\":" + to_string(p50) +
+           ",\"p99_us\":" + to_string(p99) + "}";
+}
+
+#ifdef __linux__
+
+//! @brief Represents a request waiting for a worker.
+struct Request {
+    uint64_t connection;
+    uint64_t sequence;
+    string line;
+    string id;
+    chrono::steady_clock::time_point received;
+    chrono::steady_clock::time_point deadline;
+};
+
+//! @brief Represents a response waiting to be sent.
+struct Response {
+    uint64_t connection;
+    uint64_t sequence;
+    string text;
+};
+
+//! @brief Represents a client connection.
+struct ClientConnection {
+    int descriptor;
+
+    //! @brief Holds the bytes received that do not make a whole line yet.
+    string input;
+
+    //! @brief Holds the bytes to send.
+    string output;
+
+    //! @brief Holds the sequence number of the last request received.
+    uint64_t lastRequest = 0;
+
+    //! @brief Holds the sequence number of the next response to send.
+    uint64_t nextResponse = 1;
+
+    //! @brief Holds the responses that are ready but wait for an earlier one.
+    map<uint64_t, string> ready;
+
+    //! @brief Holds true if the client will not send anything else.
+    bool finished = false;
+
+    //! @brief Holds the events epoll is waiting for on the socket.
+    uint32_t events = EPOLLIN | EPOLLRDHUP;
+};
+
+//! @brief Defines the epoll keys of the descriptors that are not connections.
+enum {
+    LISTENER_KEY, WAKE_KEY, SIGNAL_KEY, FIRST_CONNECTION_KEY
+};
+
+/** @brief Writes an error response.
+ *
+ * @param sequence Of uint64_t type.
+ * @param id Of const string type, by reference, the id of the request as JSON, or empty.
+ * @param error Of const string type, by reference.
+ * @return string.
+ */
+static string errorResponse(uint64_t sequence, const string &id, const string &error) {
+    return "{\"line\":" + to_string(sequence) + (id.empty() ? "" : ",\"id\":" + id) +
+           ",\"error\":" + Json::quote(error) + "}";
+}
+
+/** @brief Returns the signals that shut the server down.
+ *
+ * @return sigset_t with SIGINT and SIGTERM.
+ */
+static sigset_t shutdownSignals() {
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    return signals;
+}
+
+void ServerApplication::blockSignals() {
+    sigset_t signals = shutdownSignals();
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+}
+
+int ServerApplication::run(const string &path) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) {
+        cerr << "Socket path too long: " << path << endl;
+        return 1;
+    }
+    strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+
+    // The caller blocked the signals before starting any thread; this only covers one that did not.
+    blockSignals();
+    sigset_t signals = shutdownSignals();
+    signal(SIGPIPE, SIG_IGN);
+
+    int listener = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    unlink(path.c_str());
+    if (listener < 0 || ::bind(listener, (sockaddr *) &address, sizeof(address)) != 0 || listen(listener, SOMAXCONN) != 0) {
+        cerr << "Could not listen on " << path << ": " << strerror(errno) << endl;
+        if (listener >= 0) close(listener);
+        return 1;
+    }
+
+    int wake = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    int signalDescriptor = signalfd(-1, &signals, SFD_NONBLOCK | SFD_CLOEXEC);
+    int poller = epoll_create1(EPOLL_CLOEXEC);
+
+    auto watch = [poller](int descriptor, uint64_t key, uint32_t events, int operation) {
+        epoll_event event{};
+        event.events = events;
+        event.data.u64 = key;
+        epoll_ctl(poller, operation, descriptor, &event);
+    };
+    watch(listener, LISTENER_KEY, EPOLLIN, EPOLL_CTL_ADD);
+    watch(wake, WAKE_KEY, EPOLLIN, EPOLL_CTL_ADD);
+    watch(signalDescriptor, SIGNAL_KEY, EPOLLIN, EPOLL_CTL_ADD);
+
+    mutex requestsMutex;
+    condition_variable requestReady;
+    deque<Request> pending;
+    bool stopping = false;
+
+    mutex responsesMutex;
+    vector<Response> answered;
+
+    auto work = [&]() {
+        while (true) {
+            Request request;
+            {
+                unique_lock<mutex> lock(requestsMutex);
+                requestReady.wait(lock, [&]() { return stopping || !pending.empty(); });
+                if (stopping) return;
+                request = move(pending.front());
+                pending.pop_front();
+            }
+
+            bool failed = true, timedOut = chrono::steady_clock::now() > request.deadline;
+            string text;
+            if (!timedOut) {
+                text = batchApplication.answer(request.line, request.sequence, failed, Deadline(request.deadline));
+                timedOut = chrono::steady_clock::now() > request.deadline;
+            }
+            if (timedOut) {
+                failed = true;
+                text = errorResponse(request.sequence, request.id, "deadline exceeded");
+            }
+
+            auto latency = chrono::steady_clock::now() - request.received;
+            record(chrono::duration_cast<chrono::microseconds>(latency).count(), failed, timedOut);
+
+            {
+                lock_guard<mutex> lock(responsesMutex);
+                answered.push_back({request.connection, request.sequence, move(text)});
+            }
+            uint64_t one = 1;
+            if (write(wake, &one, sizeof(one)) < 0) {}
+        }
+    };
+
+    unsigned workers = threads ? threads : max(1u, thread::hardware_concurrency());
+    vector<thread> pool;
+    for (unsigned i = 0; i < workers; i++)
+        pool.emplace_back(work);
+
+    unordered_map<uint64_t, ClientConnection> connections;
+    uint64_t nextKey = FIRST_CONNECTION_KEY;
+
+    auto closeConnection = [&](uint64_t key) {
+        auto found = connections.find(key);
+        if (found == connections.end()) return;
+        epoll_ctl(poller, EPOLL_CTL_DEL, found->second.descriptor, nullptr);
+        close(found->second.descriptor);
+        connections.erase(found);
+    };
+
+    // Sends what can be sent without blocking, and closes the connection once it has nothing left to do.
+    auto flush = [&](uint64_t key) {
+        ClientConnection &connection = connections.at(key);
+        while (!connection.output.empty()) {
+            ssize_t sent = send(connection.descriptor, connection.output.data(), connection.output.size(), MSG_NOSIGNAL);
+            if (sent > 0) {
+                connection.output.erase(0, sent);
+            } else if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                break;
+            } else if (sent < 0 && errno == EINTR) {
+                continue;
+            } else {
+                closeConnection(key);
+                return;
+            }
+        }
+
+        if (connection.finished && connection.output.empty() && connection.nextResponse > connection.lastRequest) {
+            closeConnection(key);
+            return;
+        }
+
+        uint32_t events = (connection.finished ? 0u : (uint32_t) (EPOLLIN | EPOLLRDHUP)) |
+                          (connection.output.empty() ? 0u : (uint32_t) EPOLLOUT);
+        if (events != connection.events) {
+            connection.events = events;
+            watch(connection.descriptor, key, events, EPOLL_CTL_MOD);
+        }
+    };
+
+    auto deliver = [&](uint64_t key, uint64_t sequence, string text) {
+        auto found = connections.find(key);
+        if (found == connections.end()) return;
+
+        ClientConnection &connection = found->second;
+        connection.ready[sequence] = move(text);
+        for (auto next = connection.ready.begin();
+             next != connection.ready.end() && next->first == connection.nextResponse;
+             next = connection.ready.erase(next), connection.nextResponse++) {
+            connection.output += next->second;
+            connection.output += '\n';
+        }
+    };
+
+    auto receive = [&](uint64_t key, const string &line) {
+        ClientConnection &connection = connections.at(key);
+        uint64_t sequence = ++connection.lastRequest;
+        auto now = chrono::steady_clock::now();
+
+        Json query;
+        try {
+            query = Json::parse(line);
+        } catch (const invalid_argument &) {
+            bool failed;
+            deliver(key, sequence, batchApplication.answer(line, sequence, failed));
+            record(0, true, false);
+            return;
+        }
+
+        string id = query["id"].getType() != Json::NUL ? query["id"].dump() : "";
+        if (query["type"].getType() == Json::STRING && query["type"].asString() == "stats") {
+            size_t queued;
+            {
+                lock_guard<mutex> lock(requestsMutex);
+                queued = pending.size();
+            }
+            deliver(key, sequence, "{\"line\":" + to_string(sequence) + (id.empty() ? "" : ",\"id\":" + id) +
+                                   ",\"type\":\"stats\",\"result\":" + stats(queued, connections.size()) + "}");
+            return;
+        }
+
+        int milliseconds = deadline;
+        if (query["deadline_ms"].getType() == Json::NUMBER)
+            milliseconds = max(0, (int) query["deadline_ms"].asNumber());
+
+        {
+            lock_guard<mutex> lock(requestsMutex);
+            pending.push_back({key, sequence, line, id, now, now + chrono::milliseconds(milliseconds)});
+        }
+        requestReady.notify_one();
+    };
+
+    auto read = [&](uint64_t key) {
+        ClientConnection &connection = connections.at(key);
+        char buffer[1 << 16];
+        while (true) {
+            ssize_t received = recv(connection.descriptor, buffer, sizeof(buffer), 0);
+            if (received > 0) {
+                connection.input.append(buffer, received);
+            } else if (received == 0) {
+                connection.finished = true;
+                break;
+            } else if (errno == EINTR) {
+                continue;
+            } else {
+                if (errno != EAGAIN && errno != EWOULDBLOCK) connection.finished = true;
+                break;
+            }
+        }
+
+        auto receiveLine = [&](string line) {
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            if (line.find_first_not_of(" \t") != string::npos) receive(key, line);
+        };
+
+        size_t start = 0, end;
+        while ((end = connection.input.find('\n', start)) != string::npos) {
+            receiveLine(connection.input.substr(start, end - start));
+            start = end + 1;
+        }
+        connection.input.erase(0, start);
+
+        if (connection.input.size() > MAX_REQUEST) {
+            uint64_t sequence = ++connection.lastRequest;
+            deliver(key, sequence, errorResponse(sequence, "", "request too long"));
+            connection.input.clear();
+            connection.finished = true;
+        } else if (connection.finished && !connection.input.empty()) {
+            // The peer closed its side after a last request without a newline.
+            string line;
+            line.swap(connection.input);
+            receiveLine(line);
+        }
+        flush(key);
+    };
+
+    cerr << "Listening on " << path << endl;
+
+    epoll_event events[64];
+    bool running = true;
+    while (running) {
+        int count = epoll_wait(poller, events, 64, -1);
+        if (count < 0 && errno == EINTR) continue;
+        if (count < 0) break;
+
+        for (int i = 0; i < count; i++) {
+            uint64_t key = events[i].data.u64;
+
+            if (key == SIGNAL_KEY) {
+                running = false;
+            } else if (key == LISTENER_KEY) {
+                int client;
+                while ((client = accept4(listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0) {
+                    ClientConnection &connection = connections[nextKey];
+                    connection.descriptor = client;
+                    watch(client, nextKey++, EPOLLIN | EPOLLRDHUP, EPOLL_CTL_ADD);
+                }
+            } else if (key == WAKE_KEY) {
+                uint64_t value;
+                if (::read(wake, &value, sizeof(value)) < 0) {}
+
+                vector<Response> responses;
+                {
+                    lock_guard<mutex> lock(responsesMutex);
+                    responses.swap(answered);
+                }
+                vector<uint64_t> touched;
+                for (Response &response: responses) {
+                    deliver(response.connection, response.sequence, move(response.text));
+                    touched.push_back(response.connection);
+                }
+                sort(touched.begin(), touched.end());
+                touched.erase(unique(touched.begin(), touched.end()), touched.end());
+                for (uint64_t connection: touched)
+                    if (connections.count(connection)) flush(connection);
+            } else if (connections.count(key)) {
+                // A client that hung up completely gets no more responses.
+                if (events[i].events & (EPOLLHUP | EPOLLERR)) closeConnection(key);
+                else if (events[i].events & (EPOLLIN | EPOLLRDHUP)) read(key);
+                else if (events[i].events & EPOLLOUT) flush(key);
+            }
+        }
+    }
+
+    {
+        lock_guard<mutex> lock(requestsMutex);
+        stopping = true;
+    }
+    requestReady.notify_all();
+    for (thread &worker: pool)
+        worker.join();
+
+    while (!connections.empty())
+        closeConnection(connections.begin()->first);
+    close(poller);
+    close(signalDescriptor);
+    close(wake);
+    close(listener);
+    unlink(path.c_str());
+    return 0;
+}
+
+#else
+
+void ServerApplication::blockSignals() {}
+
+int ServerApplication::run(const string &path) {
+    cerr << "The server mode is only available on Linux" << endl;
+    return 1;
+}
+
+#endif
@@ -0,0 +1,110 @@
+/** @file ServerApplication.h
+ *  @brief Contains the ServerApplication class declaration.
+ *  @author -
+ *  @bug No known bugs.
+ */
+
+#ifndef AED_FEUP_PROJ_2_22_23_SERVERAPPLICATION_H
+#define AED_FEUP_PROJ_2_22_23_SERVERAPPLICATION_H
+
+#include <mutex>
+#include <string>
+#include <vector>
+#include "../../Pointers.h"
+#include "../BatchApplication/BatchApplication.h"
+
+/** @brief ServerApplication class to answer queries over a Unix domain socket.
+ *
+ *  Loads nothing by itself: it serves a database that was already read, so the cost of reading
+ *  is paid once for every client. The protocol is the one of the batch mode: each request is one JSON
+ *  query per line, and each response is one JSON line, sent back in the order the requests came in.
+ *  A request may set "deadline_ms"; a request that is not answered by then gets a "deadline exceeded" error.
+ *  A request still queued at its deadline is not started, and the searches that can take long, the analytics,
+ *  the profiles and the Pareto journeys, give up once it passes, so the requests behind them do not wait.
+ *  Other queries run to the end, and only their reply is replaced.
+ *  The query {"type": "stats"} is answered right away with the request counts and the p50 and p99 latencies.
+ *
+ *  One thread accepts connections and moves bytes, driven by epoll, while a pool of workers answers the queries.
+ *  Only available on Linux.
+ */
+class ServerApplication {
+
+private:
+
+    //! @brief Defines the number of latencies kept for the percentiles, the most recent ones.
+    static const size_t MAX_LATENCIES = 1 << 16;
+
+    //! @brief Defines the longest request accepted, in bytes.
+    static const size_t MAX_REQUEST = 1 << 20;
+
+    //! @brief Holds the answering of the queries.
+    BatchApplication batchApplication;
+
+    //! @brief Holds the number of workers, 0 for one per hardware thread.
+    unsigned threads;
+
+    //! @brief Holds the default deadline of a request, in milliseconds.
+    int deadline;
+
+    //! @brief Protects the counters and the latencies.
+    mutable mutex statsMutex;
+
+    //! @brief Holds the latencies of the answered requests in microseconds, as a ring.
+    vector<long long> latencies;
+
+    //! @brief Holds the number of answered requests.
+    long long requests = 0;
+
+    //! @brief Holds the number of requests answered with an error.
+    long long errors = 0;
+
+    //! @brief Holds the number of requests that missed their deadline.
+    long long timeouts = 0;
+
+    /** @brief Records an answered request.
+     *
+     * @param latency Of long long type, in microseconds, from receiving the request to answering it.
+     * @param failed Of bool type.
+     * @param timedOut Of bool type.
+     * @return Void.
+     */
+    void record(long long latency, bool failed, bool timedOut);
+
+    /** @brief Writes the counters and the latency percentiles.
+     *
+     * @param queued Of size_t type, the number of requests waiting for a worker.
+     * @param connections Of size_t type, the number of open connections.
+     * @return string with the JSON result.
+     */
+    string stats(size_t queued, size_t connections) const;
+
+public:
+
+    /** Creates a new ServerApplication with a database.
+     *
+     * @param database of DatabasePTR type, already read.
+     * @param threads of unsigned type, 0 to use one per hardware thread.
+     * @param deadline of int type, the default deadline of a request in milliseconds.
+     */
+    ServerApplication(DatabasePTR database, unsigned threads, int deadline);
+
+    /** @brief Blocks SIGINT and SIGTERM in the calling thread, and so in every thread it starts from then on.
+     *
+     * Must be called before any other thread starts, the workers of the scheduler included,
+     * so that the signals only ever reach run through its signalfd.
+     *
+     * @return Void.
+     */
+    static void blockSignals();
+
+    /** @brief Serves requests until the process receives SIGINT or SIGTERM.
+     *
+     * Any file at the socket path is replaced, and removed again on exit.
+     *
+     * @param path Of const string type, by reference, path of the socket.
+     * @return int exit code, 1 if the socket could not be set up.
+     */
+    int run(const string &path);
+};
+
+#endif //AED_FEUP_PROJ_2_22_23_SERVERAPPLICATION_H
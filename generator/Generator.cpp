@@ -0,0 +1,327 @@
+/** @file Generator.cpp
+ *  @brief Contains the generator of synthetic flight networks.
+ *  @author -
+ *  @bug No known bugs.
+ *
+ *  Writes airports.csv, airlines.csv and flights.csv, in the format the Database reads, into a directory.
+ *  The same options and seed always give the same files: the generator uses its own random numbers and
+ *  distributions, whose results do not depend on the standard library.
+ *
+ *  The network has the structure of the real one:
+ *  - the airports are grouped in clusters, each a country, with coordinates spread around its centre;
+ *  - the airports are ranked, and the chance an airport is on a route falls with a power of its rank,
+ *    which gives a few hubs with most of the flights;
+ *  - a share of the routes stay inside the cluster of their origin;
+ *  - a share of the routes are flown by the airlines of the country of their origin, the first ones most often.
+ *  Every route is flown both ways.
+ *
+ *  With --schedules, a schedules.csv is written too, giving each flight that many departures a day on average,
+ *  at random times, with a duration that grows with the distance between its airports.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../classes/graph/code/Code.h"
+
+using namespace std;
+
+//! @brief Represents the options of the generator.
+struct Options {
+    string output;
+    int airports = 10000;
+    int airlines = 500;
+    long long flights = 1000000;
+    unsigned long long seed = 42;
+    double hubExponent = 1.1;
+    int clusters = 60;
+    double spread = 4.0;
+    double locality = 0.6;
+    double concentration = 0.8;
+    int schedules = 0;
+};
+
+//! @brief Represents a SplitMix64 random number generator.
+struct Random {
+    uint64_t state;
+
+    uint64_t next() {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    //! @brief Returns a number in [0, 1).
+    double uniform() {
+        return (next() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    //! @brief Returns an integer in [0, n).
+    int below(int n) {
+        return (int) (((next() >> 32) * (uint64_t) n) >> 32);
+    }
+
+    //! @brief Returns a normally distributed number, with the Box-Muller transform.
+    double normal() {
+        double u = 1 - uniform(), v = uniform();
+        return sqrt(-2 * log(u)) * cos(2 * M_PI * v);
+    }
+};
+
+//! @brief Represents a choice of items with given weights.
+struct WeightedChoice {
+    vector<int> items;
+    vector<double> cumulative;
+
+    void add(int item, double weight) {
+        items.push_back(item);
+        cumulative.push_back((cumulative.empty() ? 0 : cumulative.back()) + weight);
+    }
+
+    bool empty() const {
+        return items.empty();
+    }
+
+    int pick(Random &random) const {
+        double target = random.uniform() * cumulative.back();
+        size_t index = upper_bound(cumulative.begin(), cumulative.end(), target) - cumulative.begin();
+        return items[min(index, items.size() - 1)];
+    }
+};
+
+/** @brief Writes the code of an airport or airline from its id, "AAA" being 0.
+ *
+ * @param id Of int type, less than NUM_CODES.
+ * @return string.
+ */
+static string codeOf(int id) {
+    const char *symbols = "ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+    string code(CODE_LENGTH, 'A');
+    for (int i = CODE_LENGTH - 1; i >= 0; i--, id /= CODE_SYMBOLS)
+        code[i] = symbols[id % CODE_SYMBOLS];
+    return code;
+}
+
+/** @brief Writes a buffer to a file once it is large, or always if asked to.
+ *
+ * @param file Of ofstream type, by reference.
+ * @param buffer Of string type, by reference.
+ * @param force Of bool type.
+ * @return Void.
+ */
+static void spill(ofstream &file, string &buffer, bool force) {
+    if (!force && buffer.size() < (1 << 20)) return;
+    file.write(buffer.data(), buffer.size());
+    buffer.clear();
+}
+
+/** @brief Writes the scheduled departures of a flight as lines of the schedules file.
+ *
+ * A flight of a day or more is left unscheduled, since its times of day could not tell how many days it takes.
+ *
+ * @param buffer Of string type, by reference.
+ * @param random Of Random type, by reference.
+ * @param line Of const string type, by reference, the line of the flight in the flights file.
+ * @param minutes Of int type, the duration of the flight.
+ * @param departures Of int type, the average number of departures a day.
+ * @return Void.
+ */
+static void writeDepartures(string &buffer, Random &random, const string &line, int minutes, int departures) {
+    if (minutes >= 24 * 60) return;
+    for (int count = 1 + random.below(2 * departures - 1); count > 0; count--) {
+        int departure = 5 * random.below(24 * 12), arrival = (departure + minutes) % (24 * 60);
+        char times[32];
+        snprintf(times, sizeof(times), ",%02d:%02d,%02d:%02d\n", departure / 60, departure % 60, arrival / 60,
+                 arrival % 60);
+        buffer += line;
+        buffer += times;
+    }
+}
+
+/** @brief Generates the files.
+ *
+ * @param options Of const Options type, by reference.
+ * @return int exit code, 1 if a file could not be written.
+ */
+static int generate(const Options &options) {
+    Random random{options.seed};
+    int numClusters = max(1, options.clusters);
+
+    vector<double> centreLatitude(numClusters), centreLongitude(numClusters);
+    for (int cluster = 0; cluster < numClusters; cluster++) {
+        centreLatitude[cluster] = -50 + 115 * random.uniform();
+        centreLongitude[cluster] = -180 + 360 * random.uniform();
+    }
+
+    vector<int> clusterOf(options.airports), rank(options.airports);
+    vector<int> clusterSize(numClusters, 0);
+    for (int airport = 0; airport < options.airports; airport++) {
+        clusterOf[airport] = random.below(numClusters);
+        clusterSize[clusterOf[airport]]++;
+        rank[airport] = airport;
+    }
+    for (int i = options.airports - 1; i > 0; i--)
+        swap(rank[i], rank[random.below(i + 1)]);
+
+    WeightedChoice anyAirport;
+    vector<WeightedChoice> clusterAirports(numClusters);
+    for (int airport = 0; airport < options.airports; airport++) {
+        double weight = pow(rank[airport] + 1.0, -options.hubExponent);
+        anyAirport.add(airport, weight);
+        clusterAirports[clusterOf[airport]].add(airport, weight);
+    }
+
+    vector<WeightedChoice> clusterAirlines(numClusters);
+    for (int airline = 0; airline < options.airlines; airline++) {
+        int cluster = airline % numClusters;
+        clusterAirlines[cluster].add(airline, 1.0 / (clusterAirlines[cluster].items.size() + 1));
+    }
+
+    string buffer;
+    ofstream airlinesFile(options.output + "/airlines.csv", ios::binary);
+    airlinesFile << "Code,Name,Callsign,Country\n";
+    for (int airline = 0; airline < options.airlines; airline++)
+        airlinesFile << codeOf(airline) << ",Airline " << airline << ",AIRLINE" << airline
+                     << ",Country " << airline % numClusters << "\n";
+
+    // Each cluster has about one city for every two airports, and the airports of a city are close together.
+    vector<vector<pair<double, double>>> cities(numClusters);
+    vector<double> latitudes(options.airports), longitudes(options.airports);
+    ofstream airportsFile(options.output + "/airports.csv", ios::binary);
+    airportsFile << "Code,Name,City,Country,Latitude,Longitude\n";
+    for (int airport = 0; airport < options.airports; airport++) {
+        int cluster = clusterOf[airport];
+        auto &clusterCities = cities[cluster];
+        if (clusterCities.empty()) {
+            for (int city = 0; city < max(1, clusterSize[cluster] / 2); city++)
+                clusterCities.emplace_back(centreLatitude[cluster] + options.spread * random.normal(),
+                                           centreLongitude[cluster] + options.spread * random.normal());
+        }
+
+        int city = random.below(clusterCities.size());
+        double latitude = clusterCities[city].first + 0.2 * random.normal();
+        double longitude = clusterCities[city].second + 0.2 * random.normal();
+        latitude = max(-85.0, min(85.0, latitude));
+        longitude = fmod(fmod(longitude + 180, 360) + 360, 360) - 180;
+        latitudes[airport] = latitude;
+        longitudes[airport] = longitude;
+
+        char coordinates[64];
+        snprintf(coordinates, sizeof(coordinates), "%.6f,%.6f", latitude, longitude);
+        buffer += codeOf(airport) + ",Airport " + to_string(airport) + ",City " + to_string(cluster) + "-" +
+                  to_string(city) + ",Country " + to_string(cluster) + "," + coordinates + "\n";
+        spill(airportsFile, buffer, false);
+    }
+    spill(airportsFile, buffer, true);
+
+    ofstream flightsFile(options.output + "/flights.csv", ios::binary);
+    flightsFile << "Source,Target,Airline\n";
+
+    // The departures draw from their own generator, so the other files do not change with --schedules.
+    Random departuresRandom{options.seed ^ 0x5DEECE66DULL};
+    string schedulesBuffer;
+    ofstream schedulesFile;
+    if (options.schedules > 0) {
+        schedulesFile.open(options.output + "/schedules.csv", ios::binary);
+        schedulesFile << "Source,Target,Airline,Departure,Arrival\n";
+    }
+
+    for (long long written = 0; written < options.flights; written += 2) {
+        int origin = anyAirport.pick(random), destination = origin;
+        for (int attempt = 0; destination == origin && attempt < 8; attempt++) {
+            const WeightedChoice &candidates = random.uniform() < options.locality && clusterSize[clusterOf[origin]] > 1
+                                               ? clusterAirports[clusterOf[origin]] : anyAirport;
+            destination = candidates.pick(random);
+        }
+        if (destination == origin) destination = (origin + 1) % options.airports;
+
+        const WeightedChoice &homeAirlines = clusterAirlines[clusterOf[origin]];
+        int airline = random.uniform() < options.concentration && !homeAirlines.empty()
+                      ? homeAirlines.pick(random) : random.below(options.airlines);
+
+        string originCode = codeOf(origin), destinationCode = codeOf(destination), airlineCode = codeOf(airline);
+        string outbound = originCode + ',' + destinationCode + ',' + airlineCode;
+        string inbound = destinationCode + ',' + originCode + ',' + airlineCode;
+        buffer += outbound + '\n';
+        if (written + 1 < options.flights)
+            buffer += inbound + '\n';
+        spill(flightsFile, buffer, false);
+
+        if (options.schedules > 0) {
+            // Half an hour on the ground plus the great-circle distance at 800 km/h, in steps of five minutes.
+            const double radians = M_PI / 180;
+            double a = pow(sin((latitudes[destination] - latitudes[origin]) * radians / 2), 2) +
+                       cos(latitudes[origin] * radians) * cos(latitudes[destination] * radians) *
+                       pow(sin((longitudes[destination] - longitudes[origin]) * radians / 2), 2);
+            double kilometres = 2 * 6371 * asin(sqrt(min(1.0, a)));
+            int minutes = 5 * (int) ceil((30 + kilometres / 800 * 60) / 5);
+
+            writeDepartures(schedulesBuffer, departuresRandom, outbound, minutes, options.schedules);
+            if (written + 1 < options.flights)
+                writeDepartures(schedulesBuffer, departuresRandom, inbound, minutes, options.schedules);
+            spill(schedulesFile, schedulesBuffer, false);
+        }
+    }
+    spill(flightsFile, buffer, true);
+    if (options.schedules > 0) spill(schedulesFile, schedulesBuffer, true);
+
+    if (!airlinesFile || !airportsFile || !flightsFile || (options.schedules > 0 && !schedulesFile)) {
+        cerr << "Could not write the files into " << options.output << endl;
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    Options options;
+    bool valid = true;
+
+    for (int i = 1; i + 1 < argc && valid; i += 2) {
+        string option = argv[i], value = argv[i + 1];
+        if (option == "--output") options.output = value;
+        else if (option == "--airports") options.airports = atoi(value.c_str());
+        else if (option == "--airlines") options.airlines = atoi(value.c_str());
+        else if (option == "--flights") options.flights = atoll(value.c_str());
+        else if (option == "--seed") options.seed = strtoull(value.c_str(), nullptr, 10);
+        else if (option == "--hub-exponent") options.hubExponent = atof(value.c_str());
+        else if (option == "--clusters") options.clusters = atoi(value.c_str());
+        else if (option == "--spread") options.spread = atof(value.c_str());
+        else if (option == "--locality") options.locality = atof(value.c_str());
+        else if (option == "--concentration") options.concentration = atof(value.c_str());
+        else if (option == "--schedules") options.schedules = atoi(value.c_str());
+        else valid = false;
+    }
+    valid = valid && argc % 2 == 1 && !options.output.empty() && options.airports >= 2 && options.airlines >= 1 &&
+            options.flights >= 0;
+
+    if (!valid) {
+        cerr << "Usage: " << argv[0] << " --output directory [--airports n] [--airlines n] [--flights n] [--seed n]"
+             << " [--hub-exponent x] [--clusters n] [--spread degrees] [--locality share] [--concentration share]"
+             << " [--schedules departures]" << endl;
+        return 1;
+    }
+
+    // The codes have three characters, so there cannot be more airports or airlines than codes.
+    if (options.airports > NUM_CODES || options.airlines > NUM_CODES) {
+        cerr << "At most " << NUM_CODES << " airports and airlines fit in three-character codes; using "
+             << NUM_CODES << "." << endl;
+        options.airports = min(options.airports, NUM_CODES);
+        options.airlines = min(options.airlines, NUM_CODES);
+    }
+
+    auto start = chrono::steady_clock::now();
+    int status = generate(options);
+    if (status == 0)
+        cerr << "Wrote " << options.airports << " airports, " << options.airlines << " airlines and "
+             << options.flights << " flights in "
+             << chrono::duration<double>(chrono::steady_clock::now() - start).count() << " s" << endl;
+    return status;
+}
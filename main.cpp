@@ -1,11 +1,65 @@
-
+#include <iostream>
+#include <string>
 #include "classes/application/Application.h"
+#include "classes/scheduler/Scheduler.h"
+#include "classes/instrumentation/Instrumentation.h"
 
 
-int main() {
+int main(int argc, char *argv[]) {
 
     Application app;
-    app.startApplication();
 
-    return 0;
+    std::string batch, serve, data, instrumentation;
+    ResultWriter::Format format = ResultWriter::TEXT;
+    Renumbering::Order order = Renumbering::INPUT;
+    int deadline = 5000, threads = 0, cache = -1;
+    bool valid = true;
+    for (int i = 1; i < argc && valid; i++) {
+        std::string option = argv[i];
+        valid = i + 1 < argc;
+        if (!valid) break;
+        if (option == "--batch") batch = argv[++i];
+        else if (option == "--serve") serve = argv[++i];
+        else if (option == "--data") data = argv[++i];
+        else if (option == "--instrumentation") instrumentation = argv[++i];
+        else if (option == "--format") valid = ResultWriter::parseFormat(argv[++i], format);
+        else if (option == "--order") valid = Renumbering::parseOrder(argv[++i], order);
+        else if (option == "--deadline" || option == "--threads" || option == "--cache") {
+            try {
+                int value = std::stoi(argv[++i]);
+                valid = option == "--cache" ? value >= 0 : value > 0;
+                (option == "--deadline" ? deadline : option == "--threads" ? threads : cache) = value;
+            } catch (const std::exception &) {
+                valid = false;
+            }
+        } else valid = false;
+    }
+
+    if (!valid || (!batch.empty() && !serve.empty())) {
+        std::cerr << "Usage: " << argv[0] << " [--data directory] [--threads n] [--format text|csv|jsonl]"
+                  << " [--cache megabytes] [--order input|bfs|rcm|hilbert] [--instrumentation report.txt]"
+                  << " [--batch queries.jsonl | --serve socket [--deadline ms]]" << std::endl;
+        return 1;
+    }
+
+    Scheduler::setThreads(threads);
+    app.setFormat(format);
+    app.setOrder(order);
+    if (!data.empty())
+        app.setDataDirectory(data);
+    if (cache != -1)
+        app.setCacheBudget(cache);
+
+    int status = 0;
+    if (!batch.empty())
+        status = app.startBatch(batch);
+    else if (!serve.empty())
+        status = app.startServer(serve, deadline);
+    else
+        app.startApplication();
+
+    if (!instrumentation.empty() && !Instrumentation::global().dump(instrumentation))
+        std::cerr << "Could not write " << instrumentation << std::endl;
+
+    return status;
 }
\ No newline at end of file